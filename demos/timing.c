@@ -1386,6 +1386,86 @@ static void time_encmacs(void)
    time_encmacs_(32);
 }
 
+#ifdef LTC_GCM_MODE
+static void _time_ghash(const char *name, gcm_state *gcm, const unsigned char *buf, unsigned long len, unsigned long mem)
+{
+   ulong64 t1, t2;
+   unsigned char T[16];
+   unsigned long x, y;
+   int err;
+
+   t2 = -1;
+   for (x = 0; x < 100; x++) {
+        t_start();
+        t1 = t_read();
+        if (name == NULL) {
+           /* call the multiply of the builds without tables directly */
+           for (y = 0; y < len; y += 16) {
+              XMEMCPY(T, buf + y, 16);
+              gcm_gf_mult(gcm->H, T, gcm->X);
+           }
+        } else {
+           if ((err = gcm_reset(gcm)) != CRYPT_OK ||
+               (err = gcm_add_iv(gcm, buf, 12)) != CRYPT_OK ||
+               (err = gcm_add_aad(gcm, buf, len)) != CRYPT_OK) {
+              fprintf(stderr, "\nGHASH error[%d]... %s\n", __LINE__, error_to_string(err));
+              exit(EXIT_FAILURE);
+           }
+        }
+        t1 = t_read() - t1;
+        if (t1 < t2) t2 = t1;
+   }
+   fprintf(stderr, "GHASH %-16s %6lu bytes of tables\t%9"PRI64"u\n", name ? name : "(bit serial)", mem, t2/(ulong64)(len/16));
+}
+#endif
+
+static void time_ghash(void)
+{
+#ifdef LTC_GCM_MODE
+   unsigned char *buf, key[16];
+   gcm_state *gcm;
+   int err;
+
+   fprintf(stderr, "\nGHASH Timings (%lu byte gcm_state, cycles per 16 byte block on 32KB of AAD):\n", (unsigned long)sizeof(gcm_state));
+
+   buf = XMALLOC(32*1024);
+   gcm = XMALLOC(sizeof(*gcm));
+   if (buf == NULL || gcm == NULL) {
+      fprintf(stderr, "\n\nout of heap yo\n\n");
+      exit(EXIT_FAILURE);
+   }
+   yarrow_read(buf, 32*1024, &yarrow_prng);
+   yarrow_read(key, 16, &yarrow_prng);
+
+   if ((err = gcm_init(gcm, find_cipher("aes"), key, 16)) != CRYPT_OK) {
+      fprintf(stderr, "gcm_init: %s\n", error_to_string(err));
+      exit(EXIT_FAILURE);
+   }
+#ifdef LTC_GCM_PCLMUL
+   if (gcm->pclmul) {
+      _time_ghash("(PCLMULQDQ)", gcm, buf, 32*1024, sizeof(gcm->HP));
+      /* time the fallback */
+      gcm->pclmul = 0;
+   }
+#endif
+#if defined(LTC_GCM_TABLES)
+#ifdef LTC_GCM_PCLMUL
+   /* the 64KiB tables are only built if PCLMULQDQ isn't available */
+   if (!gcm_pclmul_is_supported())
+#endif
+   _time_ghash("(64KiB tables)", gcm, buf, 32*1024, sizeof(gcm->PC));
+#elif defined(LTC_GCM_TABLES_4BIT)
+   _time_ghash("(4-bit tables)", gcm, buf, 32*1024, sizeof(gcm->HL) + sizeof(gcm->HH));
+#endif
+   _time_ghash(NULL, gcm, buf, 32*1024, 0);
+
+   XFREE(gcm);
+   XFREE(buf);
+#else
+   fprintf(stderr, "NO GCM\n");
+#endif
+}
+
 #define LTC_TEST_FN(f)  { f, #f }
 int main(int argc, char **argv)
 {
@@ -1404,6 +1484,7 @@ const struct
    LTC_TEST_FN(time_hash),
    LTC_TEST_FN(time_macs),
    LTC_TEST_FN(time_encmacs),
+   LTC_TEST_FN(time_ghash),
    LTC_TEST_FN(time_prng),
    LTC_TEST_FN(time_mult),
    LTC_TEST_FN(time_sqr),
@@ -41,13 +41,43 @@
 #define ECB_TEST rijndael_test
 #define ECB_KS   rijndael_keysize
 
+#ifdef LTC_AES_NI
+#define ACCEL_ECB_ENC aesni_accel_ecb_encrypt
+#define ACCEL_ECB_DEC aesni_accel_ecb_decrypt
+#define ACCEL_CBC_ENC aesni_accel_cbc_encrypt
+#define ACCEL_CBC_DEC aesni_accel_cbc_decrypt
+#ifdef LTC_CTR_MODE
+#define ACCEL_CTR_ENC aesni_accel_ctr_encrypt
+#endif
+#ifdef LTC_XTS_MODE
+#define ACCEL_XTS_ENC aesni_accel_xts_encrypt
+#define ACCEL_XTS_DEC aesni_accel_xts_decrypt
+#endif
+#endif
+
+#ifndef ACCEL_ECB_ENC
+#define ACCEL_ECB_ENC NULL
+#define ACCEL_ECB_DEC NULL
+#define ACCEL_CBC_ENC NULL
+#define ACCEL_CBC_DEC NULL
+#endif
+#ifndef ACCEL_CTR_ENC
+#define ACCEL_CTR_ENC NULL
+#endif
+#ifndef ACCEL_XTS_ENC
+#define ACCEL_XTS_ENC NULL
+#define ACCEL_XTS_DEC NULL
+#endif
+
 const struct ltc_cipher_descriptor rijndael_desc =
 {
     "rijndael",
     6,
     16, 32, 16, 10,
     SETUP, ECB_ENC, ECB_DEC, ECB_TEST, ECB_DONE, ECB_KS,
-    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+    ACCEL_ECB_ENC, ACCEL_ECB_DEC, ACCEL_CBC_ENC, ACCEL_CBC_DEC, ACCEL_CTR_ENC,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    ACCEL_XTS_ENC, ACCEL_XTS_DEC
 };
 
 const struct ltc_cipher_descriptor aes_desc =
@@ -56,7 +86,9 @@ const struct ltc_cipher_descriptor aes_desc =
     6,
     16, 32, 16, 10,
     SETUP, ECB_ENC, ECB_DEC, ECB_TEST, ECB_DONE, ECB_KS,
-    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+    ACCEL_ECB_ENC, ACCEL_ECB_DEC, ACCEL_CBC_ENC, ACCEL_CBC_DEC, ACCEL_CTR_ENC,
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    ACCEL_XTS_ENC, ACCEL_XTS_DEC
 };
 
 #else
@@ -293,6 +325,12 @@ int ECB_ENC(const unsigned char *pt, unsigned char *ct, symmetric_key *skey)
     LTC_ARGCHK(ct != NULL);
     LTC_ARGCHK(skey != NULL);
 
+#if defined(LTC_AES_NI) && !defined(ENCRYPT_ONLY)
+    if (aesni_is_supported()) {
+       return aesni_ecb_encrypt(pt, ct, skey);
+    }
+#endif
+
     Nr = skey->rijndael.Nr;
     rk = skey->rijndael.eK;
 
@@ -472,6 +510,12 @@ int ECB_DEC(const unsigned char *ct, unsigned char *pt, symmetric_key *skey)
     LTC_ARGCHK(ct != NULL);
     LTC_ARGCHK(skey != NULL);
 
+#ifdef LTC_AES_NI
+    if (aesni_is_supported()) {
+       return aesni_ecb_decrypt(ct, pt, skey);
+    }
+#endif
+
     Nr = skey->rijndael.Nr;
     rk = skey->rijndael.dK;
 
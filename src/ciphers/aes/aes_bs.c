@@ -0,0 +1,867 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file aes_bs.c
+  Constant-time bitsliced implementation of AES
+
+  The state of four blocks is spread over eight 64-bit words, word i holding bit i of
+  every byte, so the S-box can be computed as a boolean circuit without any table
+  lookups or secret dependent branches (the circuit is the one of Boyar and Peralta,
+  the data layout follows the "ct64" code of BearSSL by Thomas Pornin).
+
+  With LTC_X86_SIMD each word is a pair of 64-bit lanes in a SSE2 register, which
+  processes eight blocks at once.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_AES_BS
+
+const struct ltc_cipher_descriptor aes_bs_desc =
+{
+    "aes-bs",
+    24,
+    16, 32, 16, 10,
+    aes_bs_setup, aes_bs_ecb_encrypt, aes_bs_ecb_decrypt, aes_bs_test, aes_bs_done, aes_bs_keysize,
+    aes_bs_accel_ecb_encrypt, aes_bs_accel_ecb_decrypt, NULL, NULL,
+#ifdef LTC_CTR_MODE
+    aes_bs_accel_ctr_encrypt,
+#else
+    NULL,
+#endif
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+};
+
+#ifdef LTC_X86_SIMD
+/* the GCC vector extension is translated to SSE2 instructions, which every x86_64 CPU has */
+typedef ulong64 bs_word __attribute__((__vector_size__(16)));
+#define BS_LANES              2
+#define BS_GET(v, l)          ((v)[l])
+#define BS_SET(v, l, x)       (v)[l] = (x)
+#else
+typedef ulong64 bs_word;
+#define BS_LANES              1
+#define BS_GET(v, l)          (v)
+#define BS_SET(v, l, x)       (v) = (x)
+#endif
+
+/* number of blocks processed at once */
+#define BS_BLOCKS             (4 * BS_LANES)
+
+static void _bs_sbox(bs_word *q)
+{
+   bs_word x0, x1, x2, x3, x4, x5, x6, x7;
+   bs_word y1, y2, y3, y4, y5, y6, y7, y8, y9;
+   bs_word y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+   bs_word y20, y21;
+   bs_word z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+   bs_word z10, z11, z12, z13, z14, z15, z16, z17;
+   bs_word t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+   bs_word t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+   bs_word t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+   bs_word t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+   bs_word t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+   bs_word t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+   bs_word t60, t61, t62, t63, t64, t65, t66, t67;
+   bs_word s0, s1, s2, s3, s4, s5, s6, s7;
+
+   x0 = q[7];
+   x1 = q[6];
+   x2 = q[5];
+   x3 = q[4];
+   x4 = q[3];
+   x5 = q[2];
+   x6 = q[1];
+   x7 = q[0];
+
+   /* top linear transformation */
+   y14 = x3 ^ x5;
+   y13 = x0 ^ x6;
+   y9 = x0 ^ x3;
+   y8 = x0 ^ x5;
+   t0 = x1 ^ x2;
+   y1 = t0 ^ x7;
+   y4 = y1 ^ x3;
+   y12 = y13 ^ y14;
+   y2 = y1 ^ x0;
+   y5 = y1 ^ x6;
+   y3 = y5 ^ y8;
+   t1 = x4 ^ y12;
+   y15 = t1 ^ x5;
+   y20 = t1 ^ x1;
+   y6 = y15 ^ x7;
+   y10 = y15 ^ t0;
+   y11 = y20 ^ y9;
+   y7 = x7 ^ y11;
+   y17 = y10 ^ y11;
+   y19 = y10 ^ y8;
+   y16 = t0 ^ y11;
+   y21 = y13 ^ y16;
+   y18 = x0 ^ y16;
+
+   /* non-linear section */
+   t2 = y12 & y15;
+   t3 = y3 & y6;
+   t4 = t3 ^ t2;
+   t5 = y4 & x7;
+   t6 = t5 ^ t2;
+   t7 = y13 & y16;
+   t8 = y5 & y1;
+   t9 = t8 ^ t7;
+   t10 = y2 & y7;
+   t11 = t10 ^ t7;
+   t12 = y9 & y11;
+   t13 = y14 & y17;
+   t14 = t13 ^ t12;
+   t15 = y8 & y10;
+   t16 = t15 ^ t12;
+   t17 = t4 ^ t14;
+   t18 = t6 ^ t16;
+   t19 = t9 ^ t14;
+   t20 = t11 ^ t16;
+   t21 = t17 ^ y20;
+   t22 = t18 ^ y19;
+   t23 = t19 ^ y21;
+   t24 = t20 ^ y18;
+
+   t25 = t21 ^ t22;
+   t26 = t21 & t23;
+   t27 = t24 ^ t26;
+   t28 = t25 & t27;
+   t29 = t28 ^ t22;
+   t30 = t23 ^ t24;
+   t31 = t22 ^ t26;
+   t32 = t31 & t30;
+   t33 = t32 ^ t24;
+   t34 = t23 ^ t33;
+   t35 = t27 ^ t33;
+   t36 = t24 & t35;
+   t37 = t36 ^ t34;
+   t38 = t27 ^ t36;
+   t39 = t29 & t38;
+   t40 = t25 ^ t39;
+
+   t41 = t40 ^ t37;
+   t42 = t29 ^ t33;
+   t43 = t29 ^ t40;
+   t44 = t33 ^ t37;
+   t45 = t42 ^ t41;
+   z0 = t44 & y15;
+   z1 = t37 & y6;
+   z2 = t33 & x7;
+   z3 = t43 & y16;
+   z4 = t40 & y1;
+   z5 = t29 & y7;
+   z6 = t42 & y11;
+   z7 = t45 & y17;
+   z8 = t41 & y10;
+   z9 = t44 & y12;
+   z10 = t37 & y3;
+   z11 = t33 & y4;
+   z12 = t43 & y13;
+   z13 = t40 & y5;
+   z14 = t29 & y2;
+   z15 = t42 & y9;
+   z16 = t45 & y14;
+   z17 = t41 & y8;
+
+   /* bottom linear transformation */
+   t46 = z15 ^ z16;
+   t47 = z10 ^ z11;
+   t48 = z5 ^ z13;
+   t49 = z9 ^ z10;
+   t50 = z2 ^ z12;
+   t51 = z2 ^ z5;
+   t52 = z7 ^ z8;
+   t53 = z0 ^ z3;
+   t54 = z6 ^ z7;
+   t55 = z16 ^ z17;
+   t56 = z12 ^ t48;
+   t57 = t50 ^ t53;
+   t58 = z4 ^ t46;
+   t59 = z3 ^ t54;
+   t60 = t46 ^ t57;
+   t61 = z14 ^ t57;
+   t62 = t52 ^ t58;
+   t63 = t49 ^ t58;
+   t64 = z4 ^ t59;
+   t65 = t61 ^ t62;
+   t66 = z1 ^ t63;
+   s0 = t59 ^ t63;
+   s6 = t56 ^ ~t62;
+   s7 = t48 ^ ~t60;
+   t67 = t64 ^ t65;
+   s3 = t53 ^ t66;
+   s4 = t51 ^ t66;
+   s5 = t47 ^ t65;
+   s1 = t64 ^ ~s3;
+   s2 = t55 ^ ~t67;
+
+   q[7] = s0;
+   q[6] = s1;
+   q[5] = s2;
+   q[4] = s3;
+   q[3] = s4;
+   q[2] = s5;
+   q[1] = s6;
+   q[0] = s7;
+}
+
+/* the inverse affine transformation of the S-box */
+static void _bs_inv_affine(bs_word *q)
+{
+   bs_word q0, q1, q2, q3, q4, q5, q6, q7;
+
+   q0 = ~q[0];
+   q1 = ~q[1];
+   q2 = q[2];
+   q3 = q[3];
+   q4 = q[4];
+   q5 = ~q[5];
+   q6 = ~q[6];
+   q7 = q[7];
+   q[7] = q1 ^ q4 ^ q6;
+   q[6] = q0 ^ q3 ^ q5;
+   q[5] = q7 ^ q2 ^ q4;
+   q[4] = q6 ^ q1 ^ q3;
+   q[3] = q5 ^ q0 ^ q2;
+   q[2] = q4 ^ q7 ^ q1;
+   q[1] = q3 ^ q6 ^ q0;
+   q[0] = q2 ^ q5 ^ q7;
+}
+
+/* InvSubBytes is the inversion in GF(2^8), computed with the S-box between two inverse affine transformations */
+static void _bs_inv_sbox(bs_word *q)
+{
+   _bs_inv_affine(q);
+   _bs_sbox(q);
+   _bs_inv_affine(q);
+}
+
+#define BS_SWAPN(cl, ch, s, x, y) do {                            \
+      bs_word _a = (x), _b = (y);                                 \
+      (x) = (_a & CONST64(cl)) | ((_b & CONST64(cl)) << (s));     \
+      (y) = ((_a & CONST64(ch)) >> (s)) | (_b & CONST64(ch));     \
+   } while (0)
+
+#define BS_SWAP2(x, y) BS_SWAPN(0x5555555555555555, 0xAAAAAAAAAAAAAAAA, 1, x, y)
+#define BS_SWAP4(x, y) BS_SWAPN(0x3333333333333333, 0xCCCCCCCCCCCCCCCC, 2, x, y)
+#define BS_SWAP8(x, y) BS_SWAPN(0x0F0F0F0F0F0F0F0F, 0xF0F0F0F0F0F0F0F0, 4, x, y)
+
+/* transposes the bits between the byte-wise and the bitsliced representation, it's an involution */
+static void _bs_ortho(bs_word *q)
+{
+   BS_SWAP2(q[0], q[1]);
+   BS_SWAP2(q[2], q[3]);
+   BS_SWAP2(q[4], q[5]);
+   BS_SWAP2(q[6], q[7]);
+
+   BS_SWAP4(q[0], q[2]);
+   BS_SWAP4(q[1], q[3]);
+   BS_SWAP4(q[4], q[6]);
+   BS_SWAP4(q[5], q[7]);
+
+   BS_SWAP8(q[0], q[4]);
+   BS_SWAP8(q[1], q[5]);
+   BS_SWAP8(q[2], q[6]);
+   BS_SWAP8(q[3], q[7]);
+}
+
+static void _bs_interleave_in(ulong64 *q0, ulong64 *q1, const ulong32 *w)
+{
+   ulong64 x0, x1, x2, x3;
+
+   x0 = w[0];
+   x1 = w[1];
+   x2 = w[2];
+   x3 = w[3];
+   x0 |= (x0 << 16);
+   x1 |= (x1 << 16);
+   x2 |= (x2 << 16);
+   x3 |= (x3 << 16);
+   x0 &= CONST64(0x0000FFFF0000FFFF);
+   x1 &= CONST64(0x0000FFFF0000FFFF);
+   x2 &= CONST64(0x0000FFFF0000FFFF);
+   x3 &= CONST64(0x0000FFFF0000FFFF);
+   x0 |= (x0 << 8);
+   x1 |= (x1 << 8);
+   x2 |= (x2 << 8);
+   x3 |= (x3 << 8);
+   x0 &= CONST64(0x00FF00FF00FF00FF);
+   x1 &= CONST64(0x00FF00FF00FF00FF);
+   x2 &= CONST64(0x00FF00FF00FF00FF);
+   x3 &= CONST64(0x00FF00FF00FF00FF);
+   *q0 = x0 | (x2 << 8);
+   *q1 = x1 | (x3 << 8);
+}
+
+static void _bs_interleave_out(ulong32 *w, ulong64 q0, ulong64 q1)
+{
+   ulong64 x0, x1, x2, x3;
+
+   x0 = q0 & CONST64(0x00FF00FF00FF00FF);
+   x1 = q1 & CONST64(0x00FF00FF00FF00FF);
+   x2 = (q0 >> 8) & CONST64(0x00FF00FF00FF00FF);
+   x3 = (q1 >> 8) & CONST64(0x00FF00FF00FF00FF);
+   x0 |= (x0 >> 8);
+   x1 |= (x1 >> 8);
+   x2 |= (x2 >> 8);
+   x3 |= (x3 >> 8);
+   x0 &= CONST64(0x0000FFFF0000FFFF);
+   x1 &= CONST64(0x0000FFFF0000FFFF);
+   x2 &= CONST64(0x0000FFFF0000FFFF);
+   x3 &= CONST64(0x0000FFFF0000FFFF);
+   w[0] = (ulong32)(x0 | (x0 >> 16));
+   w[1] = (ulong32)(x1 | (x1 >> 16));
+   w[2] = (ulong32)(x2 | (x2 >> 16));
+   w[3] = (ulong32)(x3 | (x3 >> 16));
+}
+
+/* load up to BS_BLOCKS blocks into the bitsliced state, missing blocks are zero */
+static void _bs_load(bs_word *q, const unsigned char *in, unsigned long blocks)
+{
+   ulong32 w[16];
+   ulong64 a, b;
+   unsigned long n;
+   int l, i;
+
+   for (l = 0; l < BS_LANES; l++) {
+      XMEMSET(w, 0, sizeof(w));
+      for (n = 0; n < 4 && 4 * l + n < blocks; n++) {
+         for (i = 0; i < 4; i++) {
+            LOAD32L(w[4 * n + i], in + 16 * (4 * l + n) + 4 * i);
+         }
+      }
+      for (i = 0; i < 4; i++) {
+         _bs_interleave_in(&a, &b, w + 4 * i);
+         BS_SET(q[i], l, a);
+         BS_SET(q[i + 4], l, b);
+      }
+   }
+   _bs_ortho(q);
+}
+
+static void _bs_store(bs_word *q, unsigned char *out, unsigned long blocks)
+{
+   ulong32 w[16];
+   unsigned long n;
+   int l, i;
+
+   _bs_ortho(q);
+   for (l = 0; l < BS_LANES; l++) {
+      for (i = 0; i < 4; i++) {
+         _bs_interleave_out(w + 4 * i, BS_GET(q[i], l), BS_GET(q[i + 4], l));
+      }
+      for (n = 0; n < 4 && 4 * l + n < blocks; n++) {
+         for (i = 0; i < 4; i++) {
+            STORE32L(w[4 * n + i], out + 16 * (4 * l + n) + 4 * i);
+         }
+      }
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(w, sizeof(w));
+#endif
+}
+
+/* every block of the state gets the same key, so the words of the schedule are copied to all lanes */
+static LTC_INLINE void _bs_add_round_key(bs_word *q, const ulong64 *sk)
+{
+   bs_word k;
+   int i, l;
+
+   for (i = 0; i < 8; i++) {
+      for (l = 0; l < BS_LANES; l++) {
+         BS_SET(k, l, sk[i]);
+      }
+      q[i] ^= k;
+   }
+}
+
+static void _bs_shift_rows(bs_word *q)
+{
+   bs_word x;
+   int i;
+
+   for (i = 0; i < 8; i++) {
+      x = q[i];
+      q[i] = (x & CONST64(0x000000000000FFFF))
+           | ((x & CONST64(0x00000000FFF00000)) >> 4)
+           | ((x & CONST64(0x00000000000F0000)) << 12)
+           | ((x & CONST64(0x0000FF0000000000)) >> 8)
+           | ((x & CONST64(0x000000FF00000000)) << 8)
+           | ((x & CONST64(0xF000000000000000)) >> 12)
+           | ((x & CONST64(0x0FFF000000000000)) << 4);
+   }
+}
+
+static void _bs_inv_shift_rows(bs_word *q)
+{
+   bs_word x;
+   int i;
+
+   for (i = 0; i < 8; i++) {
+      x = q[i];
+      q[i] = (x & CONST64(0x000000000000FFFF))
+           | ((x & CONST64(0x000000000FFF0000)) << 4)
+           | ((x & CONST64(0x00000000F0000000)) >> 12)
+           | ((x & CONST64(0x000000FF00000000)) << 8)
+           | ((x & CONST64(0x0000FF0000000000)) >> 8)
+           | ((x & CONST64(0x000F000000000000)) << 12)
+           | ((x & CONST64(0xFFF0000000000000)) >> 4);
+   }
+}
+
+#define BS_ROTR16(x) (((x) >> 16) | ((x) << 48))
+#define BS_ROTR32(x) (((x) >> 32) | ((x) << 32))
+
+static void _bs_mix_columns(bs_word *q)
+{
+   bs_word q0, q1, q2, q3, q4, q5, q6, q7;
+   bs_word r0, r1, r2, r3, r4, r5, r6, r7;
+
+   q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+   q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+   r0 = BS_ROTR16(q0); r1 = BS_ROTR16(q1); r2 = BS_ROTR16(q2); r3 = BS_ROTR16(q3);
+   r4 = BS_ROTR16(q4); r5 = BS_ROTR16(q5); r6 = BS_ROTR16(q6); r7 = BS_ROTR16(q7);
+
+   q[0] = q7 ^ r7 ^ r0 ^ BS_ROTR32(q0 ^ r0);
+   q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ BS_ROTR32(q1 ^ r1);
+   q[2] = q1 ^ r1 ^ r2 ^ BS_ROTR32(q2 ^ r2);
+   q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ BS_ROTR32(q3 ^ r3);
+   q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ BS_ROTR32(q4 ^ r4);
+   q[5] = q4 ^ r4 ^ r5 ^ BS_ROTR32(q5 ^ r5);
+   q[6] = q5 ^ r5 ^ r6 ^ BS_ROTR32(q6 ^ r6);
+   q[7] = q6 ^ r6 ^ r7 ^ BS_ROTR32(q7 ^ r7);
+}
+
+static void _bs_inv_mix_columns(bs_word *q)
+{
+   bs_word q0, q1, q2, q3, q4, q5, q6, q7;
+   bs_word r0, r1, r2, r3, r4, r5, r6, r7;
+
+   q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+   q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+   r0 = BS_ROTR16(q0); r1 = BS_ROTR16(q1); r2 = BS_ROTR16(q2); r3 = BS_ROTR16(q3);
+   r4 = BS_ROTR16(q4); r5 = BS_ROTR16(q5); r6 = BS_ROTR16(q6); r7 = BS_ROTR16(q7);
+
+   q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ BS_ROTR32(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+   q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^ BS_ROTR32(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+   q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^ BS_ROTR32(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+   q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5 ^ BS_ROTR32(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+   q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7 ^ BS_ROTR32(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+   q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7 ^ BS_ROTR32(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+   q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7 ^ BS_ROTR32(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+   q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^ BS_ROTR32(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+/* expand a compressed round key word, bit k of each nibble becomes the nibble of word k */
+static void _bs_expand_key(ulong64 *sk, ulong64 c)
+{
+   ulong64 x;
+   int k;
+
+   for (k = 0; k < 4; k++) {
+      x = (c >> k) & CONST64(0x1111111111111111);
+      sk[k] = (x << 4) - x;
+   }
+}
+
+static void _bs_encrypt(bs_word *q, const ulong64 *sk, int Nr)
+{
+   int r;
+
+   _bs_add_round_key(q, sk);
+   for (r = 1; r < Nr; r++) {
+      _bs_sbox(q);
+      _bs_shift_rows(q);
+      _bs_mix_columns(q);
+      _bs_add_round_key(q, sk + 8 * r);
+   }
+   _bs_sbox(q);
+   _bs_shift_rows(q);
+   _bs_add_round_key(q, sk + 8 * Nr);
+}
+
+static void _bs_decrypt(bs_word *q, const ulong64 *sk, int Nr)
+{
+   int r;
+
+   _bs_add_round_key(q, sk + 8 * Nr);
+   for (r = Nr - 1; r > 0; r--) {
+      _bs_inv_shift_rows(q);
+      _bs_inv_sbox(q);
+      _bs_add_round_key(q, sk + 8 * r);
+      _bs_inv_mix_columns(q);
+   }
+   _bs_inv_shift_rows(q);
+   _bs_inv_sbox(q);
+   _bs_add_round_key(q, sk);
+}
+
+static ulong32 _bs_sub_word(ulong32 x)
+{
+   bs_word q[8];
+
+   XMEMSET(q, 0, sizeof(q));
+   BS_SET(q[0], 0, x);
+   _bs_ortho(q);
+   _bs_sbox(q);
+   _bs_ortho(q);
+   x = (ulong32)BS_GET(q[0], 0);
+#ifdef LTC_CLEAN_STACK
+   zeromem(q, sizeof(q));
+#endif
+   return x;
+}
+
+ /**
+    Initialize the bitsliced AES block cipher
+    @param key The symmetric key you wish to pass
+    @param keylen The key length in bytes
+    @param num_rounds The number of rounds desired (0 for default)
+    @param skey The key in as scheduled by this function.
+    @return CRYPT_OK if successful
+ */
+int aes_bs_setup(const unsigned char *key, int keylen, int num_rounds, symmetric_key *skey)
+{
+   static const unsigned char rcon[10] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36 };
+   ulong32 tk[60], tmp;
+   ulong64 a, b, c;
+   bs_word q[8];
+   int i, j, k, nk, nkf, l;
+
+   LTC_ARGCHK(key  != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   if (keylen != 16 && keylen != 24 && keylen != 32) {
+      return CRYPT_INVALID_KEYSIZE;
+   }
+
+   if (num_rounds != 0 && num_rounds != (10 + ((keylen/8)-2)*2)) {
+      return CRYPT_INVALID_ROUNDS;
+   }
+
+   skey->aes_bs.Nr = 10 + ((keylen/8)-2)*2;
+   nk  = keylen >> 2;
+   nkf = (skey->aes_bs.Nr + 1) << 2;
+
+   for (i = 0; i < nk; i++) {
+      LOAD32L(tk[i], key + 4 * i);
+   }
+   for (i = nk, j = 0, k = 0; i < nkf; i++) {
+      tmp = tk[i - 1];
+      if (j == 0) {
+         tmp = RORc(tmp, 8);
+         tmp = _bs_sub_word(tmp) ^ rcon[k];
+      } else if (nk > 6 && j == 4) {
+         tmp = _bs_sub_word(tmp);
+      }
+      tk[i] = tk[i - nk] ^ tmp;
+      if (++j == nk) {
+         j = 0;
+         k++;
+      }
+   }
+
+   /* bitslice the round keys, the four blocks of the state get the same key so every nibble is either 0 or F
+    * and one bit of each nibble is enough to compute it, the schedule keeps the expanded words so encrypting
+    * and decrypting don't have to expand it again */
+   for (i = 0, j = 0; i < nkf; i += 4, j += 8) {
+      _bs_interleave_in(&a, &b, tk + i);
+      for (l = 0; l < 4; l++) {
+         BS_SET(q[l], 0, a);
+         BS_SET(q[l + 4], 0, b);
+      }
+      _bs_ortho(q);
+      c = (BS_GET(q[0], 0) & CONST64(0x1111111111111111))
+        | (BS_GET(q[1], 0) & CONST64(0x2222222222222222))
+        | (BS_GET(q[2], 0) & CONST64(0x4444444444444444))
+        | (BS_GET(q[3], 0) & CONST64(0x8888888888888888));
+      _bs_expand_key(skey->aes_bs.sk + j, c);
+      c = (BS_GET(q[4], 0) & CONST64(0x1111111111111111))
+        | (BS_GET(q[5], 0) & CONST64(0x2222222222222222))
+        | (BS_GET(q[6], 0) & CONST64(0x4444444444444444))
+        | (BS_GET(q[7], 0) & CONST64(0x8888888888888888));
+      _bs_expand_key(skey->aes_bs.sk + j + 4, c);
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(tk, sizeof(tk));
+   zeromem(q, sizeof(q));
+#endif
+   return CRYPT_OK;
+}
+
+static void _bs_ecb(const unsigned char *in, unsigned char *out, unsigned long blocks, const struct aes_bs_key *key, int enc)
+{
+   bs_word q[8];
+   unsigned long n;
+
+   while (blocks > 0) {
+      n = blocks < BS_BLOCKS ? blocks : BS_BLOCKS;
+      _bs_load(q, in, n);
+      if (enc) {
+         _bs_encrypt(q, key->sk, key->Nr);
+      } else {
+         _bs_decrypt(q, key->sk, key->Nr);
+      }
+      _bs_store(q, out, n);
+      in     += 16 * n;
+      out    += 16 * n;
+      blocks -= n;
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(q, sizeof(q));
+#endif
+}
+
+/**
+  Encrypts a block of text with the bitsliced AES
+  @param pt The input plaintext (16 bytes)
+  @param ct The output ciphertext (16 bytes)
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+int aes_bs_ecb_encrypt(const unsigned char *pt, unsigned char *ct, symmetric_key *skey)
+{
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   _bs_ecb(pt, ct, 1, &skey->aes_bs, 1);
+   return CRYPT_OK;
+}
+
+/**
+  Decrypts a block of text with the bitsliced AES
+  @param ct The input ciphertext (16 bytes)
+  @param pt The output plaintext (16 bytes)
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+int aes_bs_ecb_decrypt(const unsigned char *ct, unsigned char *pt, symmetric_key *skey)
+{
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   _bs_ecb(ct, pt, 1, &skey->aes_bs, 0);
+   return CRYPT_OK;
+}
+
+/**
+  Accelerated ECB encryption, BS_BLOCKS blocks are encrypted at once
+  @param pt      Plaintext
+  @param ct      [out] Ciphertext
+  @param blocks  The number of complete blocks to process
+  @param skey    The scheduled key context
+  @return CRYPT_OK if successful
+*/
+int aes_bs_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey)
+{
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   _bs_ecb(pt, ct, blocks, &skey->aes_bs, 1);
+   return CRYPT_OK;
+}
+
+/**
+  Accelerated ECB decryption, BS_BLOCKS blocks are decrypted at once
+  @param ct      Ciphertext
+  @param pt      [out] Plaintext
+  @param blocks  The number of complete blocks to process
+  @param skey    The scheduled key context
+  @return CRYPT_OK if successful
+*/
+int aes_bs_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey)
+{
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   _bs_ecb(ct, pt, blocks, &skey->aes_bs, 0);
+   return CRYPT_OK;
+}
+
+#ifdef LTC_CTR_MODE
+/**
+  Accelerated CTR encryption, the counter spans the whole block
+  @param pt      Plaintext
+  @param ct      [out] Ciphertext
+  @param blocks  The number of complete blocks to process
+  @param IV      The counter, it is incremented before each block (input/output)
+  @param mode    CTR_COUNTER_LITTLE_ENDIAN or CTR_COUNTER_BIG_ENDIAN
+  @param skey    The scheduled key context
+  @return CRYPT_OK if successful
+*/
+int aes_bs_accel_ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *IV, int mode, symmetric_key *skey)
+{
+   bs_word q[8];
+   unsigned char buf[16 * BS_BLOCKS];
+   unsigned long n, i;
+   int x;
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(IV != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   while (blocks > 0) {
+      n = blocks < BS_BLOCKS ? blocks : BS_BLOCKS;
+      for (i = 0; i < n; i++) {
+         if (mode == CTR_COUNTER_LITTLE_ENDIAN) {
+            for (x = 0; x < 16 && ++IV[x] == 0; x++);
+         } else {
+            for (x = 15; x >= 0 && ++IV[x] == 0; x--);
+         }
+         XMEMCPY(buf + 16 * i, IV, 16);
+      }
+      _bs_load(q, buf, n);
+      _bs_encrypt(q, skey->aes_bs.sk, skey->aes_bs.Nr);
+      _bs_store(q, buf, n);
+#ifdef LTC_FAST
+      for (i = 0; i < 16 * n; i += sizeof(LTC_FAST_TYPE)) {
+         *(LTC_FAST_TYPE_PTR_CAST(ct + i)) = *(LTC_FAST_TYPE_PTR_CAST(pt + i)) ^ *(LTC_FAST_TYPE_PTR_CAST(buf + i));
+      }
+#else
+      for (i = 0; i < 16 * n; i++) {
+         ct[i] = pt[i] ^ buf[i];
+      }
+#endif
+      pt     += 16 * n;
+      ct     += 16 * n;
+      blocks -= n;
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(q, sizeof(q));
+   zeromem(buf, sizeof(buf));
+#endif
+   return CRYPT_OK;
+}
+#endif /* LTC_CTR_MODE */
+
+/**
+  Performs a self-test of the bitsliced AES
+  @return CRYPT_OK if functional, CRYPT_NOP if self-test has been disabled
+*/
+int aes_bs_test(void)
+{
+#ifndef LTC_TEST
+   return CRYPT_NOP;
+#else
+   static const struct {
+      int keylen;
+      unsigned char key[32], pt[16], ct[16];
+   } tests[] = {
+    { 16,
+      { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f },
+      { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff },
+      { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+        0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a }
+    }, {
+      24,
+      { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 },
+      { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff },
+      { 0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+        0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91 }
+    }, {
+      32,
+      { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f },
+      { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff },
+      { 0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 }
+    }
+   };
+   symmetric_key key;
+   unsigned char tmp[2][16], buf[3][16 * (BS_BLOCKS + 1)];
+   int i, y, err;
+
+   for (i = 0; i < (int)(sizeof(tests)/sizeof(tests[0])); i++) {
+      zeromem(&key, sizeof(key));
+      if ((err = aes_bs_setup(tests[i].key, tests[i].keylen, 0, &key)) != CRYPT_OK) {
+         return err;
+      }
+
+      aes_bs_ecb_encrypt(tests[i].pt, tmp[0], &key);
+      aes_bs_ecb_decrypt(tmp[0], tmp[1], &key);
+      if (compare_testvector(tmp[0], 16, tests[i].ct, 16, "AES-BS Encrypt", i) ||
+            compare_testvector(tmp[1], 16, tests[i].pt, 16, "AES-BS Decrypt", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+
+      /* every block position of the bitsliced state must give the same result */
+      for (y = 0; y < BS_BLOCKS + 1; y++) {
+         XMEMCPY(buf[0] + 16 * y, tests[i].pt, 16);
+      }
+      aes_bs_accel_ecb_encrypt(buf[0], buf[1], BS_BLOCKS + 1, &key);
+      aes_bs_accel_ecb_decrypt(buf[1], buf[2], BS_BLOCKS + 1, &key);
+      for (y = 0; y < BS_BLOCKS + 1; y++) {
+         if (compare_testvector(buf[1] + 16 * y, 16, tests[i].ct, 16, "AES-BS accel Encrypt", i * 16 + y) ||
+               compare_testvector(buf[2] + 16 * y, 16, tests[i].pt, 16, "AES-BS accel Decrypt", i * 16 + y)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+
+      /* now see if we can encrypt all zero bytes 1000 times, decrypt and come back where we started */
+      for (y = 0; y < 16; y++) tmp[0][y] = 0;
+      for (y = 0; y < 1000; y++) aes_bs_ecb_encrypt(tmp[0], tmp[0], &key);
+      for (y = 0; y < 1000; y++) aes_bs_ecb_decrypt(tmp[0], tmp[0], &key);
+      for (y = 0; y < 16; y++) if (tmp[0][y] != 0) return CRYPT_FAIL_TESTVECTOR;
+   }
+   return CRYPT_OK;
+#endif
+}
+
+/** Terminate the context
+   @param skey    The scheduled key
+*/
+void aes_bs_done(symmetric_key *skey)
+{
+   LTC_UNUSED_PARAM(skey);
+}
+
+/**
+  Gets suitable key size
+  @param keysize [in/out] The length of the recommended key (in bytes).  This function will store the suitable size back in this variable.
+  @return CRYPT_OK if the input key size is acceptable.
+*/
+int aes_bs_keysize(int *keysize)
+{
+   LTC_ARGCHK(keysize != NULL);
+
+   if (*keysize < 16) {
+      return CRYPT_INVALID_KEYSIZE;
+   }
+   if (*keysize < 24) {
+      *keysize = 16;
+   } else if (*keysize < 32) {
+      *keysize = 24;
+   } else {
+      *keysize = 32;
+   }
+   return CRYPT_OK;
+}
+
+#endif /* LTC_AES_BS */
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -0,0 +1,643 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file aesni.c
+  AES-NI backend of the AES (Rijndael) block cipher
+
+  The key schedule is shared with the table based implementation in aes.c, the round keys
+  are only byte swapped when loaded into the XMM registers.  The bulk functions keep eight
+  blocks in flight to hide the latency of the AESENC/AESDEC instructions.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_AES_NI
+
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+
+#define AESNI_TARGET LTC_TARGET("aes,ssse3")
+#define AESNI_PAR    8
+
+/**
+  Check whether the CPU supports AES-NI
+  @return 1 if the AES-NI functions can be used, 0 otherwise
+*/
+int aesni_is_supported(void)
+{
+   const unsigned long need = LTC_CPU_AESNI | LTC_CPU_SSSE3;
+   return (crypt_cpu_features() & need) == need;
+}
+
+/* the round keys are stored as big endian words for the tables, swap each word back into byte order */
+AESNI_TARGET
+static LTC_INLINE void _aesni_load_keys(__m128i *K, const ulong32 *rk, int Nr)
+{
+   const __m128i bswap = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+   int i;
+
+   K[0] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)rk), bswap);
+   for (i = 1; i <= Nr; i++) {
+      K[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(rk + 4*i)), bswap);
+   }
+}
+
+AESNI_TARGET
+static LTC_INLINE __m128i _aesni_enc1(__m128i b, const __m128i *K, int Nr)
+{
+   int r;
+
+   b = _mm_xor_si128(b, K[0]);
+   for (r = 1; r < Nr; r++) {
+      b = _mm_aesenc_si128(b, K[r]);
+   }
+   return _mm_aesenclast_si128(b, K[Nr]);
+}
+
+AESNI_TARGET
+static LTC_INLINE __m128i _aesni_dec1(__m128i b, const __m128i *K, int Nr)
+{
+   int r;
+
+   b = _mm_xor_si128(b, K[0]);
+   for (r = 1; r < Nr; r++) {
+      b = _mm_aesdec_si128(b, K[r]);
+   }
+   return _mm_aesdeclast_si128(b, K[Nr]);
+}
+
+AESNI_TARGET
+static LTC_INLINE void _aesni_enc8(__m128i *b, const __m128i *K, int Nr)
+{
+   int r, i;
+
+   for (i = 0; i < AESNI_PAR; i++) {
+      b[i] = _mm_xor_si128(b[i], K[0]);
+   }
+   for (r = 1; r < Nr; r++) {
+      for (i = 0; i < AESNI_PAR; i++) {
+         b[i] = _mm_aesenc_si128(b[i], K[r]);
+      }
+   }
+   for (i = 0; i < AESNI_PAR; i++) {
+      b[i] = _mm_aesenclast_si128(b[i], K[Nr]);
+   }
+}
+
+AESNI_TARGET
+static LTC_INLINE void _aesni_dec8(__m128i *b, const __m128i *K, int Nr)
+{
+   int r, i;
+
+   for (i = 0; i < AESNI_PAR; i++) {
+      b[i] = _mm_xor_si128(b[i], K[0]);
+   }
+   for (r = 1; r < Nr; r++) {
+      for (i = 0; i < AESNI_PAR; i++) {
+         b[i] = _mm_aesdec_si128(b[i], K[r]);
+      }
+   }
+   for (i = 0; i < AESNI_PAR; i++) {
+      b[i] = _mm_aesdeclast_si128(b[i], K[Nr]);
+   }
+}
+
+#define LOADU(p)     _mm_loadu_si128((const __m128i*)(const void*)(p))
+#define STOREU(p, v) _mm_storeu_si128((__m128i*)(void*)(p), (v))
+
+/**
+  Encrypt a block with AES-NI, only call this if aesni_is_supported() returned 1
+  @param pt The input plaintext (16 bytes)
+  @param ct The output ciphertext (16 bytes)
+  @param skey The key as scheduled by rijndael_setup()
+  @return CRYPT_OK if successful
+*/
+AESNI_TARGET
+int aesni_ecb_encrypt(const unsigned char *pt, unsigned char *ct, symmetric_key *skey)
+{
+   __m128i K[15];
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   _aesni_load_keys(K, skey->rijndael.eK, skey->rijndael.Nr);
+   STOREU(ct, _aesni_enc1(LOADU(pt), K, skey->rijndael.Nr));
+#ifdef LTC_CLEAN_STACK
+   zeromem(K, sizeof(K));
+#endif
+   return CRYPT_OK;
+}
+
+/**
+  Decrypt a block with AES-NI, only call this if aesni_is_supported() returned 1
+  @param ct The input ciphertext (16 bytes)
+  @param pt The output plaintext (16 bytes)
+  @param skey The key as scheduled by rijndael_setup()
+  @return CRYPT_OK if successful
+*/
+AESNI_TARGET
+int aesni_ecb_decrypt(const unsigned char *ct, unsigned char *pt, symmetric_key *skey)
+{
+   __m128i K[15];
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   _aesni_load_keys(K, skey->rijndael.dK, skey->rijndael.Nr);
+   STOREU(pt, _aesni_dec1(LOADU(ct), K, skey->rijndael.Nr));
+#ifdef LTC_CLEAN_STACK
+   zeromem(K, sizeof(K));
+#endif
+   return CRYPT_OK;
+}
+
+AESNI_TARGET
+static void _aesni_ecb(const unsigned char *in, unsigned char *out, unsigned long blocks, const ulong32 *rk, int Nr, int enc)
+{
+   __m128i K[15], b[AESNI_PAR];
+   int i;
+
+   _aesni_load_keys(K, rk, Nr);
+   for (; blocks >= AESNI_PAR; blocks -= AESNI_PAR) {
+      for (i = 0; i < AESNI_PAR; i++) {
+         b[i] = LOADU(in + 16*i);
+      }
+      if (enc) {
+         _aesni_enc8(b, K, Nr);
+      } else {
+         _aesni_dec8(b, K, Nr);
+      }
+      for (i = 0; i < AESNI_PAR; i++) {
+         STOREU(out + 16*i, b[i]);
+      }
+      in  += 16 * AESNI_PAR;
+      out += 16 * AESNI_PAR;
+   }
+   for (; blocks > 0; blocks--) {
+      b[0] = LOADU(in);
+      b[0] = enc ? _aesni_enc1(b[0], K, Nr) : _aesni_dec1(b[0], K, Nr);
+      STOREU(out, b[0]);
+      in  += 16;
+      out += 16;
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(K, sizeof(K));
+   zeromem(b, sizeof(b));
+#endif
+}
+
+/**
+  Accelerated ECB encryption
+  @param pt      Plaintext
+  @param ct      [out] Ciphertext
+  @param blocks  The number of complete blocks to process
+  @param skey    The scheduled key context
+  @return CRYPT_OK if successful
+*/
+int aesni_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey)
+{
+   int err;
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   if (aesni_is_supported()) {
+      _aesni_ecb(pt, ct, blocks, skey->rijndael.eK, skey->rijndael.Nr, 1);
+      return CRYPT_OK;
+   }
+   for (; blocks > 0; blocks--) {
+      if ((err = rijndael_ecb_encrypt(pt, ct, skey)) != CRYPT_OK) {
+         return err;
+      }
+      pt += 16;
+      ct += 16;
+   }
+   return CRYPT_OK;
+}
+
+/**
+  Accelerated ECB decryption
+  @param ct      Ciphertext
+  @param pt      [out] Plaintext
+  @param blocks  The number of complete blocks to process
+  @param skey    The scheduled key context
+  @return CRYPT_OK if successful
+*/
+int aesni_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey)
+{
+   int err;
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   if (aesni_is_supported()) {
+      _aesni_ecb(ct, pt, blocks, skey->rijndael.dK, skey->rijndael.Nr, 0);
+      return CRYPT_OK;
+   }
+   for (; blocks > 0; blocks--) {
+      if ((err = rijndael_ecb_decrypt(ct, pt, skey)) != CRYPT_OK) {
+         return err;
+      }
+      ct += 16;
+      pt += 16;
+   }
+   return CRYPT_OK;
+}
+
+AESNI_TARGET
+static void _aesni_cbc_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *IV, symmetric_key *skey)
+{
+   __m128i K[15], iv;
+   int Nr = skey->rijndael.Nr;
+
+   _aesni_load_keys(K, skey->rijndael.eK, Nr);
+   iv = LOADU(IV);
+   for (; blocks > 0; blocks--) {
+      iv = _aesni_enc1(_mm_xor_si128(iv, LOADU(pt)), K, Nr);
+      STOREU(ct, iv);
+      pt += 16;
+      ct += 16;
+   }
+   STOREU(IV, iv);
+#ifdef LTC_CLEAN_STACK
+   zeromem(K, sizeof(K));
+#endif
+}
+
+/**
+  Accelerated CBC encryption
+  @param pt      Plaintext
+  @param ct      [out] Ciphertext
+  @param blocks  The number of complete blocks to process
+  @param IV      The initial value (input/output)
+  @param skey    The scheduled key context
+  @return CRYPT_OK if successful
+*/
+int aesni_accel_cbc_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *IV, symmetric_key *skey)
+{
+   int x, err;
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(IV != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   if (aesni_is_supported()) {
+      _aesni_cbc_encrypt(pt, ct, blocks, IV, skey);
+      return CRYPT_OK;
+   }
+   for (; blocks > 0; blocks--) {
+      for (x = 0; x < 16; x++) {
+         IV[x] ^= pt[x];
+      }
+      if ((err = rijndael_ecb_encrypt(IV, IV, skey)) != CRYPT_OK) {
+         return err;
+      }
+      XMEMCPY(ct, IV, 16);
+      pt += 16;
+      ct += 16;
+   }
+   return CRYPT_OK;
+}
+
+AESNI_TARGET
+static void _aesni_cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, unsigned char *IV, symmetric_key *skey)
+{
+   __m128i K[15], iv, c[AESNI_PAR], b[AESNI_PAR];
+   int Nr = skey->rijndael.Nr, i;
+
+   _aesni_load_keys(K, skey->rijndael.dK, Nr);
+   iv = LOADU(IV);
+   for (; blocks >= AESNI_PAR; blocks -= AESNI_PAR) {
+      /* all ciphertext blocks are loaded before the first store, so ct may equal pt */
+      for (i = 0; i < AESNI_PAR; i++) {
+         c[i] = b[i] = LOADU(ct + 16*i);
+      }
+      _aesni_dec8(b, K, Nr);
+      b[0] = _mm_xor_si128(b[0], iv);
+      for (i = 1; i < AESNI_PAR; i++) {
+         b[i] = _mm_xor_si128(b[i], c[i-1]);
+      }
+      iv = c[AESNI_PAR-1];
+      for (i = 0; i < AESNI_PAR; i++) {
+         STOREU(pt + 16*i, b[i]);
+      }
+      ct += 16 * AESNI_PAR;
+      pt += 16 * AESNI_PAR;
+   }
+   for (; blocks > 0; blocks--) {
+      c[0] = LOADU(ct);
+      STOREU(pt, _mm_xor_si128(_aesni_dec1(c[0], K, Nr), iv));
+      iv = c[0];
+      ct += 16;
+      pt += 16;
+   }
+   STOREU(IV, iv);
+#ifdef LTC_CLEAN_STACK
+   zeromem(K, sizeof(K));
+   zeromem(b, sizeof(b));
+#endif
+}
+
+/**
+  Accelerated CBC decryption
+  @param ct      Ciphertext
+  @param pt      [out] Plaintext
+  @param blocks  The number of complete blocks to process
+  @param IV      The initial value (input/output)
+  @param skey    The scheduled key context
+  @return CRYPT_OK if successful
+*/
+int aesni_accel_cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, unsigned char *IV, symmetric_key *skey)
+{
+   unsigned char tmp[16];
+   int x, err;
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(IV != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   if (aesni_is_supported()) {
+      _aesni_cbc_decrypt(ct, pt, blocks, IV, skey);
+      return CRYPT_OK;
+   }
+   for (; blocks > 0; blocks--) {
+      if ((err = rijndael_ecb_decrypt(ct, tmp, skey)) != CRYPT_OK) {
+         return err;
+      }
+      for (x = 0; x < 16; x++) {
+         tmp[x] ^= IV[x];
+         IV[x] = ct[x];
+         pt[x] = tmp[x];
+      }
+      ct += 16;
+      pt += 16;
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(tmp, sizeof(tmp));
+#endif
+   return CRYPT_OK;
+}
+
+#ifdef LTC_CTR_MODE
+AESNI_TARGET
+static void _aesni_ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *IV, int mode, symmetric_key *skey)
+{
+   const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+   __m128i K[15], b[AESNI_PAR];
+   ulong64 hi, lo;
+   int Nr = skey->rijndael.Nr, i, n;
+
+   _aesni_load_keys(K, skey->rijndael.eK, Nr);
+
+   /* the counter is kept as a 128-bit integer, a big endian counter is byte swapped when the blocks are built */
+   if (mode == CTR_COUNTER_LITTLE_ENDIAN) {
+      LOAD64L(lo, IV);
+      LOAD64L(hi, IV + 8);
+   } else {
+      LOAD64H(hi, IV);
+      LOAD64H(lo, IV + 8);
+   }
+
+   while (blocks > 0) {
+      n = blocks < AESNI_PAR ? (int)blocks : AESNI_PAR;
+      for (i = 0; i < n; i++) {
+         if (++lo == 0) {
+            ++hi;
+         }
+         b[i] = _mm_set_epi64x((long long)hi, (long long)lo);
+         if (mode != CTR_COUNTER_LITTLE_ENDIAN) {
+            b[i] = _mm_shuffle_epi8(b[i], bswap);
+         }
+      }
+      if (n == AESNI_PAR) {
+         _aesni_enc8(b, K, Nr);
+      } else {
+         for (i = 0; i < n; i++) {
+            b[i] = _aesni_enc1(b[i], K, Nr);
+         }
+      }
+      for (i = 0; i < n; i++) {
+         STOREU(ct + 16*i, _mm_xor_si128(b[i], LOADU(pt + 16*i)));
+      }
+      pt     += 16 * n;
+      ct     += 16 * n;
+      blocks -= n;
+   }
+
+   if (mode == CTR_COUNTER_LITTLE_ENDIAN) {
+      STORE64L(lo, IV);
+      STORE64L(hi, IV + 8);
+   } else {
+      STORE64H(hi, IV);
+      STORE64H(lo, IV + 8);
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(K, sizeof(K));
+   zeromem(b, sizeof(b));
+#endif
+}
+
+/**
+  Accelerated CTR encryption, the counter spans the whole block
+  @param pt      Plaintext
+  @param ct      [out] Ciphertext
+  @param blocks  The number of complete blocks to process
+  @param IV      The counter, it is incremented before each block (input/output)
+  @param mode    CTR_COUNTER_LITTLE_ENDIAN or CTR_COUNTER_BIG_ENDIAN
+  @param skey    The scheduled key context
+  @return CRYPT_OK if successful
+*/
+int aesni_accel_ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *IV, int mode, symmetric_key *skey)
+{
+   unsigned char pad[16];
+   int x, err;
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(IV != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   if (aesni_is_supported()) {
+      _aesni_ctr_encrypt(pt, ct, blocks, IV, mode, skey);
+      return CRYPT_OK;
+   }
+   for (; blocks > 0; blocks--) {
+      if (mode == CTR_COUNTER_LITTLE_ENDIAN) {
+         for (x = 0; x < 16 && ++IV[x] == 0; x++);
+      } else {
+         for (x = 15; x >= 0 && ++IV[x] == 0; x--);
+      }
+      if ((err = rijndael_ecb_encrypt(IV, pad, skey)) != CRYPT_OK) {
+         return err;
+      }
+      for (x = 0; x < 16; x++) {
+         ct[x] = pt[x] ^ pad[x];
+      }
+      pt += 16;
+      ct += 16;
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(pad, sizeof(pad));
+#endif
+   return CRYPT_OK;
+}
+#endif /* LTC_CTR_MODE */
+
+#ifdef LTC_XTS_MODE
+/* multiply the tweak by x in GF(2^128), c.f. xts_mult_x() */
+AESNI_TARGET
+static LTC_INLINE __m128i _aesni_xts_mult_x(__m128i t)
+{
+   __m128i carry = _mm_shuffle_epi32(_mm_srai_epi32(t, 31), 0x93);
+   carry = _mm_and_si128(carry, _mm_set_epi32(1, 1, 1, 0x87));
+   return _mm_xor_si128(_mm_add_epi32(t, t), carry);
+}
+
+AESNI_TARGET
+static void _aesni_xts(const unsigned char *in, unsigned char *out, unsigned long blocks, unsigned char *tweak,
+                       symmetric_key *skey1, symmetric_key *skey2, int enc)
+{
+   __m128i K1[15], K2[15], b[AESNI_PAR], t[AESNI_PAR], T;
+   int Nr = skey1->rijndael.Nr, i;
+
+   _aesni_load_keys(K1, enc ? skey1->rijndael.eK : skey1->rijndael.dK, Nr);
+   _aesni_load_keys(K2, skey2->rijndael.eK, skey2->rijndael.Nr);
+
+   /* encrypt the tweak */
+   T = _aesni_enc1(LOADU(tweak), K2, skey2->rijndael.Nr);
+
+   for (; blocks >= AESNI_PAR; blocks -= AESNI_PAR) {
+      for (i = 0; i < AESNI_PAR; i++) {
+         t[i] = T;
+         b[i] = _mm_xor_si128(LOADU(in + 16*i), T);
+         T = _aesni_xts_mult_x(T);
+      }
+      if (enc) {
+         _aesni_enc8(b, K1, Nr);
+      } else {
+         _aesni_dec8(b, K1, Nr);
+      }
+      for (i = 0; i < AESNI_PAR; i++) {
+         STOREU(out + 16*i, _mm_xor_si128(b[i], t[i]));
+      }
+      in  += 16 * AESNI_PAR;
+      out += 16 * AESNI_PAR;
+   }
+   for (; blocks > 0; blocks--) {
+      b[0] = _mm_xor_si128(LOADU(in), T);
+      b[0] = enc ? _aesni_enc1(b[0], K1, Nr) : _aesni_dec1(b[0], K1, Nr);
+      STOREU(out, _mm_xor_si128(b[0], T));
+      T = _aesni_xts_mult_x(T);
+      in  += 16;
+      out += 16;
+   }
+
+   /* the next tweak is returned encrypted */
+   STOREU(tweak, T);
+#ifdef LTC_CLEAN_STACK
+   zeromem(K1, sizeof(K1));
+   zeromem(K2, sizeof(K2));
+   zeromem(b, sizeof(b));
+   zeromem(t, sizeof(t));
+#endif
+}
+
+static int _xts_fallback(const unsigned char *in, unsigned char *out, unsigned long blocks, unsigned char *tweak,
+                         symmetric_key *skey1, symmetric_key *skey2, int enc)
+{
+   unsigned char T[16];
+   int x, err;
+
+   if ((err = rijndael_ecb_encrypt(tweak, T, skey2)) != CRYPT_OK) {
+      return err;
+   }
+   for (; blocks > 0; blocks--) {
+      for (x = 0; x < 16; x++) {
+         out[x] = in[x] ^ T[x];
+      }
+      err = enc ? rijndael_ecb_encrypt(out, out, skey1) : rijndael_ecb_decrypt(out, out, skey1);
+      if (err != CRYPT_OK) {
+         return err;
+      }
+      for (x = 0; x < 16; x++) {
+         out[x] ^= T[x];
+      }
+      xts_mult_x(T);
+      in  += 16;
+      out += 16;
+   }
+   XMEMCPY(tweak, T, 16);
+   return CRYPT_OK;
+}
+
+/**
+  Accelerated XTS encryption
+  @param pt      Plaintext
+  @param ct      [out] Ciphertext
+  @param blocks  The number of complete blocks to process
+  @param tweak   The tweak, unencrypted on input and the next tweak encrypted on output
+  @param skey1   The data key
+  @param skey2   The tweak key
+  @return CRYPT_OK if successful
+*/
+int aesni_accel_xts_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *tweak,
+                            symmetric_key *skey1, symmetric_key *skey2)
+{
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(tweak != NULL);
+   LTC_ARGCHK(skey1 != NULL);
+   LTC_ARGCHK(skey2 != NULL);
+
+   if (aesni_is_supported()) {
+      _aesni_xts(pt, ct, blocks, tweak, skey1, skey2, 1);
+      return CRYPT_OK;
+   }
+   return _xts_fallback(pt, ct, blocks, tweak, skey1, skey2, 1);
+}
+
+/**
+  Accelerated XTS decryption
+  @param ct      Ciphertext
+  @param pt      [out] Plaintext
+  @param blocks  The number of complete blocks to process
+  @param tweak   The tweak, unencrypted on input and the next tweak encrypted on output
+  @param skey1   The data key
+  @param skey2   The tweak key
+  @return CRYPT_OK if successful
+*/
+int aesni_accel_xts_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, unsigned char *tweak,
+                            symmetric_key *skey1, symmetric_key *skey2)
+{
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(tweak != NULL);
+   LTC_ARGCHK(skey1 != NULL);
+   LTC_ARGCHK(skey2 != NULL);
+
+   if (aesni_is_supported()) {
+      _aesni_xts(ct, pt, blocks, tweak, skey1, skey2, 0);
+      return CRYPT_OK;
+   }
+   return _xts_fallback(ct, pt, blocks, tweak, skey1, skey2, 0);
+}
+#endif /* LTC_XTS_MODE */
+
+#endif /* LTC_AES_NI */
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
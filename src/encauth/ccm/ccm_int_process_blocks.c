@@ -0,0 +1,124 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file ccm_int_process_blocks.c
+  CCM support, process whole blocks (internal function)
+*/
+
+#ifdef LTC_CCM_MODE
+
+/* out = in xor ks for n blocks */
+static void _ccm_xor_blocks(unsigned char *out, const unsigned char *in, const unsigned char *ks, unsigned long n)
+{
+   unsigned long x;
+#ifdef LTC_FAST
+   for (x = 0; x < n * 16; x += sizeof(LTC_FAST_TYPE)) {
+      *(LTC_FAST_TYPE_PTR_CAST(&out[x])) = *(LTC_FAST_TYPE_PTR_CAST(&in[x])) ^ *(LTC_FAST_TYPE_PTR_CAST(&ks[x]));
+   }
+#else
+   for (x = 0; x < n * 16; x++) {
+      out[x] = in[x] ^ ks[x];
+   }
+#endif
+}
+
+/**
+  Encrypt or decrypt whole blocks and add the plaintext to the CBC-MAC (internal function)
+
+  The keystream doesn't depend on the data, so it is computed for up to CCM_BATCH octets
+  at once with the accelerated ECB encryption if the cipher has one.  The CBC-MAC is a CBC
+  encryption with PAD as IV, so it goes through the accelerated CBC encryption if there is one.
+
+  @param cipher     The index of the cipher
+  @param skey       The scheduled key
+  @param L          The length of the counter field (octets)
+  @param ctr        [in/out] The last counter block used
+  @param PAD        [in/out] The CBC-MAC state, which must have been encrypted already
+  @param pt         The plaintext
+  @param ct         The ciphertext
+  @param blocks     The number of blocks
+  @param direction  CCM_ENCRYPT or CCM_DECRYPT
+  @return CRYPT_OK if successful
+*/
+int ccm_int_process_blocks(int cipher, symmetric_key *skey, unsigned long L,
+                           unsigned char *ctr, unsigned char *PAD,
+                           unsigned char *pt, unsigned char *ct,
+                           unsigned long blocks, int direction)
+{
+   unsigned char ks[CCM_BATCH], buf[CCM_BATCH];
+   unsigned long n, x, z;
+   int err;
+
+   err = CRYPT_OK;
+   while (blocks > 0) {
+      n = MIN(blocks, CCM_BATCH / 16);
+
+      /* the keystream of the next n counter blocks */
+      for (x = 0; x < n * 16; x += 16) {
+         for (z = 15; z > 15 - L; z--) {
+            ctr[z] = (ctr[z] + 1) & 255;
+            if (ctr[z]) break;
+         }
+         XMEMCPY(ks + x, ctr, 16);
+      }
+      if (cipher_descriptor[cipher].accel_ecb_encrypt != NULL) {
+         if ((err = cipher_descriptor[cipher].accel_ecb_encrypt(ks, ks, n, skey)) != CRYPT_OK) {
+            goto LBL_ERR;
+         }
+      } else {
+         for (x = 0; x < n * 16; x += 16) {
+            if ((err = cipher_descriptor[cipher].ecb_encrypt(ks + x, ks + x, skey)) != CRYPT_OK) {
+               goto LBL_ERR;
+            }
+         }
+      }
+
+      /* the MAC is taken over the plaintext, which has to be decrypted first */
+      if (direction == CCM_DECRYPT) {
+         _ccm_xor_blocks(pt, ct, ks, n);
+      }
+      if (cipher_descriptor[cipher].accel_cbc_encrypt != NULL) {
+         if ((err = cipher_descriptor[cipher].accel_cbc_encrypt(pt, buf, n, PAD, skey)) != CRYPT_OK) {
+            goto LBL_ERR;
+         }
+      } else {
+         for (x = 0; x < n * 16; x += 16) {
+            for (z = 0; z < 16; z++) {
+               PAD[z] ^= pt[x + z];
+            }
+            if ((err = cipher_descriptor[cipher].ecb_encrypt(PAD, PAD, skey)) != CRYPT_OK) {
+               goto LBL_ERR;
+            }
+         }
+      }
+      /* after the MAC, since ct may be pt */
+      if (direction == CCM_ENCRYPT) {
+         _ccm_xor_blocks(ct, pt, ks, n);
+      }
+
+      pt     += n * 16;
+      ct     += n * 16;
+      blocks -= n;
+   }
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(ks, sizeof(ks));
+   zeromem(buf, sizeof(buf));
+#endif
+   return err;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
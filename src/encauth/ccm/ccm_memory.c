@@ -238,52 +238,13 @@ int ccm_memory(int cipher,
 
    /* now handle the PT */
    if (ptlen > 0) {
-      y = 0;
-#ifdef LTC_FAST
-      if (ptlen & ~15)  {
-          if (direction == CCM_ENCRYPT) {
-             for (; y < (ptlen & ~15); y += 16) {
-                /* increment the ctr? */
-                for (z = 15; z > 15-L; z--) {
-                    ctr[z] = (ctr[z] + 1) & 255;
-                    if (ctr[z]) break;
-                }
-                if ((err = cipher_descriptor[cipher].ecb_encrypt(ctr, CTRPAD, skey)) != CRYPT_OK) {
-                   goto error;
-                }
-
-                /* xor the PT against the pad first */
-                for (z = 0; z < 16; z += sizeof(LTC_FAST_TYPE)) {
-                    *(LTC_FAST_TYPE_PTR_CAST(&PAD[z]))  ^= *(LTC_FAST_TYPE_PTR_CAST(&pt[y+z]));
-                    *(LTC_FAST_TYPE_PTR_CAST(&ct[y+z])) = *(LTC_FAST_TYPE_PTR_CAST(&pt[y+z])) ^ *(LTC_FAST_TYPE_PTR_CAST(&CTRPAD[z]));
-                }
-                if ((err = cipher_descriptor[cipher].ecb_encrypt(PAD, PAD, skey)) != CRYPT_OK) {
-                   goto error;
-                }
-             }
-          } else { /* direction == CCM_DECRYPT */
-             for (; y < (ptlen & ~15); y += 16) {
-                /* increment the ctr? */
-                for (z = 15; z > 15-L; z--) {
-                    ctr[z] = (ctr[z] + 1) & 255;
-                    if (ctr[z]) break;
-                }
-                if ((err = cipher_descriptor[cipher].ecb_encrypt(ctr, CTRPAD, skey)) != CRYPT_OK) {
-                   goto error;
-                }
-
-                /* xor the PT against the pad last */
-                for (z = 0; z < 16; z += sizeof(LTC_FAST_TYPE)) {
-                    *(LTC_FAST_TYPE_PTR_CAST(&pt[y+z])) = *(LTC_FAST_TYPE_PTR_CAST(&ct[y+z])) ^ *(LTC_FAST_TYPE_PTR_CAST(&CTRPAD[z]));
-                    *(LTC_FAST_TYPE_PTR_CAST(&PAD[z]))  ^= *(LTC_FAST_TYPE_PTR_CAST(&pt[y+z]));
-                }
-                if ((err = cipher_descriptor[cipher].ecb_encrypt(PAD, PAD, skey)) != CRYPT_OK) {
-                   goto error;
-                }
-             }
-          }
+      /* whole blocks, x is 0 and the PAD encrypted at this point */
+      y = ptlen & ~15UL;
+      if (y > 0) {
+         if ((err = ccm_int_process_blocks(cipher, skey, L, ctr, PAD, pt, ct, y / 16, direction)) != CRYPT_OK) {
+            goto error;
+         }
       }
-#endif
 
       for (; y < ptlen; y++) {
           /* increment the ctr? */
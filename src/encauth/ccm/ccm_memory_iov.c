@@ -0,0 +1,143 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file ccm_memory_iov.c
+  CCM support, process a packet given as scatter/gather lists
+*/
+
+#ifdef LTC_CCM_MODE
+
+typedef struct {
+   ccm_state *ccm;
+   int        direction;
+} _ccm_iov;
+
+static int _ccm_iov_process(void *state, const unsigned char *in, unsigned char *out, unsigned long len)
+{
+   _ccm_iov *s = state;
+
+   if (s->direction == CCM_ENCRYPT) {
+      return ccm_process(s->ccm, (unsigned char *)in, len, out, CCM_ENCRYPT);
+   }
+   return ccm_process(s->ccm, out, len, (unsigned char *)in, CCM_DECRYPT);
+}
+
+/**
+   CCM encrypt/decrypt and produce an authentication tag, the header, input and output are
+   scatter/gather lists which don't have to be split at the same places.
+
+   When decrypting the tag is an input and compared with the computed one, on a mismatch
+   CRYPT_ERROR is returned and the output segments are zeroed.
+
+   @param cipher     The index of the cipher desired
+   @param key        The secret key to use
+   @param keylen     The length of the secret key (octets)
+   @param nonce      The session nonce [use once]
+   @param noncelen   The length of the nonce
+   @param header     The segments of the header for the session
+   @param headercnt  The number of header segments
+   @param in         The segments of the plaintext (encrypt) or ciphertext (decrypt)
+   @param incnt      The number of input segments
+   @param out        [out] The segments of the ciphertext (encrypt) or plaintext (decrypt)
+   @param outcnt     The number of output segments, their total length must be the one of the input
+   @param tag        [*1] The destination (encrypt) or the expected (decrypt) tag
+   @param taglen     The max size and resulting size of the authentication tag
+   @param direction  Encrypt or Decrypt direction (0 or 1)
+   @return CRYPT_OK if successful
+*/
+int ccm_memory_iov(int cipher,
+    const unsigned char *key,    unsigned long keylen,
+    const unsigned char *nonce,  unsigned long noncelen,
+    const ltc_iovec     *header, unsigned long headercnt,
+    const ltc_iovec     *in,     unsigned long incnt,
+    const ltc_iovec     *out,    unsigned long outcnt,
+          unsigned char *tag,    unsigned long *taglen,
+                    int  direction)
+{
+   ccm_state     *ccm;
+   _ccm_iov       s;
+   unsigned char  buf[16], mask;
+   unsigned long  headerlen, ptlen, x, y, len;
+   int            err;
+
+   LTC_ARGCHK(header != NULL || headercnt == 0);
+   LTC_ARGCHK(out    != NULL || outcnt    == 0);
+   LTC_ARGCHK(tag    != NULL);
+   LTC_ARGCHK(taglen != NULL);
+
+   if (direction != CCM_ENCRYPT && direction != CCM_DECRYPT) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   /* ccm_init() takes the lengths as int */
+   headerlen = crypt_iov_len(header, headercnt);
+   ptlen     = crypt_iov_len(out, outcnt);
+   if (headerlen > 0x7FFFFFFFUL || ptlen > 0x7FFFFFFFUL || keylen > 0x7FFFFFFFUL) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   ccm = XMALLOC(sizeof(*ccm));
+   if (ccm == NULL) {
+      return CRYPT_MEM;
+   }
+
+   if ((err = ccm_init(ccm, cipher, key, (int)keylen, (int)ptlen, (int)MIN(*taglen, 16), (int)headerlen)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   if ((err = ccm_add_nonce(ccm, nonce, noncelen)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   for (x = 0; x < headercnt; x++) {
+      if (header[x].len > 0 && (err = ccm_add_aad(ccm, header[x].data, header[x].len)) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+   }
+   s.ccm       = ccm;
+   s.direction = direction;
+   if ((err = crypt_iov_process(in, incnt, out, outcnt, 16, _ccm_iov_process, &s)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+
+   if (direction == CCM_ENCRYPT) {
+      err = ccm_done(ccm, tag, taglen);
+   } else {
+      len = *taglen;
+      if ((err = ccm_done(ccm, buf, &len)) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+      *taglen = len;
+
+      /* compare in constant time, the boolean value of XMEM_NEQ becomes CRYPT_OK or CRYPT_ERROR
+       * as in ccm_memory(), and zero the plaintext if the tag was invalid
+       */
+      err = XMEM_NEQ(buf, tag, len);
+      mask = (unsigned char)(0xff * (1 - err));
+      for (x = 0; x < outcnt; x++) {
+         for (y = 0; y < out[x].len; y++) {
+            out[x].data[y] &= mask;
+         }
+      }
+   }
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(ccm, sizeof(*ccm));
+   zeromem(buf, sizeof(buf));
+#endif
+   XFREE(ccm);
+   return err;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -24,7 +24,8 @@ int ccm_process(ccm_state *ccm,
                 unsigned char *ct,
                 int direction)
 {
-   unsigned char  y, z, b;
+   unsigned long  y, z;
+   unsigned char  b;
    int err;
 
    LTC_ARGCHK(ccm != NULL);
@@ -46,6 +47,21 @@ int ccm_process(ccm_state *ccm,
       LTC_ARGCHK(ct != NULL);
       y = 0;
 
+      /* whole blocks when the keystream and the MAC are at a block boundary */
+      if (ccm->CTRlen == 16 && ptlen >= 16) {
+         if (ccm->x == 16) {
+            if ((err = cipher_descriptor[ccm->cipher].ecb_encrypt(ccm->PAD, ccm->PAD, &ccm->K)) != CRYPT_OK) {
+               return err;
+            }
+            ccm->x = 0;
+         }
+         y = ptlen & ~15UL;
+         if ((err = ccm_int_process_blocks(ccm->cipher, &ccm->K, ccm->L, ccm->ctr, ccm->PAD,
+                                           pt, ct, y / 16, direction)) != CRYPT_OK) {
+            return err;
+         }
+      }
+
       for (; y < ptlen; y++) {
          /* increment the ctr? */
          if (ccm->CTRlen == 16) {
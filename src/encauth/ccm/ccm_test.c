@@ -113,6 +113,9 @@ int ccm_test(void)
 };
   unsigned long taglen, x, y;
   unsigned char buf[64], buf2[64], tag[16], tag2[16], tag3[16], zero[64];
+  unsigned char big[300], big2[300];
+  /* the second piece ends on a block boundary with the last MAC block not encrypted yet */
+  const unsigned long pieces[] = { 5, 11, 37, 27, 220 };
   int           err, idx;
   symmetric_key skey;
   ccm_state ccm;
@@ -235,6 +238,39 @@ int ccm_test(void)
     }
   }
 
+  /* a longer message fed to ccm_process() in pieces, some of them not on block boundaries,
+   * must give the same result as ccm_memory() */
+  for (x = 0; x < sizeof(big); x++) {
+     big[x] = (unsigned char)x;
+  }
+  taglen = 16;
+  if ((err = ccm_memory(idx, tests[0].key, 16, NULL, tests[0].nonce, tests[0].noncelen,
+                        tests[0].header, tests[0].headerlen, big, sizeof(big), big2, tag, &taglen, CCM_ENCRYPT)) != CRYPT_OK) {
+     return err;
+  }
+  if ((err = ccm_init(&ccm, idx, tests[0].key, 16, sizeof(big), 16, tests[0].headerlen)) != CRYPT_OK) {
+     return err;
+  }
+  if ((err = ccm_add_nonce(&ccm, tests[0].nonce, tests[0].noncelen)) != CRYPT_OK) {
+     return err;
+  }
+  if ((err = ccm_add_aad(&ccm, tests[0].header, tests[0].headerlen)) != CRYPT_OK) {
+     return err;
+  }
+  for (x = 0, y = 0; y < sizeof(pieces)/sizeof(pieces[0]); x += pieces[y++]) {
+     if ((err = ccm_process(&ccm, big + x, pieces[y], big + x, CCM_ENCRYPT)) != CRYPT_OK) {
+        return err;
+     }
+  }
+  taglen = 16;
+  if ((err = ccm_done(&ccm, tag2, &taglen)) != CRYPT_OK) {
+     return err;
+  }
+  if (compare_testvector(big, sizeof(big), big2, sizeof(big2), "CCM process pieces data", 0) ||
+      compare_testvector(tag2, taglen, tag, 16, "CCM process pieces tag", 0)) {
+     return CRYPT_FAIL_TESTVECTOR;
+  }
+
   return CRYPT_OK;
 #endif
 }
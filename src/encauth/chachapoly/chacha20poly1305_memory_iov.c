@@ -0,0 +1,88 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+#include "tomcrypt.h"
+
+#ifdef LTC_CHACHA20POLY1305_MODE
+
+static int _chacha20poly1305_iov_encrypt(void *state, const unsigned char *in, unsigned char *out, unsigned long len)
+{
+   return chacha20poly1305_encrypt(state, in, len, out);
+}
+
+static int _chacha20poly1305_iov_decrypt(void *state, const unsigned char *in, unsigned char *out, unsigned long len)
+{
+   return chacha20poly1305_decrypt(state, in, len, out);
+}
+
+/**
+  Process an entire ChaCha20Poly1305 packet in one call, the AAD, input and output are
+  scatter/gather lists which don't have to be split at the same places.
+  @param key               The secret key
+  @param keylen            The length of the secret key
+  @param iv                The initial vector
+  @param ivlen             The length of the initial vector
+  @param aad               The segments of the additional authentication data (header)
+  @param aadcnt            The number of AAD segments
+  @param in                The segments of the plaintext (encrypt) or ciphertext (decrypt)
+  @param incnt             The number of input segments
+  @param out               [out] The segments of the ciphertext (encrypt) or plaintext (decrypt)
+  @param outcnt            The number of output segments, their total length must be the one of the input
+  @param tag               [out] The MAC tag
+  @param taglen            [in/out] The MAC tag length
+  @param direction         Encrypt or Decrypt mode (CHCHA20POLY1305_ENCRYPT or CHCHA20POLY1305_DECRYPT)
+  @return CRYPT_OK on success
+ */
+int chacha20poly1305_memory_iov(const unsigned char *key, unsigned long keylen,
+                                const unsigned char *iv,  unsigned long ivlen,
+                                const ltc_iovec     *aad, unsigned long aadcnt,
+                                const ltc_iovec     *in,  unsigned long incnt,
+                                const ltc_iovec     *out, unsigned long outcnt,
+                                      unsigned char *tag, unsigned long *taglen,
+                                int direction)
+{
+   chacha20poly1305_state st;
+   ltc_iov_cb process;
+   unsigned long x;
+   int err;
+
+   LTC_ARGCHK(key != NULL);
+   LTC_ARGCHK(iv  != NULL);
+   LTC_ARGCHK(aad != NULL || aadcnt == 0);
+   LTC_ARGCHK(tag != NULL);
+
+   if (direction == CHCHA20POLY1305_ENCRYPT) {
+      process = _chacha20poly1305_iov_encrypt;
+   }
+   else if (direction == CHCHA20POLY1305_DECRYPT) {
+      process = _chacha20poly1305_iov_decrypt;
+   }
+   else {
+      return CRYPT_INVALID_ARG;
+   }
+
+   if ((err = chacha20poly1305_init(&st, key, keylen)) != CRYPT_OK)          { goto LBL_ERR; }
+   if ((err = chacha20poly1305_setiv(&st, iv, ivlen)) != CRYPT_OK)           { goto LBL_ERR; }
+   for (x = 0; x < aadcnt; x++) {
+      if ((err = chacha20poly1305_add_aad(&st, aad[x].data, aad[x].len)) != CRYPT_OK) { goto LBL_ERR; }
+   }
+   if ((err = crypt_iov_process(in, incnt, out, outcnt, 1, process, &st)) != CRYPT_OK) { goto LBL_ERR; }
+   err = chacha20poly1305_done(&st, tag, taglen);
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(&st, sizeof(chacha20poly1305_state));
+#endif
+   return err;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -26,19 +26,27 @@
 int eax_decrypt(eax_state *eax, const unsigned char *ct, unsigned char *pt,
                 unsigned long length)
 {
+   unsigned long n;
    int err;
 
    LTC_ARGCHK(eax != NULL);
    LTC_ARGCHK(pt  != NULL);
    LTC_ARGCHK(ct  != NULL);
 
-   /* omac ciphertext */
-   if ((err = omac_process(&eax->ctomac, ct, length)) != CRYPT_OK) {
-      return err;
+   /* omac and decrypt the ciphertext in chunks, so it's still in the cache for the decryption */
+   while (length > 0) {
+      n = MIN(length, EAX_CHUNK);
+      if ((err = omac_process(&eax->ctomac, ct, n)) != CRYPT_OK) {
+         return err;
+      }
+      if ((err = ctr_decrypt(ct, pt, n, &eax->ctr)) != CRYPT_OK) {
+         return err;
+      }
+      pt     += n;
+      ct     += n;
+      length -= n;
    }
-
-   /* decrypt  */
-   return ctr_decrypt(ct, pt, length, &eax->ctr);
+   return CRYPT_OK;
 }
 
 #endif
@@ -26,19 +26,27 @@
 int eax_encrypt(eax_state *eax, const unsigned char *pt, unsigned char *ct,
                 unsigned long length)
 {
+   unsigned long n;
    int err;
 
    LTC_ARGCHK(eax != NULL);
    LTC_ARGCHK(pt  != NULL);
    LTC_ARGCHK(ct  != NULL);
 
-   /* encrypt */
-   if ((err = ctr_encrypt(pt, ct, length, &eax->ctr)) != CRYPT_OK) {
-      return err;
+   /* encrypt and omac the ciphertext in chunks, so it's still in the cache for the omac */
+   while (length > 0) {
+      n = MIN(length, EAX_CHUNK);
+      if ((err = ctr_encrypt(pt, ct, n, &eax->ctr)) != CRYPT_OK) {
+         return err;
+      }
+      if ((err = omac_process(&eax->ctomac, ct, n)) != CRYPT_OK) {
+         return err;
+      }
+      pt     += n;
+      ct     += n;
+      length -= n;
    }
-
-   /* omac ciphertext */
-   return omac_process(&eax->ctomac, ct, length);
+   return CRYPT_OK;
 }
 
 #endif
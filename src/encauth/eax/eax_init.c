@@ -69,6 +69,9 @@ int eax_init(eax_state *eax, int cipher,
    if ((err = omac_init(omac, cipher, key, keylen)) != CRYPT_OK) {
       goto LBL_ERR;
    }
+   /* the three OMACs start the same, schedule the key only once */
+   XMEMCPY(&eax->headeromac, omac, sizeof(*omac));
+   XMEMCPY(&eax->ctomac, omac, sizeof(*omac));
 
    /* omac the [0]_n */
    if ((err = omac_process(omac, buf, blklen)) != CRYPT_OK) {
@@ -88,10 +91,6 @@ int eax_init(eax_state *eax, int cipher,
    zeromem(buf, MAXBLOCKSIZE);
    buf[blklen - 1] = 1;
 
-   if ((err = omac_init(&eax->headeromac, cipher, key, keylen)) != CRYPT_OK) {
-      goto LBL_ERR;
-   }
-
    /* omac the [1]_n */
    if ((err = omac_process(&eax->headeromac, buf, blklen)) != CRYPT_OK) {
       goto LBL_ERR;
@@ -110,12 +109,7 @@ int eax_init(eax_state *eax, int cipher,
       goto LBL_ERR;
    }
 
-   /* setup the LTC_OMAC for the ciphertext */
-   if ((err = omac_init(&eax->ctomac, cipher, key, keylen)) != CRYPT_OK) {
-      goto LBL_ERR;
-   }
-
-   /* omac [2]_n */
+   /* omac [2]_n for the ciphertext */
    zeromem(buf, MAXBLOCKSIZE);
    buf[blklen-1] = 2;
    if ((err = omac_process(&eax->ctomac, buf, blklen)) != CRYPT_OK) {
@@ -31,6 +31,10 @@ int gcm_init(gcm_state *gcm, int cipher,
 #ifdef LTC_GCM_TABLES
    int           x, y, z, t;
 #endif
+#ifdef LTC_GCM_TABLES_4BIT
+   int           x, y;
+   ulong64       vl, vh, T;
+#endif
 
    LTC_ARGCHK(gcm != NULL);
    LTC_ARGCHK(key != NULL);
@@ -70,6 +74,40 @@ int gcm_init(gcm_state *gcm, int cipher,
    gcm->totlen   = 0;
    gcm->pttotlen = 0;
 
+#ifdef LTC_GCM_TABLES_4BIT
+   /* setup the 4-bit tables, HH:HL[i] = H * i with the bits of i in GHASH order */
+   LOAD64H(vh, gcm->H);
+   LOAD64H(vl, gcm->H + 8);
+   gcm->HH[0] = gcm->HL[0] = 0;
+   gcm->HH[8] = vh;
+   gcm->HL[8] = vl;
+   for (x = 4; x > 0; x >>= 1) {
+      /* multiply by x */
+      T  = (vl & 1) * CONST64(0xE100000000000000);
+      vl = (vh << 63) | (vl >> 1);
+      vh = (vh >> 1) ^ T;
+      gcm->HH[x] = vh;
+      gcm->HL[x] = vl;
+   }
+   for (x = 2; x <= 8; x <<= 1) {
+      for (y = 1; y < x; y++) {
+         gcm->HH[x + y] = gcm->HH[x] ^ gcm->HH[y];
+         gcm->HL[x + y] = gcm->HL[x] ^ gcm->HL[y];
+      }
+   }
+#endif
+
+#ifdef LTC_GCM_PCLMUL
+   gcm->pclmul = gcm_pclmul_is_supported();
+   if (gcm->pclmul) {
+      /* the powers of H replace the 64KiB tables */
+      gcm_pclmul_init(gcm);
+#ifdef LTC_GCM_TABLES
+      return CRYPT_OK;
+#endif
+   }
+#endif
+
 #ifdef LTC_GCM_TABLES
    /* setup tables */
 
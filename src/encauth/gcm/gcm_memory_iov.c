@@ -0,0 +1,125 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+   @file gcm_memory_iov.c
+   GCM implementation, process a packet given as scatter/gather lists
+*/
+#include "tomcrypt.h"
+
+#ifdef LTC_GCM_MODE
+
+typedef struct {
+   gcm_state *gcm;
+   int        direction;
+} _gcm_iov;
+
+static int _gcm_iov_process(void *state, const unsigned char *in, unsigned char *out, unsigned long len)
+{
+   _gcm_iov *s = state;
+
+   if (s->direction == GCM_ENCRYPT) {
+      return gcm_process(s->gcm, (unsigned char *)in, len, out, GCM_ENCRYPT);
+   }
+   return gcm_process(s->gcm, out, len, (unsigned char *)in, s->direction);
+}
+
+/**
+  Process an entire GCM packet in one call, the AAD, input and output are scatter/gather lists
+  which don't have to be split at the same places.
+  @param cipher            Index of cipher to use
+  @param key               The secret key
+  @param keylen            The length of the secret key
+  @param IV                The initial vector
+  @param IVlen             The length of the initial vector
+  @param aad               The segments of the additional authentication data (header)
+  @param aadcnt            The number of AAD segments
+  @param in                The segments of the plaintext (encrypt) or ciphertext (decrypt)
+  @param incnt             The number of input segments
+  @param out               [out] The segments of the ciphertext (encrypt) or plaintext (decrypt)
+  @param outcnt            The number of output segments, their total length must be the one of the input
+  @param tag               [out] The MAC tag
+  @param taglen            [in/out] The MAC tag length
+  @param direction         Encrypt or Decrypt mode (GCM_ENCRYPT or GCM_DECRYPT)
+  @return CRYPT_OK on success
+ */
+int gcm_memory_iov(      int           cipher,
+                   const unsigned char *key,    unsigned long keylen,
+                   const unsigned char *IV,     unsigned long IVlen,
+                   const ltc_iovec     *aad,    unsigned long aadcnt,
+                   const ltc_iovec     *in,     unsigned long incnt,
+                   const ltc_iovec     *out,    unsigned long outcnt,
+                         unsigned char *tag,    unsigned long *taglen,
+                                   int direction)
+{
+    void      *orig;
+    gcm_state *gcm;
+    _gcm_iov   s;
+    unsigned long x;
+    int        err;
+
+    LTC_ARGCHK(aad != NULL || aadcnt == 0);
+
+    if ((err = cipher_is_valid(cipher)) != CRYPT_OK) {
+       return err;
+    }
+
+#ifndef LTC_GCM_TABLES_SSE2
+    orig = gcm = XMALLOC(sizeof(*gcm));
+#else
+    orig = gcm = XMALLOC(sizeof(*gcm) + 16);
+#endif
+    if (gcm == NULL) {
+        return CRYPT_MEM;
+    }
+
+   /* see gcm_memory() */
+#ifdef LTC_GCM_TABLES_SSE2
+   if ((unsigned long)gcm & 15) {
+      gcm = (gcm_state *)((unsigned long)gcm + (16 - ((unsigned long)gcm & 15)));
+   }
+#endif
+
+    if ((err = gcm_init(gcm, cipher, key, keylen)) != CRYPT_OK) {
+       goto LTC_ERR;
+    }
+    if ((err = gcm_add_iv(gcm, IV, IVlen)) != CRYPT_OK) {
+       goto LTC_ERR;
+    }
+    /* an empty call moves from the IV to the AAD even if there are no segments */
+    if ((err = gcm_add_aad(gcm, NULL, 0)) != CRYPT_OK) {
+       goto LTC_ERR;
+    }
+    for (x = 0; x < aadcnt; x++) {
+       if ((err = gcm_add_aad(gcm, aad[x].data, aad[x].len)) != CRYPT_OK) {
+          goto LTC_ERR;
+       }
+    }
+    if ((err = gcm_process(gcm, NULL, 0, NULL, direction)) != CRYPT_OK) {
+       goto LTC_ERR;
+    }
+    s.gcm       = gcm;
+    s.direction = direction;
+    if ((err = crypt_iov_process(in, incnt, out, outcnt, 16, _gcm_iov_process, &s)) != CRYPT_OK) {
+       goto LTC_ERR;
+    }
+    err = gcm_done(gcm, tag, taglen);
+LTC_ERR:
+#ifdef LTC_CLEAN_STACK
+    zeromem(gcm, sizeof(*gcm));
+#endif
+    XFREE(orig);
+    return err;
+}
+#endif
+
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
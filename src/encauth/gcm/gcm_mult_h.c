@@ -14,6 +14,44 @@
 #include "tomcrypt.h"
 
 #if defined(LTC_GCM_MODE)
+
+#ifdef LTC_GCM_TABLES_4BIT
+/* the reduction of the four bits shifted out, (x^128 + x^7 + x^2 + x + 1) * i */
+static const ulong64 _gcm_last4[16] = {
+   CONST64(0x0000), CONST64(0x1c20), CONST64(0x3840), CONST64(0x2460),
+   CONST64(0x7080), CONST64(0x6ca0), CONST64(0x48c0), CONST64(0x54e0),
+   CONST64(0xe100), CONST64(0xfd20), CONST64(0xd940), CONST64(0xc560),
+   CONST64(0x9180), CONST64(0x8da0), CONST64(0xa9c0), CONST64(0xb5e0)
+};
+
+/* Shoup's method, multiply by H four bits at a time starting with the last one */
+static void _gcm_mult_4bit(const gcm_state *gcm, const unsigned char *I, unsigned char *T)
+{
+   ulong64 zh, zl;
+   int x, n, rem;
+
+   n  = I[15] & 15;
+   zh = gcm->HH[n];
+   zl = gcm->HL[n];
+   for (x = 15; x >= 0; x--) {
+      if (x != 15) {
+         n   = I[x] & 15;
+         rem = (int)(zl & 15);
+         zl  = (zh << 60) | (zl >> 4);
+         zh  = (zh >> 4) ^ (_gcm_last4[rem] << 48) ^ gcm->HH[n];
+         zl ^= gcm->HL[n];
+      }
+      n   = I[x] >> 4;
+      rem = (int)(zl & 15);
+      zl  = (zh << 60) | (zl >> 4);
+      zh  = (zh >> 4) ^ (_gcm_last4[rem] << 48) ^ gcm->HH[n];
+      zl ^= gcm->HL[n];
+   }
+   STORE64H(zh, T);
+   STORE64H(zl, T + 8);
+}
+#endif
+
 /**
   GCM multiply by H
   @param gcm   The GCM state which holds the H value
@@ -24,6 +62,14 @@ void gcm_mult_h(gcm_state *gcm, unsigned char *I)
    unsigned char T[16];
 #ifdef LTC_GCM_TABLES
    int x;
+#endif
+#ifdef LTC_GCM_PCLMUL
+   if (gcm->pclmul) {
+      gcm_pclmul_mult_h(gcm, I);
+      return;
+   }
+#endif
+#ifdef LTC_GCM_TABLES
 #ifdef LTC_GCM_TABLES_SSE2
    asm("movdqa (%0),%%xmm0"::"r"(&gcm->PC[0][I[0]][0]));
    for (x = 1; x < 16; x++) {
@@ -45,11 +91,44 @@ void gcm_mult_h(gcm_state *gcm, unsigned char *I)
 #endif /* LTC_FAST */
    }
 #endif /* LTC_GCM_TABLES_SSE2 */
+#elif defined(LTC_GCM_TABLES_4BIT)
+   _gcm_mult_4bit(gcm, I, T);
 #else
    gcm_gf_mult(gcm->H, I, T);
 #endif
    XMEMCPY(I, T, 16);
 }
+
+/**
+  GHASH whole blocks into the accumulator, X = (X ^ in) * H for every block
+  @param gcm     The GCM state which holds the H value
+  @param in      The blocks to hash
+  @param blocks  The number of 16 byte blocks
+ */
+void gcm_ghash(gcm_state *gcm, const unsigned char *in, unsigned long blocks)
+{
+   int x;
+
+#ifdef LTC_GCM_PCLMUL
+   if (gcm->pclmul) {
+      gcm_pclmul_ghash(gcm, in, blocks);
+      return;
+   }
+#endif
+   for (; blocks > 0; blocks--) {
+#ifdef LTC_FAST
+      for (x = 0; x < 16; x += sizeof(LTC_FAST_TYPE)) {
+         *(LTC_FAST_TYPE_PTR_CAST(&gcm->X[x])) ^= *(LTC_FAST_TYPE_PTR_CAST(&in[x]));
+      }
+#else
+      for (x = 0; x < 16; x++) {
+         gcm->X[x] ^= in[x];
+      }
+#endif
+      gcm_mult_h(gcm, gcm->X);
+      in += 16;
+   }
+}
 #endif
 
 /* ref:         $Format:%D$ */
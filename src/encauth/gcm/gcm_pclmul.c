@@ -0,0 +1,181 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+   @file gcm_pclmul.c
+   GCM implementation, GHASH with the PCLMULQDQ instruction
+
+   The blocks are byte reversed on load, so the bit reflected GHASH field elements can be
+   multiplied as polynomials, the product is shifted left by one bit and reduced modulo
+   x^128 + x^7 + x^2 + x + 1 (c.f. Intel's "Carry-Less Multiplication Instruction and its
+   Usage for Computing the GCM Mode", algorithms 2, 4 and 5).  Eight blocks are multiplied by
+   H^8 ... H^1 and summed up before a single reduction.
+*/
+#include "tomcrypt.h"
+
+#ifdef LTC_GCM_PCLMUL
+
+#include <wmmintrin.h>
+#include <tmmintrin.h>
+
+#define PCLMUL_TARGET LTC_TARGET("pclmul,ssse3")
+
+/**
+  Check whether the CPU supports PCLMULQDQ
+  @return 1 if the GHASH can use PCLMULQDQ, 0 otherwise
+*/
+int gcm_pclmul_is_supported(void)
+{
+   const unsigned long need = LTC_CPU_PCLMUL | LTC_CPU_SSSE3;
+   return (crypt_cpu_features() & need) == need;
+}
+
+PCLMUL_TARGET
+static LTC_INLINE __m128i _bswap(__m128i x)
+{
+   return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+/* accumulate the 256-bit product a*b into lo, mid, hi */
+PCLMUL_TARGET
+static LTC_INLINE void _clmul_acc(__m128i a, __m128i b, __m128i *lo, __m128i *mid, __m128i *hi)
+{
+   *lo  = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+   *hi  = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+   *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x01));
+   *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x10));
+}
+
+/* shift the 256-bit product left by one bit and reduce it */
+PCLMUL_TARGET
+static LTC_INLINE __m128i _reduce(__m128i lo, __m128i mid, __m128i hi)
+{
+   __m128i t2, t4, t5, t7, t8, t9;
+
+   lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+   hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+   /* hi:lo <<= 1 */
+   t7 = _mm_srli_epi32(lo, 31);
+   t8 = _mm_srli_epi32(hi, 31);
+   lo = _mm_slli_epi32(lo, 1);
+   hi = _mm_slli_epi32(hi, 1);
+   t9 = _mm_srli_si128(t7, 12);
+   t8 = _mm_slli_si128(t8, 4);
+   t7 = _mm_slli_si128(t7, 4);
+   lo = _mm_or_si128(lo, t7);
+   hi = _mm_or_si128(hi, t8);
+   hi = _mm_or_si128(hi, t9);
+
+   /* reduce */
+   t7 = _mm_slli_epi32(lo, 31);
+   t8 = _mm_slli_epi32(lo, 30);
+   t9 = _mm_slli_epi32(lo, 25);
+   t7 = _mm_xor_si128(t7, t8);
+   t7 = _mm_xor_si128(t7, t9);
+   t8 = _mm_srli_si128(t7, 4);
+   t7 = _mm_slli_si128(t7, 12);
+   lo = _mm_xor_si128(lo, t7);
+   t2 = _mm_srli_epi32(lo, 1);
+   t4 = _mm_srli_epi32(lo, 2);
+   t5 = _mm_srli_epi32(lo, 7);
+   t2 = _mm_xor_si128(t2, t4);
+   t2 = _mm_xor_si128(t2, t5);
+   t2 = _mm_xor_si128(t2, t8);
+   lo = _mm_xor_si128(lo, t2);
+   return _mm_xor_si128(hi, lo);
+}
+
+PCLMUL_TARGET
+static LTC_INLINE __m128i _gfmul(__m128i a, __m128i b)
+{
+   __m128i lo, mid, hi;
+
+   lo = mid = hi = _mm_setzero_si128();
+   _clmul_acc(a, b, &lo, &mid, &hi);
+   return _reduce(lo, mid, hi);
+}
+
+/**
+  Precompute the powers of H
+  @param gcm   The GCM state which holds the H value
+*/
+PCLMUL_TARGET
+void gcm_pclmul_init(gcm_state *gcm)
+{
+   __m128i H, P;
+   int i;
+
+   LTC_ARGCHKVD(gcm != NULL);
+
+   H = P = _bswap(_mm_loadu_si128((const __m128i*)(const void*)gcm->H));
+   _mm_storeu_si128((__m128i*)(void*)gcm->HP[0], H);
+   for (i = 1; i < 8; i++) {
+      P = _gfmul(P, H);
+      _mm_storeu_si128((__m128i*)(void*)gcm->HP[i], P);
+   }
+}
+
+/**
+  GCM multiply by H
+  @param gcm   The GCM state which holds the H value
+  @param I     The value to multiply H by
+*/
+PCLMUL_TARGET
+void gcm_pclmul_mult_h(gcm_state *gcm, unsigned char *I)
+{
+   __m128i X, H;
+
+   H = _mm_loadu_si128((const __m128i*)(const void*)gcm->HP[0]);
+   X = _bswap(_mm_loadu_si128((const __m128i*)(const void*)I));
+   _mm_storeu_si128((__m128i*)(void*)I, _bswap(_gfmul(X, H)));
+}
+
+/**
+  GHASH whole blocks into the accumulator
+  @param gcm     The GCM state
+  @param in      The blocks to hash
+  @param blocks  The number of 16 byte blocks
+*/
+PCLMUL_TARGET
+void gcm_pclmul_ghash(gcm_state *gcm, const unsigned char *in, unsigned long blocks)
+{
+   __m128i X, H[8], lo, mid, hi;
+   int i;
+
+   for (i = 0; i < 8; i++) {
+      H[i] = _mm_loadu_si128((const __m128i*)(const void*)gcm->HP[i]);
+   }
+   X = _bswap(_mm_loadu_si128((const __m128i*)(const void*)gcm->X));
+
+   /* X = (X ^ C0) * H^8 ^ C1 * H^7 ^ ... ^ C7 * H */
+   for (; blocks >= 8; blocks -= 8) {
+      lo = mid = hi = _mm_setzero_si128();
+      X = _mm_xor_si128(X, _bswap(_mm_loadu_si128((const __m128i*)(const void*)in)));
+      _clmul_acc(X, H[7], &lo, &mid, &hi);
+      for (i = 1; i < 8; i++) {
+         _clmul_acc(_bswap(_mm_loadu_si128((const __m128i*)(const void*)(in + 16 * i))), H[7 - i], &lo, &mid, &hi);
+      }
+      X = _reduce(lo, mid, hi);
+      in += 128;
+   }
+   for (; blocks > 0; blocks--) {
+      X = _mm_xor_si128(X, _bswap(_mm_loadu_si128((const __m128i*)(const void*)in)));
+      X = _gfmul(X, H[0]);
+      in += 16;
+   }
+
+   _mm_storeu_si128((__m128i*)(void*)gcm->X, _bswap(X));
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
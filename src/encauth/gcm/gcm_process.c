@@ -15,6 +15,78 @@
 
 #ifdef LTC_GCM_MODE
 
+/* the number of blocks that are encrypted and GHASHed in one go */
+#define GCM_PAR 32
+
+static void _gcm_xor(const unsigned char *in, const unsigned char *ks, unsigned char *out, unsigned long len)
+{
+   unsigned long x;
+#ifdef LTC_FAST
+   for (x = 0; x < len; x += sizeof(LTC_FAST_TYPE)) {
+       *(LTC_FAST_TYPE_PTR_CAST(&out[x])) = *(LTC_FAST_TYPE_PTR_CAST(&in[x])) ^ *(LTC_FAST_TYPE_PTR_CAST(&ks[x]));
+   }
+#else
+   for (x = 0; x < len; x++) {
+       out[x] = in[x] ^ ks[x];
+   }
+#endif
+}
+
+/*
+  CTR encrypt whole blocks with the counters Y+1, Y+2, ..., several blocks at a time
+  through the accelerators of the cipher if it has some.  Y is left at the last counter used.
+ */
+static int _gcm_ctr(gcm_state *gcm, const unsigned char *in, unsigned char *out, unsigned long blocks)
+{
+   unsigned char ks[16 * GCM_PAR];
+   unsigned long n, i;
+   ulong32       ctr;
+   int           err = CRYPT_OK;
+
+   while (blocks > 0) {
+      n = MIN(blocks, GCM_PAR);
+      LOAD32H(ctr, gcm->Y + 12);
+#ifdef LTC_CTR_MODE
+      /* the accelerator increments the whole block, GCM only the last 32 bits */
+      if (cipher_descriptor[gcm->cipher].accel_ctr_encrypt != NULL && 0xFFFFFFFFUL - ctr >= n) {
+         if ((err = cipher_descriptor[gcm->cipher].accel_ctr_encrypt(in, out, n, gcm->Y, CTR_COUNTER_BIG_ENDIAN, &gcm->K)) != CRYPT_OK) {
+            goto done;
+         }
+         in     += 16 * n;
+         out    += 16 * n;
+         blocks -= n;
+         continue;
+      }
+#endif
+      for (i = 0; i < n; i++) {
+         ctr = (ctr + 1) & 0xFFFFFFFFUL;
+         STORE32H(ctr, gcm->Y + 12);
+         XMEMCPY(ks + 16 * i, gcm->Y, 16);
+      }
+      if (cipher_descriptor[gcm->cipher].accel_ecb_encrypt != NULL) {
+         if ((err = cipher_descriptor[gcm->cipher].accel_ecb_encrypt(ks, ks, n, &gcm->K)) != CRYPT_OK) {
+            goto done;
+         }
+      } else {
+         for (i = 0; i < n; i++) {
+            if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(ks + 16 * i, ks + 16 * i, &gcm->K)) != CRYPT_OK) {
+               goto done;
+            }
+         }
+      }
+      _gcm_xor(in, ks, out, 16 * n);
+      in     += 16 * n;
+      out    += 16 * n;
+      blocks -= n;
+   }
+
+done:
+#ifdef LTC_CLEAN_STACK
+   zeromem(ks, sizeof(ks));
+#endif
+   return err;
+}
+
 /**
   Process plaintext/ciphertext through GCM
   @param gcm       The GCM state
@@ -29,9 +101,11 @@ int gcm_process(gcm_state *gcm,
                      unsigned char *ct,
                      int direction)
 {
-   unsigned long x;
+   unsigned long x, z;
    int           y, err;
    unsigned char b;
+   const unsigned char *in;
+   unsigned char *out;
 
    LTC_ARGCHK(gcm != NULL);
    if (ptlen > 0) {
@@ -78,47 +152,40 @@ int gcm_process(gcm_state *gcm,
    }
 
    x = 0;
-#ifdef LTC_FAST
    if (gcm->buflen == 0) {
-      if (direction == GCM_ENCRYPT) {
-         for (x = 0; x < (ptlen & ~15); x += 16) {
-             /* ctr encrypt */
-             for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-                 *(LTC_FAST_TYPE_PTR_CAST(&ct[x + y])) = *(LTC_FAST_TYPE_PTR_CAST(&pt[x+y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&gcm->buf[y]));
-                 *(LTC_FAST_TYPE_PTR_CAST(&gcm->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&ct[x+y]));
-             }
-             /* GMAC it */
-             gcm->pttotlen += 128;
-             gcm_mult_h(gcm, gcm->X);
-             /* increment counter */
-             for (y = 15; y >= 12; y--) {
-                 if (++gcm->Y[y] & 255) { break; }
-             }
-             if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(gcm->Y, gcm->buf, &gcm->K)) != CRYPT_OK) {
-                return err;
-             }
+      in  = (direction == GCM_ENCRYPT) ? pt : ct;
+      out = (direction == GCM_ENCRYPT) ? ct : pt;
+      for (x = 0; x < (ptlen & ~15UL); x += z) {
+          z = MIN((ptlen & ~15UL) - x, 16 * GCM_PAR);
+          /* GMAC the ciphertext, before it gets overwritten when decrypting in place */
+          if (direction != GCM_ENCRYPT) {
+             gcm_ghash(gcm, ct + x, z >> 4);
+          }
+          if (x == 0) {
+             /* the counter of the first block has already been encrypted */
+             _gcm_xor(in, gcm->buf, out, 16);
+             err = _gcm_ctr(gcm, in + 16, out + 16, (z >> 4) - 1);
+          } else {
+             err = _gcm_ctr(gcm, in + x, out + x, z >> 4);
+          }
+          if (err != CRYPT_OK) {
+             return err;
+          }
+          if (direction == GCM_ENCRYPT) {
+             gcm_ghash(gcm, ct + x, z >> 4);
+          }
+          gcm->pttotlen += z * CONST64(8);
+      }
+      if (x > 0) {
+         /* increment counter */
+         for (y = 15; y >= 12; y--) {
+             if (++gcm->Y[y] & 255) { break; }
          }
-      } else {
-         for (x = 0; x < (ptlen & ~15); x += 16) {
-             /* ctr encrypt */
-             for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-                 *(LTC_FAST_TYPE_PTR_CAST(&gcm->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&ct[x+y]));
-                 *(LTC_FAST_TYPE_PTR_CAST(&pt[x + y])) = *(LTC_FAST_TYPE_PTR_CAST(&ct[x+y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&gcm->buf[y]));
-             }
-             /* GMAC it */
-             gcm->pttotlen += 128;
-             gcm_mult_h(gcm, gcm->X);
-             /* increment counter */
-             for (y = 15; y >= 12; y--) {
-                 if (++gcm->Y[y] & 255) { break; }
-             }
-             if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(gcm->Y, gcm->buf, &gcm->K)) != CRYPT_OK) {
-                return err;
-             }
+         if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(gcm->Y, gcm->buf, &gcm->K)) != CRYPT_OK) {
+            return err;
          }
       }
    }
-#endif
 
    /* process text */
    for (; x < ptlen; x++) {
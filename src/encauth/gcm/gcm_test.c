@@ -322,9 +322,27 @@ int gcm_test(void)
 
 /* rest of test cases are the same except AES key size changes... ignored... */
 };
-   int           idx, err;
+   /* 200 bytes of AAD and 1000 bytes of text, long enough for the aggregated GHASH,
+    * the counter of the 16 byte IV wraps from 0xFFFFFFFF to 0 in the middle of the text */
+   static const struct {
+       unsigned char IV[16];
+       unsigned long IVlen;
+       unsigned char C[16];                        /* the last 16 bytes of the ciphertext */
+       unsigned char T[16];
+   } long_tests[] = {
+   { { 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb }, 12,
+     { 0x6b, 0xbb, 0x83, 0xe2, 0x7a, 0x62, 0x41, 0xcf, 0x82, 0x0b, 0x64, 0x56, 0xf0, 0x93, 0x5e, 0x6a },
+     { 0xdf, 0xb4, 0xe4, 0x41, 0xb4, 0x5b, 0xc0, 0x65, 0x86, 0xd5, 0xe4, 0x23, 0x12, 0x3d, 0xed, 0x21 } },
+   { { 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xa5, 0xeb, 0xdf, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 16,
+     { 0xd6, 0x0d, 0x80, 0xb5, 0x50, 0x03, 0x36, 0x73, 0x69, 0x3f, 0x82, 0xca, 0x19, 0x74, 0x3e, 0x2b },
+     { 0xf0, 0xb2, 0xf0, 0x09, 0xa6, 0x6e, 0x15, 0x37, 0xd5, 0x66, 0xf0, 0x58, 0x92, 0xec, 0x50, 0x2c } },
+   };
+   static const unsigned long long_split[3] = { 144, 5, 851 };
+   int           idx, err, i;
    unsigned long x, y;
    unsigned char out[2][128], T[2][16];
+   unsigned char *buf, *K, *A, *P, *C;
+   gcm_state     *gcm;
 
    /* find aes */
    idx = find_cipher("aes");
@@ -371,7 +389,56 @@ int gcm_test(void)
        }
 
    }
-   return CRYPT_OK;
+
+   buf = XMALLOC(16 + 200 + 1000 + 1000);
+   gcm = XMALLOC(sizeof(*gcm));
+   if (buf == NULL || gcm == NULL) {
+      if (buf != NULL) XFREE(buf);
+      if (gcm != NULL) XFREE(gcm);
+      return CRYPT_MEM;
+   }
+   K  = buf;
+   A  = K + 16;
+   P  = A + 200;
+   C  = P + 1000;
+   for (x = 0; x < 16; x++)   K[x]  = (unsigned char)x;
+   for (x = 0; x < 200; x++)  A[x]  = (unsigned char)(x * 7);
+   for (x = 0; x < 1000; x++) P[x]  = (unsigned char)(x * 13 + 5);
+
+   for (i = 0; i < (int)(sizeof(long_tests)/sizeof(long_tests[0])); i++) {
+      y = sizeof(T[0]);
+      if ((err = gcm_memory(idx, K, 16, long_tests[i].IV, long_tests[i].IVlen, A, 200, P, 1000, C, T[0], &y, GCM_ENCRYPT)) != CRYPT_OK) {
+         goto done;
+      }
+      if (compare_testvector(C + 1000 - 16, 16, long_tests[i].C, 16, "GCM long CT", i) ||
+          compare_testvector(T[0], y, long_tests[i].T, 16, "GCM long Encrypt Tag", i)) {
+         err = CRYPT_FAIL_TESTVECTOR;
+         goto done;
+      }
+
+      /* decrypt in place, with the text split across partial blocks */
+      if ((err = gcm_init(gcm, idx, K, 16)) != CRYPT_OK)                                      goto done;
+      if ((err = gcm_add_iv(gcm, long_tests[i].IV, long_tests[i].IVlen)) != CRYPT_OK)        goto done;
+      if ((err = gcm_add_aad(gcm, A, 200)) != CRYPT_OK)                                       goto done;
+      for (x = y = 0; x < 3; y += long_split[x++]) {
+         if ((err = gcm_process(gcm, C + y, long_split[x], C + y, GCM_DECRYPT)) != CRYPT_OK) {
+            goto done;
+         }
+      }
+      y = sizeof(T[1]);
+      if ((err = gcm_done(gcm, T[1], &y)) != CRYPT_OK)                                        goto done;
+      if (compare_testvector(C, 1000, P, 1000, "GCM long PT", i) ||
+          compare_testvector(T[1], y, long_tests[i].T, 16, "GCM long Decrypt Tag", i)) {
+         err = CRYPT_FAIL_TESTVECTOR;
+         goto done;
+      }
+   }
+   err = CRYPT_OK;
+
+done:
+   XFREE(gcm);
+   XFREE(buf);
+   return err;
 #endif
 }
 
@@ -24,7 +24,7 @@
 */
 int ocb3_add_aad(ocb3_state *ocb, const unsigned char *aad, unsigned long aadlen)
 {
-   int err, x, full_blocks, full_blocks_len, last_block_len;
+   int err, full_blocks, full_blocks_len, last_block_len;
    unsigned char *data;
    unsigned long datalen, l;
 
@@ -40,7 +40,7 @@ int ocb3_add_aad(ocb3_state *ocb, const unsigned char *aad, unsigned long aadlen
      ocb->adata_buffer_bytes += l;
 
      if (ocb->adata_buffer_bytes == ocb->block_len) {
-       if ((err = ocb3_int_aad_add_block(ocb, ocb->adata_buffer)) != CRYPT_OK) {
+       if ((err = ocb3_int_aad_add_blocks(ocb, ocb->adata_buffer, 1)) != CRYPT_OK) {
          return err;
        }
        ocb->adata_buffer_bytes = 0;
@@ -60,8 +60,8 @@ int ocb3_add_aad(ocb3_state *ocb, const unsigned char *aad, unsigned long aadlen
    full_blocks_len = full_blocks * ocb->block_len;
    last_block_len = datalen - full_blocks_len;
 
-   for (x=0; x<full_blocks; x++) {
-     if ((err = ocb3_int_aad_add_block(ocb, data+x*ocb->block_len)) != CRYPT_OK) {
+   if (full_blocks > 0) {
+     if ((err = ocb3_int_aad_add_blocks(ocb, data, full_blocks)) != CRYPT_OK) {
        return err;
      }
    }
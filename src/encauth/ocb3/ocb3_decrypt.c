@@ -25,9 +25,9 @@
 */
 int ocb3_decrypt(ocb3_state *ocb, const unsigned char *ct, unsigned long ctlen, unsigned char *pt)
 {
-   unsigned char tmp[MAXBLOCKSIZE];
-   int err, i, full_blocks;
-   unsigned char *pt_b, *ct_b;
+   unsigned char tmp[OCB3_BATCH], offsets[OCB3_BATCH];
+   unsigned long x, n, bl;
+   int err;
 
    LTC_ARGCHK(ocb != NULL);
    LTC_ARGCHK(pt  != NULL);
@@ -43,29 +43,27 @@ int ocb3_decrypt(ocb3_state *ocb, const unsigned char *ct, unsigned long ctlen,
       return CRYPT_INVALID_ARG;
    }
 
-   full_blocks = ctlen/ocb->block_len;
-   for(i=0; i<full_blocks; i++) {
-     pt_b = (unsigned char *)pt+i*ocb->block_len;
-     ct_b = (unsigned char *)ct+i*ocb->block_len;
+   bl = ocb->block_len;
+   while (ctlen > 0) {
+     n = MIN(ctlen, OCB3_BATCH - OCB3_BATCH % bl) / bl;
 
-     /* ocb->Offset_current[] = ocb->Offset_current[] ^ Offset_{ntz(block_index)} */
-     ocb3_int_xor_blocks(ocb->Offset_current, ocb->Offset_current, ocb->L_[ocb3_int_ntz(ocb->block_index)], ocb->block_len);
-
-     /* tmp[] = ct[] XOR ocb->Offset_current[] */
-     ocb3_int_xor_blocks(tmp, ct_b, ocb->Offset_current, ocb->block_len);
-
-     /* decrypt */
-     if ((err = cipher_descriptor[ocb->cipher].ecb_decrypt(tmp, tmp, &ocb->key)) != CRYPT_OK) {
+     /* tmp[] = DECIPHER(K, ct[] XOR Offset_i) for the next n blocks */
+     if ((err = ocb3_int_crypt_blocks(ocb, ocb->Offset_current, &ocb->block_index,
+                                      ct, tmp, offsets, n, 0)) != CRYPT_OK) {
         goto LBL_ERR;
      }
 
-     /* pt[] = tmp[] XOR ocb->Offset_current[] */
-     ocb3_int_xor_blocks(pt_b, tmp, ocb->Offset_current, ocb->block_len);
+     /* pt[] = tmp[] XOR Offset_i */
+     ocb3_int_xor_blocks(pt, tmp, offsets, n * bl);
 
      /* ocb->checksum[] = ocb->checksum[] XOR pt[] */
-     ocb3_int_xor_blocks(ocb->checksum, ocb->checksum, pt_b, ocb->block_len);
+     for (x = 0; x < n; x++) {
+        ocb3_int_xor_blocks(ocb->checksum, ocb->checksum, pt + x * bl, bl);
+     }
 
-     ocb->block_index++;
+     pt    += n * bl;
+     ct    += n * bl;
+     ctlen -= n * bl;
    }
 
    err = CRYPT_OK;
@@ -73,6 +71,7 @@ int ocb3_decrypt(ocb3_state *ocb, const unsigned char *ct, unsigned long ctlen,
 LBL_ERR:
 #ifdef LTC_CLEAN_STACK
    zeromem(tmp, sizeof(tmp));
+   zeromem(offsets, sizeof(offsets));
 #endif
    return err;
 }
@@ -25,9 +25,9 @@
 */
 int ocb3_encrypt(ocb3_state *ocb, const unsigned char *pt, unsigned long ptlen, unsigned char *ct)
 {
-   unsigned char tmp[MAXBLOCKSIZE];
-   int err, i, full_blocks;
-   unsigned char *pt_b, *ct_b;
+   unsigned char tmp[OCB3_BATCH], offsets[OCB3_BATCH];
+   unsigned long x, n, bl;
+   int err;
 
    LTC_ARGCHK(ocb != NULL);
    LTC_ARGCHK(pt  != NULL);
@@ -43,29 +43,27 @@ int ocb3_encrypt(ocb3_state *ocb, const unsigned char *pt, unsigned long ptlen,
       return CRYPT_INVALID_ARG;
    }
 
-   full_blocks = ptlen/ocb->block_len;
-   for(i=0; i<full_blocks; i++) {
-     pt_b = (unsigned char *)pt+i*ocb->block_len;
-     ct_b = (unsigned char *)ct+i*ocb->block_len;
+   bl = ocb->block_len;
+   while (ptlen > 0) {
+     n = MIN(ptlen, OCB3_BATCH - OCB3_BATCH % bl) / bl;
 
-     /* ocb->Offset_current[] = ocb->Offset_current[] ^ Offset_{ntz(block_index)} */
-     ocb3_int_xor_blocks(ocb->Offset_current, ocb->Offset_current, ocb->L_[ocb3_int_ntz(ocb->block_index)], ocb->block_len);
-
-     /* tmp[] = pt[] XOR ocb->Offset_current[] */
-     ocb3_int_xor_blocks(tmp, pt_b, ocb->Offset_current, ocb->block_len);
-
-     /* encrypt */
-     if ((err = cipher_descriptor[ocb->cipher].ecb_encrypt(tmp, tmp, &ocb->key)) != CRYPT_OK) {
+     /* tmp[] = ENCIPHER(K, pt[] XOR Offset_i) for the next n blocks */
+     if ((err = ocb3_int_crypt_blocks(ocb, ocb->Offset_current, &ocb->block_index,
+                                      pt, tmp, offsets, n, 1)) != CRYPT_OK) {
         goto LBL_ERR;
      }
 
-     /* ct[] = tmp[] XOR ocb->Offset_current[] */
-     ocb3_int_xor_blocks(ct_b, tmp, ocb->Offset_current, ocb->block_len);
+     /* ocb->checksum[] = ocb->checksum[] XOR pt[], before ct[] overwrites it */
+     for (x = 0; x < n; x++) {
+        ocb3_int_xor_blocks(ocb->checksum, ocb->checksum, pt + x * bl, bl);
+     }
 
-     /* ocb->checksum[] = ocb->checksum[] XOR pt[] */
-     ocb3_int_xor_blocks(ocb->checksum, ocb->checksum, pt_b, ocb->block_len);
+     /* ct[] = tmp[] XOR Offset_i */
+     ocb3_int_xor_blocks(ct, tmp, offsets, n * bl);
 
-     ocb->block_index++;
+     pt    += n * bl;
+     ct    += n * bl;
+     ptlen -= n * bl;
    }
 
    err = CRYPT_OK;
@@ -73,6 +71,7 @@ int ocb3_encrypt(ocb3_state *ocb, const unsigned char *pt, unsigned long ptlen,
 LBL_ERR:
 #ifdef LTC_CLEAN_STACK
    zeromem(tmp, sizeof(tmp));
+   zeromem(offsets, sizeof(offsets));
 #endif
    return err;
 }
@@ -0,0 +1,64 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+   @file ocb3_int_aad_add_blocks.c
+   OCB implementation, INTERNALL ONLY helper, by Karel Miko
+*/
+#include "tomcrypt.h"
+
+#ifdef LTC_OCB3_MODE
+/**
+   Add full blocks of AAD data (internal function)
+   @param ocb        The OCB state
+   @param aad        [in] AAD data (blocks * block_len size)
+   @param blocks     The number of blocks
+   @return CRYPT_OK if successful
+*/
+int ocb3_int_aad_add_blocks(ocb3_state *ocb, const unsigned char *aad, unsigned long blocks)
+{
+   unsigned char tmp[OCB3_BATCH], offsets[OCB3_BATCH];
+   unsigned long x, n, bl;
+   int err;
+
+   bl = ocb->block_len;
+   while (blocks > 0) {
+      n = MIN(blocks, OCB3_BATCH / bl);
+
+      /* tmp_i = ENCIPHER(K, A_i xor Offset_i) */
+      if ((err = ocb3_int_crypt_blocks(ocb, ocb->aOffset_current, &ocb->ablock_index,
+                                       aad, tmp, offsets, n, 1)) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+
+      /* Sum_i = Sum_{i-1} xor tmp_i */
+      for (x = 0; x < n; x++) {
+         ocb3_int_xor_blocks(ocb->aSum_current, ocb->aSum_current, tmp + x * bl, bl);
+      }
+
+      aad    += n * bl;
+      blocks -= n;
+   }
+   err = CRYPT_OK;
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(tmp, sizeof(tmp));
+   zeromem(offsets, sizeof(offsets));
+#endif
+   return err;
+}
+
+
+#endif
+
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -0,0 +1,75 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+   @file ocb3_int_crypt_blocks.c
+   OCB implementation, INTERNAL ONLY helper
+*/
+#include "tomcrypt.h"
+
+#ifdef LTC_OCB3_MODE
+
+/**
+   Encrypt or decrypt a run of blocks xor their offsets (internal function)
+   out_i = CIPHER(K, in_i xor Offset_i), Offset_i = Offset_{i-1} xor L_{ntz(i)}
+   @param ocb      The OCB state
+   @param offset   [in/out] Offset_{i-1} of the first block, on return Offset_i of the last block
+   @param index    [in/out] The index of the first block, on return the index after the last block
+   @param in       The input blocks
+   @param out      [out] The output blocks (blocks * block_len octets)
+   @param offsets  [out] The offsets of the blocks (blocks * block_len octets)
+   @param blocks   The number of blocks
+   @param enc      1 to encrypt, 0 to decrypt
+   @return CRYPT_OK if successful
+*/
+int ocb3_int_crypt_blocks(ocb3_state *ocb, unsigned char *offset, unsigned long *index,
+                          const unsigned char *in, unsigned char *out, unsigned char *offsets,
+                          unsigned long blocks, int enc)
+{
+   unsigned long x, bl;
+   int err;
+
+   bl = ocb->block_len;
+
+   /* the offsets only depend on the index, compute the whole run first */
+   for (x = 0; x < blocks; x++) {
+      ocb3_int_xor_blocks(offset, offset, ocb->L_[ocb3_int_ntz(*index)], bl);
+      XMEMCPY(offsets + x * bl, offset, bl);
+      (*index)++;
+   }
+   ocb3_int_xor_blocks(out, in, offsets, blocks * bl);
+
+   /* then all blocks in one call of the accelerator if there is one */
+   if (enc) {
+      if (cipher_descriptor[ocb->cipher].accel_ecb_encrypt != NULL) {
+         return cipher_descriptor[ocb->cipher].accel_ecb_encrypt(out, out, blocks, &ocb->key);
+      }
+      for (x = 0; x < blocks; x++) {
+         if ((err = cipher_descriptor[ocb->cipher].ecb_encrypt(out + x * bl, out + x * bl, &ocb->key)) != CRYPT_OK) {
+            return err;
+         }
+      }
+   } else {
+      if (cipher_descriptor[ocb->cipher].accel_ecb_decrypt != NULL) {
+         return cipher_descriptor[ocb->cipher].accel_ecb_decrypt(out, out, blocks, &ocb->key);
+      }
+      for (x = 0; x < blocks; x++) {
+         if ((err = cipher_descriptor[ocb->cipher].ecb_decrypt(out + x * bl, out + x * bl, &ocb->key)) != CRYPT_OK) {
+            return err;
+         }
+      }
+   }
+   return CRYPT_OK;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
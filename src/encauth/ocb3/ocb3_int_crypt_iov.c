@@ -0,0 +1,69 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+   @file ocb3_int_crypt_iov.c
+   OCB implementation, INTERNAL ONLY helper
+*/
+#include "tomcrypt.h"
+
+#ifdef LTC_OCB3_MODE
+
+typedef struct {
+   ocb3_state *ocb;
+   int         enc, last;
+} _ocb3_iov;
+
+/* full blocks go to ocb3_encrypt() resp. ocb3_decrypt(), a final partial block to the *_last() function */
+static int _ocb3_iov_process(void *state, const unsigned char *in, unsigned char *out, unsigned long len)
+{
+   _ocb3_iov *s = state;
+
+   if (len % s->ocb->block_len == 0) {
+      return s->enc ? ocb3_encrypt(s->ocb, in, len, out) : ocb3_decrypt(s->ocb, in, len, out);
+   }
+   s->last = 1;
+   return s->enc ? ocb3_encrypt_last(s->ocb, in, len, out) : ocb3_decrypt_last(s->ocb, in, len, out);
+}
+
+/**
+   Encrypt or decrypt all the data of an OCB3 message given as scatter/gather lists
+   @param ocb     The OCB state
+   @param in      The input segments
+   @param incnt   The number of input segments
+   @param out     [out] The output segments
+   @param outcnt  The number of output segments
+   @param enc     1 to encrypt, 0 to decrypt
+   @return CRYPT_OK if successful
+*/
+int ocb3_int_crypt_iov(ocb3_state *ocb, const ltc_iovec *in, unsigned long incnt,
+                       const ltc_iovec *out, unsigned long outcnt, int enc)
+{
+   unsigned char dummy = 0;
+   _ocb3_iov s;
+   int err;
+
+   s.ocb  = ocb;
+   s.enc  = enc;
+   s.last = 0;
+   if ((err = crypt_iov_process(in, incnt, out, outcnt, (unsigned long)ocb->block_len, _ocb3_iov_process, &s)) != CRYPT_OK) {
+      return err;
+   }
+   if (s.last) {
+      return CRYPT_OK;
+   }
+   /* the length was a multiple of the block size, finish with an empty last block */
+   return enc ? ocb3_encrypt_last(ocb, &dummy, 0, &dummy) : ocb3_decrypt_last(ocb, &dummy, 0, &dummy);
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -206,6 +206,22 @@ int ocb3_test(void)
 #endif
            return CRYPT_FAIL_TESTVECTOR;
         }
+
+        /* in place, the checksum has to be taken over the plaintext */
+        XMEMCPY(outct, tests[x].pt, tests[x].ptlen);
+        len = sizeof(outtag);
+        if ((err = ocb3_encrypt_authenticate_memory(idx,
+                                                   key, sizeof(key),
+                                                   nonce, sizeof(nonce),
+                                                   tests[x].aad, tests[x].aadlen,
+                                                   outct, tests[x].ptlen,
+                                                   outct, outtag, &len)) != CRYPT_OK) {
+           return err;
+        }
+        if (compare_testvector(outtag, len, tests[x].tag, sizeof(tests[x].tag), "OCB3 in place Tag", x) ||
+              compare_testvector(outct, tests[x].ptlen, tests[x].ct, tests[x].ptlen, "OCB3 in place CT", x)) {
+           return CRYPT_FAIL_TESTVECTOR;
+        }
     }
     return CRYPT_OK;
 #endif /* LTC_TEST */
@@ -0,0 +1,238 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file blake2_simd.c
+  BLAKE2b compression with AVX2 and BLAKE2s compression with SSSE3
+
+  Each row of the 4x4 working matrix is one vector register, so the four G functions of a
+  column step run at once.  For the diagonal step rows b, c and d are rotated by one, two
+  and three words, and rotated back afterwards.  Rotations by whole bytes use PSHUFB.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_BLAKE2_SIMD
+
+/* see chacha_simd.c */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+/* the message words of the column step (i = 0) or diagonal step (i = 1) of round r,
+ * the first (j = 0) or second (j = 1) half of G */
+#define MSG_IDX(r, i, j, k)   blake2_sigma[r][8 * (i) + 2 * (k) + (j)]
+
+static const unsigned char blake2_sigma[12][16] =
+{
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 } ,
+  { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 } ,
+  { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 } ,
+  {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 } ,
+  {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 } ,
+  {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 } ,
+  { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 } ,
+  { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 } ,
+  {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 } ,
+  { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13 , 0 } ,
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 } ,
+  { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }
+};
+
+#ifdef LTC_BLAKE2B
+
+static const ulong64 blake2b_IV[8] =
+{
+  CONST64(0x6a09e667f3bcc908), CONST64(0xbb67ae8584caa73b),
+  CONST64(0x3c6ef372fe94f82b), CONST64(0xa54ff53a5f1d36f1),
+  CONST64(0x510e527fade682d1), CONST64(0x9b05688c2b3e6c1f),
+  CONST64(0x1f83d9abfb41bd6b), CONST64(0x5be0cd19137e2179)
+};
+
+#define B2B_MSG(r, i, j) _mm256_set_epi64x((long long)m[MSG_IDX(r, i, j, 3)], (long long)m[MSG_IDX(r, i, j, 2)], \
+                                           (long long)m[MSG_IDX(r, i, j, 1)], (long long)m[MSG_IDX(r, i, j, 0)])
+
+#define B2B_ROR63(x)     _mm256_xor_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x))
+
+#define B2B_G(r, i)                                                                         \
+   a = _mm256_add_epi64(_mm256_add_epi64(a, b), B2B_MSG(r, i, 0));                          \
+   d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), _MM_SHUFFLE(2, 3, 0, 1));               \
+   c = _mm256_add_epi64(c, d);                                                              \
+   b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), rot24);                                  \
+   a = _mm256_add_epi64(_mm256_add_epi64(a, b), B2B_MSG(r, i, 1));                          \
+   d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);                                  \
+   c = _mm256_add_epi64(c, d);                                                              \
+   b = B2B_ROR63(_mm256_xor_si256(b, c));
+
+#define B2B_ROUND(r)                                                                        \
+   B2B_G(r, 0)                                                                              \
+   b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));                                \
+   c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));                                \
+   d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3));                                \
+   B2B_G(r, 1)                                                                              \
+   b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3));                                \
+   c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));                                \
+   d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
+
+/**
+  Check whether the CPU supports AVX2
+  @return 1 if blake2b_simd_compress() can be used, 0 otherwise
+*/
+int blake2b_simd_is_supported(void)
+{
+   return (crypt_cpu_features() & LTC_CPU_AVX2) != 0;
+}
+
+/**
+  Compress one block with BLAKE2b
+  @param md    The hash state, with the counter and the final block flags already set
+  @param buf   The 128 byte block
+  @return CRYPT_OK
+*/
+LTC_TARGET("avx2")
+int blake2b_simd_compress(hash_state *md, const unsigned char *buf)
+{
+   const __m256i rot24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                          3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+   const __m256i rot16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                          2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+   __m256i a, b, c, d, h0, h1;
+   ulong64 m[16];
+
+   /* x86 is little endian */
+   XMEMCPY(m, buf, sizeof(m));
+
+   h0 = _mm256_loadu_si256((const __m256i*)(const void*)md->blake2b.h);
+   h1 = _mm256_loadu_si256((const __m256i*)(const void*)(md->blake2b.h + 4));
+   a = h0;
+   b = h1;
+   c = _mm256_loadu_si256((const __m256i*)(const void*)blake2b_IV);
+   d = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(const void*)(blake2b_IV + 4)),
+                        _mm256_set_epi64x((long long)md->blake2b.f[1], (long long)md->blake2b.f[0],
+                                          (long long)md->blake2b.t[1], (long long)md->blake2b.t[0]));
+
+   B2B_ROUND(0)
+   B2B_ROUND(1)
+   B2B_ROUND(2)
+   B2B_ROUND(3)
+   B2B_ROUND(4)
+   B2B_ROUND(5)
+   B2B_ROUND(6)
+   B2B_ROUND(7)
+   B2B_ROUND(8)
+   B2B_ROUND(9)
+   B2B_ROUND(10)
+   B2B_ROUND(11)
+
+   _mm256_storeu_si256((__m256i*)(void*)md->blake2b.h, _mm256_xor_si256(h0, _mm256_xor_si256(a, c)));
+   _mm256_storeu_si256((__m256i*)(void*)(md->blake2b.h + 4), _mm256_xor_si256(h1, _mm256_xor_si256(b, d)));
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(m, sizeof(m));
+#endif
+   return CRYPT_OK;
+}
+
+#endif /* LTC_BLAKE2B */
+
+#ifdef LTC_BLAKE2S
+
+static const ulong32 blake2s_IV[8] = {
+   0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+   0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+#define B2S_MSG(r, i, j) _mm_set_epi32((int)m[MSG_IDX(r, i, j, 3)], (int)m[MSG_IDX(r, i, j, 2)], \
+                                       (int)m[MSG_IDX(r, i, j, 1)], (int)m[MSG_IDX(r, i, j, 0)])
+
+#define B2S_ROR(x, n)    _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - (n)))
+
+#define B2S_G(r, i)                                                                         \
+   a = _mm_add_epi32(_mm_add_epi32(a, b), B2S_MSG(r, i, 0));                                \
+   d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rot16);                                        \
+   c = _mm_add_epi32(c, d);                                                                 \
+   b = B2S_ROR(_mm_xor_si128(b, c), 12);                                                    \
+   a = _mm_add_epi32(_mm_add_epi32(a, b), B2S_MSG(r, i, 1));                                \
+   d = _mm_shuffle_epi8(_mm_xor_si128(d, a), rot8);                                         \
+   c = _mm_add_epi32(c, d);                                                                 \
+   b = B2S_ROR(_mm_xor_si128(b, c), 7);
+
+#define B2S_ROUND(r)                                                                        \
+   B2S_G(r, 0)                                                                              \
+   b = _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1));                                       \
+   c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));                                       \
+   d = _mm_shuffle_epi32(d, _MM_SHUFFLE(2, 1, 0, 3));                                       \
+   B2S_G(r, 1)                                                                              \
+   b = _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3));                                       \
+   c = _mm_shuffle_epi32(c, _MM_SHUFFLE(1, 0, 3, 2));                                       \
+   d = _mm_shuffle_epi32(d, _MM_SHUFFLE(0, 3, 2, 1));
+
+/**
+  Check whether the CPU supports SSSE3
+  @return 1 if blake2s_simd_compress() can be used, 0 otherwise
+*/
+int blake2s_simd_is_supported(void)
+{
+   return (crypt_cpu_features() & LTC_CPU_SSSE3) != 0;
+}
+
+/**
+  Compress one block with BLAKE2s
+  @param md    The hash state, with the counter and the final block flags already set
+  @param buf   The 64 byte block
+  @return CRYPT_OK
+*/
+LTC_TARGET("ssse3")
+int blake2s_simd_compress(hash_state *md, const unsigned char *buf)
+{
+   const __m128i rot16 = _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+   const __m128i rot8  = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+   __m128i a, b, c, d, h0, h1;
+   ulong32 m[16];
+
+   /* x86 is little endian */
+   XMEMCPY(m, buf, sizeof(m));
+
+   h0 = _mm_loadu_si128((const __m128i*)(const void*)md->blake2s.h);
+   h1 = _mm_loadu_si128((const __m128i*)(const void*)(md->blake2s.h + 4));
+   a = h0;
+   b = h1;
+   c = _mm_loadu_si128((const __m128i*)(const void*)blake2s_IV);
+   d = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(const void*)(blake2s_IV + 4)),
+                     _mm_set_epi32((int)md->blake2s.f[1], (int)md->blake2s.f[0],
+                                   (int)md->blake2s.t[1], (int)md->blake2s.t[0]));
+
+   B2S_ROUND(0)
+   B2S_ROUND(1)
+   B2S_ROUND(2)
+   B2S_ROUND(3)
+   B2S_ROUND(4)
+   B2S_ROUND(5)
+   B2S_ROUND(6)
+   B2S_ROUND(7)
+   B2S_ROUND(8)
+   B2S_ROUND(9)
+
+   _mm_storeu_si128((__m128i*)(void*)md->blake2s.h, _mm_xor_si128(h0, _mm_xor_si128(a, c)));
+   _mm_storeu_si128((__m128i*)(void*)(md->blake2s.h + 4), _mm_xor_si128(h1, _mm_xor_si128(b, d)));
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(m, sizeof(m));
+#endif
+   return CRYPT_OK;
+}
+
+#endif /* LTC_BLAKE2S */
+
+#endif /* LTC_BLAKE2_SIMD */
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
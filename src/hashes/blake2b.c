@@ -81,7 +81,10 @@ const struct ltc_hash_descriptor blake2b_160_desc =
     &blake2b_process,
     &blake2b_done,
     &blake2b_160_test,
-    NULL
+    NULL,
+    &blake2b_clone,
+    &blake2b_160_export_state,
+    &blake2b_160_import_state
 };
 
 const struct ltc_hash_descriptor blake2b_256_desc =
@@ -96,7 +99,10 @@ const struct ltc_hash_descriptor blake2b_256_desc =
     &blake2b_process,
     &blake2b_done,
     &blake2b_256_test,
-    NULL
+    NULL,
+    &blake2b_clone,
+    &blake2b_256_export_state,
+    &blake2b_256_import_state
 };
 
 const struct ltc_hash_descriptor blake2b_384_desc =
@@ -111,7 +117,10 @@ const struct ltc_hash_descriptor blake2b_384_desc =
     &blake2b_process,
     &blake2b_done,
     &blake2b_384_test,
-    NULL
+    NULL,
+    &blake2b_clone,
+    &blake2b_384_export_state,
+    &blake2b_384_import_state
 };
 
 const struct ltc_hash_descriptor blake2b_512_desc =
@@ -126,7 +135,10 @@ const struct ltc_hash_descriptor blake2b_512_desc =
     &blake2b_process,
     &blake2b_done,
     &blake2b_512_test,
-    NULL
+    NULL,
+    &blake2b_clone,
+    &blake2b_512_export_state,
+    &blake2b_512_import_state
 };
 
 static const ulong64 blake2b_IV[8] =
@@ -279,6 +291,12 @@ static int blake2b_compress(hash_state *md, const unsigned char *buf)
    ulong64 v[16];
    unsigned long i;
 
+#ifdef LTC_BLAKE2_SIMD
+   if (blake2b_simd_is_supported()) {
+      return blake2b_simd_compress(md, buf);
+   }
+#endif
+
    for (i = 0; i < 16; ++i) {
       LOAD64L(m[i], buf + i * sizeof(m[i]));
    }
@@ -389,6 +407,63 @@ int blake2b_done(hash_state *md, unsigned char *out)
    return CRYPT_OK;
 }
 
+HASH_CLONE(blake2b_clone, blake2b)
+
+static const ltc_hash_field _blake2b_fields[] = {
+   { offsetof(hash_state, blake2b.h),         LTC_HASH_U64,     8,   0 },
+   { offsetof(hash_state, blake2b.t),         LTC_HASH_U64,     2,   0 },
+   { offsetof(hash_state, blake2b.f),         LTC_HASH_U64,     2,   0 },
+   { offsetof(hash_state, blake2b.buf),       LTC_HASH_U8,    128,   0 },
+   { offsetof(hash_state, blake2b.curlen),    LTC_HASH_ULONG,   1, 128 },
+   { offsetof(hash_state, blake2b.outlen),    LTC_HASH_ULONG,   1,   0 },
+   { offsetof(hash_state, blake2b.last_node), LTC_HASH_U8,      1,   1 }
+};
+
+/* blake2b_done() writes outlen octets, which must fit the digest of the descriptor */
+static int _blake2b_import_state(const struct ltc_hash_descriptor *desc, hash_state *md,
+                                 const unsigned char *in, unsigned long inlen)
+{
+   int err;
+
+   err = hash_state_import(desc->ID, _blake2b_fields, sizeof(_blake2b_fields) / sizeof(_blake2b_fields[0]), md, in, inlen);
+   if (err != CRYPT_OK) {
+      return err;
+   }
+   if (md->blake2b.outlen == 0 || md->blake2b.outlen > desc->hashsize) {
+      zeromem(md, sizeof(*md));
+      return CRYPT_INVALID_PACKET;
+   }
+   return CRYPT_OK;
+}
+
+HASH_EXPORT_STATE(blake2b_512_export_state, blake2b_512_desc, _blake2b_fields)
+
+int blake2b_512_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _blake2b_import_state(&blake2b_512_desc, md, in, inlen);
+}
+
+HASH_EXPORT_STATE(blake2b_384_export_state, blake2b_384_desc, _blake2b_fields)
+
+int blake2b_384_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _blake2b_import_state(&blake2b_384_desc, md, in, inlen);
+}
+
+HASH_EXPORT_STATE(blake2b_256_export_state, blake2b_256_desc, _blake2b_fields)
+
+int blake2b_256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _blake2b_import_state(&blake2b_256_desc, md, in, inlen);
+}
+
+HASH_EXPORT_STATE(blake2b_160_export_state, blake2b_160_desc, _blake2b_fields)
+
+int blake2b_160_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _blake2b_import_state(&blake2b_160_desc, md, in, inlen);
+}
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
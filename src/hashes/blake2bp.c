@@ -0,0 +1,627 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file blake2bp.c
+  BLAKE2bp, the 4-way parallel tree mode of BLAKE2b
+
+  The message is split into 128 byte blocks which are dealt round-robin to four leaves, the
+  root then hashes the four leaf digests.  The state keeps the leaves word sliced, h[j][i] is
+  word j of leaf i, so a stride of four blocks is compressed with one leaf per AVX2 lane.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_BLAKE2BP
+
+enum {
+   BLAKE2BP_PARALLELISM = 4,
+   BLAKE2BP_BLOCKBYTES = 128,
+   BLAKE2BP_OUTBYTES = 64,
+   BLAKE2BP_KEYBYTES = 64,
+   BLAKE2BP_STRIDE = BLAKE2BP_PARALLELISM * BLAKE2BP_BLOCKBYTES,
+   /* a stride may only be compressed once the last leaf has seen data after it */
+   BLAKE2BP_PENDING = BLAKE2BP_STRIDE + (BLAKE2BP_PARALLELISM - 1) * BLAKE2BP_BLOCKBYTES
+};
+
+const struct ltc_hash_descriptor blake2bp_512_desc =
+{
+    "blake2bp-512",
+    30,
+    64,
+    128,
+    { 0 },
+    0,
+    &blake2bp_512_init,
+    &blake2bp_process,
+    &blake2bp_done,
+    &blake2bp_512_test,
+    NULL,
+    &blake2bp_clone,
+    &blake2bp_512_export_state,
+    &blake2bp_512_import_state
+};
+
+static const ulong64 blake2bp_IV[8] =
+{
+  CONST64(0x6a09e667f3bcc908), CONST64(0xbb67ae8584caa73b),
+  CONST64(0x3c6ef372fe94f82b), CONST64(0xa54ff53a5f1d36f1),
+  CONST64(0x510e527fade682d1), CONST64(0x9b05688c2b3e6c1f),
+  CONST64(0x1f83d9abfb41bd6b), CONST64(0x5be0cd19137e2179)
+};
+
+static const unsigned char blake2bp_sigma[12][16] =
+{
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 } ,
+  { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 } ,
+  { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 } ,
+  {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 } ,
+  {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 } ,
+  {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 } ,
+  { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 } ,
+  { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 } ,
+  {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 } ,
+  { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13 , 0 } ,
+  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 } ,
+  { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 }
+};
+
+/* IV xor the parameter block of a leaf (node_depth 0) or of the root (node_depth 1),
+ * fanout 4, depth 2 and inner_length 64, the other fields are zero */
+static void _blake2bp_param(ulong64 *h, unsigned long outlen, unsigned long keylen, ulong64 node_offset, ulong64 node_depth)
+{
+   int i;
+
+   for (i = 0; i < 8; i++) {
+      h[i] = blake2bp_IV[i];
+   }
+   h[0] ^= (ulong64)outlen | ((ulong64)keylen << 8) | ((ulong64)BLAKE2BP_PARALLELISM << 16) | ((ulong64)2 << 24);
+   h[1] ^= node_offset;
+   h[2] ^= node_depth | ((ulong64)BLAKE2BP_OUTBYTES << 8);
+}
+
+#define G(r, i, a, b, c, d)                                                                                            \
+   do {                                                                                                                \
+      a = a + b + m[blake2bp_sigma[r][2 * i + 0]];                                                                     \
+      d = ROR64(d ^ a, 32);                                                                                            \
+      c = c + d;                                                                                                       \
+      b = ROR64(b ^ c, 24);                                                                                            \
+      a = a + b + m[blake2bp_sigma[r][2 * i + 1]];                                                                     \
+      d = ROR64(d ^ a, 16);                                                                                            \
+      c = c + d;                                                                                                       \
+      b = ROR64(b ^ c, 63);                                                                                            \
+   } while (0)
+
+#define ROUND(r)                                                                                                       \
+   do {                                                                                                                \
+      G(r, 0, v[0], v[4], v[8], v[12]);                                                                                \
+      G(r, 1, v[1], v[5], v[9], v[13]);                                                                                \
+      G(r, 2, v[2], v[6], v[10], v[14]);                                                                               \
+      G(r, 3, v[3], v[7], v[11], v[15]);                                                                               \
+      G(r, 4, v[0], v[5], v[10], v[15]);                                                                               \
+      G(r, 5, v[1], v[6], v[11], v[12]);                                                                               \
+      G(r, 6, v[2], v[7], v[8], v[13]);                                                                                \
+      G(r, 7, v[3], v[4], v[9], v[14]);                                                                                \
+   } while (0)
+
+/* plain BLAKE2b compression of one node, t is the byte counter including this block */
+static void _blake2bp_compress(ulong64 *h, const unsigned char *buf, ulong64 t, ulong64 f0, ulong64 f1)
+{
+   ulong64 m[16];
+   ulong64 v[16];
+   int i;
+
+   for (i = 0; i < 16; ++i) {
+      LOAD64L(m[i], buf + i * sizeof(m[i]));
+   }
+
+   for (i = 0; i < 8; ++i) {
+      v[i] = h[i];
+      v[i + 8] = blake2bp_IV[i];
+   }
+   v[12] ^= t;
+   v[14] ^= f0;
+   v[15] ^= f1;
+
+   ROUND(0);
+   ROUND(1);
+   ROUND(2);
+   ROUND(3);
+   ROUND(4);
+   ROUND(5);
+   ROUND(6);
+   ROUND(7);
+   ROUND(8);
+   ROUND(9);
+   ROUND(10);
+   ROUND(11);
+
+   for (i = 0; i < 8; ++i) {
+      h[i] = h[i] ^ v[i] ^ v[i + 8];
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(m, sizeof(m));
+   zeromem(v, sizeof(v));
+#endif
+}
+
+#undef G
+#undef ROUND
+
+/* compress a block of leaf i */
+static void _blake2bp_leaf(struct blake2bp_state *st, int i, const unsigned char *buf, ulong64 t, int last)
+{
+   ulong64 h[8];
+   int j;
+
+   for (j = 0; j < 8; j++) {
+      h[j] = st->h[j][i];
+   }
+   _blake2bp_compress(h, buf, t,
+                      last ? CONST64(0xffffffffffffffff) : 0,
+                      (last && i == BLAKE2BP_PARALLELISM - 1) ? CONST64(0xffffffffffffffff) : 0);
+   for (j = 0; j < 8; j++) {
+      st->h[j][i] = h[j];
+   }
+}
+
+#ifdef LTC_BLAKE2_SIMD
+
+/* see chacha_simd.c */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+#define BP_ROR63(x)     _mm256_xor_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x))
+
+#define BP_G(r, i, a, b, c, d)                                                             \
+   a = _mm256_add_epi64(_mm256_add_epi64(a, b), M[blake2bp_sigma[r][2 * i + 0]]);          \
+   d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), _MM_SHUFFLE(2, 3, 0, 1));              \
+   c = _mm256_add_epi64(c, d);                                                             \
+   b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), rot24);                                 \
+   a = _mm256_add_epi64(_mm256_add_epi64(a, b), M[blake2bp_sigma[r][2 * i + 1]]);          \
+   d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);                                 \
+   c = _mm256_add_epi64(c, d);                                                             \
+   b = BP_ROR63(_mm256_xor_si256(b, c));
+
+#define BP_ROUND(r)                                                                        \
+   BP_G(r, 0, v0, v4, v8,  v12)                                                            \
+   BP_G(r, 1, v1, v5, v9,  v13)                                                            \
+   BP_G(r, 2, v2, v6, v10, v14)                                                            \
+   BP_G(r, 3, v3, v7, v11, v15)                                                            \
+   BP_G(r, 4, v0, v5, v10, v15)                                                            \
+   BP_G(r, 5, v1, v6, v11, v12)                                                            \
+   BP_G(r, 6, v2, v7, v8,  v13)                                                            \
+   BP_G(r, 7, v3, v4, v9,  v14)
+
+#define BP_LOAD(p)      _mm256_loadu_si256((const __m256i*)(const void*)(p))
+
+/* compress whole strides, one leaf per 64-bit lane */
+LTC_TARGET("avx2")
+static void _blake2bp_strides_avx2(struct blake2bp_state *st, const unsigned char *in, unsigned long strides)
+{
+   const __m256i rot24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                          3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+   const __m256i rot16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                          2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+   __m256i H[8], M[16];
+   __m256i v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15;
+   __m256i t0, t1, t2, t3;
+   int i;
+
+   for (i = 0; i < 8; i++) {
+      H[i] = BP_LOAD(st->h[i]);
+   }
+
+   for (; strides > 0; strides--, in += BLAKE2BP_STRIDE) {
+      /* transpose the four blocks, M[w] holds word w of every leaf (x86 is little endian) */
+      for (i = 0; i < 16; i += 4) {
+         t0 = _mm256_unpacklo_epi64(BP_LOAD(in + 8 * i), BP_LOAD(in + 8 * i + 128));
+         t1 = _mm256_unpackhi_epi64(BP_LOAD(in + 8 * i), BP_LOAD(in + 8 * i + 128));
+         t2 = _mm256_unpacklo_epi64(BP_LOAD(in + 8 * i + 256), BP_LOAD(in + 8 * i + 384));
+         t3 = _mm256_unpackhi_epi64(BP_LOAD(in + 8 * i + 256), BP_LOAD(in + 8 * i + 384));
+         M[i + 0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+         M[i + 1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+         M[i + 2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+         M[i + 3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+      }
+
+      st->t += BLAKE2BP_BLOCKBYTES;
+
+      v0  = H[0]; v1 = H[1]; v2 = H[2]; v3 = H[3];
+      v4  = H[4]; v5 = H[5]; v6 = H[6]; v7 = H[7];
+      v8  = _mm256_set1_epi64x((long long)blake2bp_IV[0]);
+      v9  = _mm256_set1_epi64x((long long)blake2bp_IV[1]);
+      v10 = _mm256_set1_epi64x((long long)blake2bp_IV[2]);
+      v11 = _mm256_set1_epi64x((long long)blake2bp_IV[3]);
+      v12 = _mm256_set1_epi64x((long long)(blake2bp_IV[4] ^ st->t));
+      v13 = _mm256_set1_epi64x((long long)blake2bp_IV[5]);
+      v14 = _mm256_set1_epi64x((long long)blake2bp_IV[6]);
+      v15 = _mm256_set1_epi64x((long long)blake2bp_IV[7]);
+
+      BP_ROUND(0)
+      BP_ROUND(1)
+      BP_ROUND(2)
+      BP_ROUND(3)
+      BP_ROUND(4)
+      BP_ROUND(5)
+      BP_ROUND(6)
+      BP_ROUND(7)
+      BP_ROUND(8)
+      BP_ROUND(9)
+      BP_ROUND(10)
+      BP_ROUND(11)
+
+      H[0] = _mm256_xor_si256(H[0], _mm256_xor_si256(v0, v8));
+      H[1] = _mm256_xor_si256(H[1], _mm256_xor_si256(v1, v9));
+      H[2] = _mm256_xor_si256(H[2], _mm256_xor_si256(v2, v10));
+      H[3] = _mm256_xor_si256(H[3], _mm256_xor_si256(v3, v11));
+      H[4] = _mm256_xor_si256(H[4], _mm256_xor_si256(v4, v12));
+      H[5] = _mm256_xor_si256(H[5], _mm256_xor_si256(v5, v13));
+      H[6] = _mm256_xor_si256(H[6], _mm256_xor_si256(v6, v14));
+      H[7] = _mm256_xor_si256(H[7], _mm256_xor_si256(v7, v15));
+   }
+
+   for (i = 0; i < 8; i++) {
+      _mm256_storeu_si256((__m256i*)(void*)st->h[i], H[i]);
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(M, sizeof(M));
+#endif
+}
+
+#undef BP_G
+#undef BP_ROUND
+#undef BP_LOAD
+
+#endif /* LTC_BLAKE2_SIMD */
+
+/* compress whole strides, none of which holds the last block of a leaf */
+static void _blake2bp_strides(struct blake2bp_state *st, const unsigned char *in, unsigned long strides)
+{
+   int i;
+
+#ifdef LTC_BLAKE2_SIMD
+   if (crypt_cpu_features() & LTC_CPU_AVX2) {
+      _blake2bp_strides_avx2(st, in, strides);
+      return;
+   }
+#endif
+
+   for (; strides > 0; strides--, in += BLAKE2BP_STRIDE) {
+      st->t += BLAKE2BP_BLOCKBYTES;
+      for (i = 0; i < BLAKE2BP_PARALLELISM; i++) {
+         _blake2bp_leaf(st, i, in + i * BLAKE2BP_BLOCKBYTES, st->t, 0);
+      }
+   }
+}
+
+/* the key block is the first block of every leaf, it is held back until
+ * it is known whether it is also the last one */
+static int _blake2bp_key_pending(const struct blake2bp_state *st)
+{
+   return st->keylen != 0 && st->t == 0;
+}
+
+static void _blake2bp_key_block(const struct blake2bp_state *st, unsigned char *block)
+{
+   XMEMSET(block, 0, BLAKE2BP_BLOCKBYTES);
+   XMEMCPY(block, st->key, st->keylen);
+}
+
+/**
+  Initialize the hash state
+  @param md      The hash state you wish to initialize
+  @param outlen  The desired digest length, 1 to 64 octets
+  @param key     The key for keyed hashing (MAC), NULL for none
+  @param keylen  The length of the key, up to 64 octets
+  @return CRYPT_OK if successful
+*/
+int blake2bp_init(hash_state *md, unsigned long outlen, const unsigned char *key, unsigned long keylen)
+{
+   ulong64 h[8];
+   int i, j;
+
+   LTC_ARGCHK(md != NULL);
+
+   if ((!outlen) || (outlen > BLAKE2BP_OUTBYTES))
+      return CRYPT_INVALID_ARG;
+
+   if ((key && !keylen) || (keylen && !key) || (keylen > BLAKE2BP_KEYBYTES))
+      return CRYPT_INVALID_ARG;
+
+   XMEMSET(&md->blake2bp, 0, sizeof(md->blake2bp));
+
+   for (i = 0; i < BLAKE2BP_PARALLELISM; i++) {
+      _blake2bp_param(h, outlen, keylen, (ulong64)i, 0);
+      for (j = 0; j < 8; j++) {
+         md->blake2bp.h[j][i] = h[j];
+      }
+   }
+   if (key) {
+      XMEMCPY(md->blake2bp.key, key, keylen);
+   }
+   md->blake2bp.keylen = keylen;
+   md->blake2bp.outlen = outlen;
+
+   return CRYPT_OK;
+}
+
+/**
+  Initialize the hash state for a 64 octet digest
+  @param md   The hash state you wish to initialize
+  @return CRYPT_OK if successful
+*/
+int blake2bp_512_init(hash_state *md) { return blake2bp_init(md, 64, NULL, 0); }
+
+/**
+  Process a block of memory though the hash
+  @param md     The hash state
+  @param in     The data to hash
+  @param inlen  The length of the data (octets)
+  @return CRYPT_OK if successful
+*/
+int blake2bp_process(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   struct blake2bp_state *st;
+   unsigned char block[BLAKE2BP_STRIDE];
+   unsigned long n;
+   int i;
+
+   LTC_ARGCHK(md != NULL);
+   LTC_ARGCHK(in != NULL);
+
+   st = &md->blake2bp;
+   if (st->buflen > sizeof(st->buf)) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   if (st->buflen + inlen > BLAKE2BP_PENDING && _blake2bp_key_pending(st)) {
+      _blake2bp_key_block(st, block);
+      for (i = 1; i < BLAKE2BP_PARALLELISM; i++) {
+         XMEMCPY(block + i * BLAKE2BP_BLOCKBYTES, block, BLAKE2BP_BLOCKBYTES);
+      }
+      _blake2bp_strides(st, block, 1);
+      zeromem(st->key, sizeof(st->key));
+#ifdef LTC_CLEAN_STACK
+      zeromem(block, sizeof(block));
+#endif
+   }
+
+   while (st->buflen + inlen > BLAKE2BP_PENDING) {
+      if (st->buflen == 0) {
+         n = (inlen - (BLAKE2BP_PENDING - BLAKE2BP_STRIDE) - 1) / BLAKE2BP_STRIDE;
+         _blake2bp_strides(st, in, n);
+         in += n * BLAKE2BP_STRIDE;
+         inlen -= n * BLAKE2BP_STRIDE;
+      } else if (st->buflen < BLAKE2BP_STRIDE) {
+         n = BLAKE2BP_STRIDE - st->buflen;
+         XMEMCPY(st->buf + st->buflen, in, n);
+         in += n;
+         inlen -= n;
+         _blake2bp_strides(st, st->buf, 1);
+         st->buflen = 0;
+      } else {
+         _blake2bp_strides(st, st->buf, 1);
+         st->buflen -= BLAKE2BP_STRIDE;
+         XMEMMOVE(st->buf, st->buf + BLAKE2BP_STRIDE, st->buflen);
+      }
+   }
+
+   XMEMCPY(st->buf + st->buflen, in, inlen);
+   st->buflen += inlen;
+   return CRYPT_OK;
+}
+
+/**
+  Terminate the hash to get the digest
+  @param md   The hash state
+  @param out  [out] The destination of the hash (outlen octets as given to blake2bp_init())
+  @return CRYPT_OK if successful
+*/
+int blake2bp_done(hash_state *md, unsigned char *out)
+{
+   struct blake2bp_state *st;
+   unsigned char block[BLAKE2BP_BLOCKBYTES];
+   unsigned char leaves[BLAKE2BP_PARALLELISM * BLAKE2BP_OUTBYTES];
+   ulong64 h[8], t;
+   unsigned long k, n;
+   int i, j;
+
+   LTC_ARGCHK(md != NULL);
+   LTC_ARGCHK(out != NULL);
+
+   st = &md->blake2bp;
+   if (st->buflen > sizeof(st->buf) || st->outlen == 0) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   for (i = 0; i < BLAKE2BP_PARALLELISM; i++) {
+      t = st->t;
+      k = (unsigned long)i * BLAKE2BP_BLOCKBYTES;
+      if (_blake2bp_key_pending(st)) {
+         _blake2bp_key_block(st, block);
+         t += BLAKE2BP_BLOCKBYTES;
+         _blake2bp_leaf(st, i, block, t, st->buflen <= k);
+         if (st->buflen <= k) {
+            continue;
+         }
+      }
+      /* the buffer holds up to two blocks of this leaf, only the last one is final */
+      for (;; k += BLAKE2BP_STRIDE) {
+         if (st->buflen <= k + BLAKE2BP_STRIDE) {
+            n = st->buflen > k ? MIN(st->buflen - k, BLAKE2BP_BLOCKBYTES) : 0;
+            XMEMSET(block, 0, sizeof(block));
+            XMEMCPY(block, st->buf + k, n);
+            _blake2bp_leaf(st, i, block, t + n, 1);
+            break;
+         }
+         t += BLAKE2BP_BLOCKBYTES;
+         _blake2bp_leaf(st, i, st->buf + k, t, 0);
+      }
+   }
+
+   for (i = 0; i < BLAKE2BP_PARALLELISM; i++) {
+      for (j = 0; j < 8; j++) {
+         STORE64L(st->h[j][i], leaves + i * BLAKE2BP_OUTBYTES + j * 8);
+      }
+   }
+
+   /* the root takes the key length into its parameter block, but not the key block */
+   _blake2bp_param(h, st->outlen, st->keylen, 0, 1);
+   _blake2bp_compress(h, leaves, BLAKE2BP_BLOCKBYTES, 0, 0);
+   _blake2bp_compress(h, leaves + BLAKE2BP_BLOCKBYTES, 2 * BLAKE2BP_BLOCKBYTES,
+                      CONST64(0xffffffffffffffff), CONST64(0xffffffffffffffff));
+
+   for (j = 0; j < 8; j++) {
+      STORE64L(h[j], leaves + j * 8);
+   }
+   XMEMCPY(out, leaves, st->outlen);
+   zeromem(md, sizeof(hash_state));
+#ifdef LTC_CLEAN_STACK
+   zeromem(block, sizeof(block));
+   zeromem(leaves, sizeof(leaves));
+   zeromem(h, sizeof(h));
+#endif
+   return CRYPT_OK;
+}
+
+/**
+  Copy the hash state
+  @param src  The hash state to copy
+  @param dst  [out] The destination hash state
+  @return CRYPT_OK if successful
+*/
+HASH_CLONE(blake2bp_clone, blake2bp)
+
+static const ltc_hash_field _blake2bp_fields[] = {
+   { offsetof(hash_state, blake2bp.h),      LTC_HASH_U64,   8 * BLAKE2BP_PARALLELISM, 0                 },
+   { offsetof(hash_state, blake2bp.t),      LTC_HASH_U64,   1,                        0                 },
+   { offsetof(hash_state, blake2bp.buf),    LTC_HASH_U8,    BLAKE2BP_PENDING,         0                 },
+   { offsetof(hash_state, blake2bp.key),    LTC_HASH_U8,    BLAKE2BP_KEYBYTES,        0                 },
+   { offsetof(hash_state, blake2bp.buflen), LTC_HASH_ULONG, 1,                        BLAKE2BP_PENDING  },
+   { offsetof(hash_state, blake2bp.keylen), LTC_HASH_ULONG, 1,                        BLAKE2BP_KEYBYTES },
+   { offsetof(hash_state, blake2bp.outlen), LTC_HASH_ULONG, 1,                        BLAKE2BP_OUTBYTES }
+};
+
+/**
+  Serialize the hash state
+  @param md     The hash state
+  @param out    [out] The destination of the serialized state
+  @param outlen [in/out] The max size and resulting size of the serialized state
+  @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(blake2bp_512_export_state, blake2bp_512_desc, _blake2bp_fields)
+
+/**
+  Load a hash state serialized by blake2bp_512_export_state()
+  @param md     [out] The hash state
+  @param in     The serialized state
+  @param inlen  The length of the serialized state (octets)
+  @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(blake2bp_512_import_state, blake2bp_512_desc, _blake2bp_fields)
+
+/**
+  Self-test the hash
+  @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
+*/
+int blake2bp_512_test(void)
+{
+#ifndef LTC_TEST
+   return CRYPT_NOP;
+#else
+   /* the message is 0, 1, 2, ... and the key 0, 1, ..., 63, as in the BLAKE2 reference KAT */
+   static const struct {
+      int keyed;
+      unsigned long len;
+      unsigned char hash[64];
+   } tests[] = {
+      { 0,    0,
+        { 0xb5, 0xef, 0x81, 0x1a, 0x80, 0x38, 0xf7, 0x0b,
+          0x62, 0x8f, 0xa8, 0xb2, 0x94, 0xda, 0xae, 0x74,
+          0x92, 0xb1, 0xeb, 0xe3, 0x43, 0xa8, 0x0e, 0xaa,
+          0xbb, 0xf1, 0xf6, 0xae, 0x66, 0x4d, 0xd6, 0x7b,
+          0x9d, 0x90, 0xb0, 0x12, 0x07, 0x91, 0xea, 0xb8,
+          0x1d, 0xc9, 0x69, 0x85, 0xf2, 0x88, 0x49, 0xf6,
+          0xa3, 0x05, 0x18, 0x6a, 0x85, 0x50, 0x1b, 0x40,
+          0x51, 0x14, 0xbf, 0xa6, 0x78, 0xdf, 0x93, 0x80 } },
+      { 0, 1000,
+        { 0x1c, 0xe5, 0xb8, 0xd6, 0xf6, 0xfc, 0xc8, 0x9f,
+          0xcb, 0x6e, 0xd2, 0x9f, 0x12, 0x79, 0x6c, 0xc2,
+          0x10, 0xa0, 0x3f, 0x47, 0x63, 0xe5, 0x28, 0xcb,
+          0x2c, 0x0e, 0x1b, 0x4b, 0x12, 0x55, 0xd6, 0xae,
+          0x86, 0xc7, 0x93, 0x32, 0x52, 0x9f, 0x63, 0x68,
+          0xd0, 0xbc, 0xfe, 0x9d, 0x31, 0x6a, 0x5f, 0x99,
+          0x9a, 0x53, 0xaf, 0x47, 0xa8, 0xf0, 0xec, 0x44,
+          0x12, 0xce, 0x19, 0x15, 0x6b, 0xba, 0xfd, 0x04 } },
+      { 1,    0,
+        { 0x9d, 0x94, 0x61, 0x07, 0x3e, 0x4e, 0xb6, 0x40,
+          0xa2, 0x55, 0x35, 0x7b, 0x83, 0x9f, 0x39, 0x4b,
+          0x83, 0x8c, 0x6f, 0xf5, 0x7c, 0x9b, 0x68, 0x6a,
+          0x3f, 0x76, 0x10, 0x7c, 0x10, 0x66, 0x72, 0x8f,
+          0x3c, 0x99, 0x56, 0xbd, 0x78, 0x5c, 0xbc, 0x3b,
+          0xf7, 0x9d, 0xc2, 0xab, 0x57, 0x8c, 0x5a, 0x0c,
+          0x06, 0x3b, 0x9d, 0x9c, 0x40, 0x58, 0x48, 0xde,
+          0x1d, 0xbe, 0x82, 0x1c, 0xd0, 0x5c, 0x94, 0x0a } },
+      { 1,  255,
+        { 0x96, 0xfb, 0xcb, 0xb6, 0x0b, 0xd3, 0x13, 0xb8,
+          0x84, 0x50, 0x33, 0xe5, 0xbc, 0x05, 0x8a, 0x38,
+          0x02, 0x74, 0x38, 0x57, 0x2d, 0x7e, 0x79, 0x57,
+          0xf3, 0x68, 0x4f, 0x62, 0x68, 0xaa, 0xdd, 0x3a,
+          0xd0, 0x8d, 0x21, 0x76, 0x7e, 0xd6, 0x87, 0x86,
+          0x85, 0x33, 0x1b, 0xa9, 0x85, 0x71, 0x48, 0x7e,
+          0x12, 0x47, 0x0a, 0xad, 0x66, 0x93, 0x26, 0x71,
+          0x6e, 0x46, 0x66, 0x7f, 0x69, 0xf8, 0xd7, 0xe8 } },
+      { 1, 1000,
+        { 0x10, 0xe1, 0x19, 0x19, 0x1d, 0xa5, 0x96, 0x4a,
+          0xfd, 0xbf, 0x01, 0x71, 0xf5, 0xe0, 0x62, 0xd4,
+          0x12, 0x3e, 0x6c, 0x97, 0xe7, 0x59, 0xd2, 0x0d,
+          0x03, 0x82, 0x5b, 0xe2, 0x2d, 0xeb, 0xc6, 0x94,
+          0x7e, 0xf6, 0xc0, 0x1f, 0x5f, 0xda, 0xc9, 0xeb,
+          0x36, 0xe3, 0xb0, 0x39, 0x55, 0xff, 0x28, 0xd6,
+          0x47, 0xca, 0xf5, 0x64, 0xf2, 0xcb, 0x2f, 0x20,
+          0x3a, 0x0c, 0xbc, 0x90, 0xe0, 0xdd, 0x4d, 0xc3 } }
+   };
+
+   unsigned char msg[1000], key[64], tmp[64];
+   hash_state md;
+   int i, err;
+
+   for (i = 0; i < (int)sizeof(msg); i++) {
+      msg[i] = (unsigned char)i;
+   }
+   for (i = 0; i < (int)sizeof(key); i++) {
+      key[i] = (unsigned char)i;
+   }
+
+   for (i = 0; i < (int)(sizeof(tests) / sizeof(tests[0])); i++) {
+      if ((err = blake2bp_init(&md, 64, tests[i].keyed ? key : NULL, tests[i].keyed ? 64 : 0)) != CRYPT_OK) {
+         return err;
+      }
+      /* in two parts, so the buffered path is taken as well */
+      blake2bp_process(&md, msg, tests[i].len / 3);
+      blake2bp_process(&md, msg + tests[i].len / 3, tests[i].len - tests[i].len / 3);
+      blake2bp_done(&md, tmp);
+      if (compare_testvector(tmp, sizeof(tmp), tests[i].hash, sizeof(tests[i].hash), "BLAKE2BP_512", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+   }
+   return CRYPT_OK;
+#endif
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -79,7 +79,10 @@ const struct ltc_hash_descriptor blake2s_128_desc =
     &blake2s_process,
     &blake2s_done,
     &blake2s_128_test,
-    NULL
+    NULL,
+    &blake2s_clone,
+    &blake2s_128_export_state,
+    &blake2s_128_import_state
 };
 
 const struct ltc_hash_descriptor blake2s_160_desc =
@@ -94,7 +97,10 @@ const struct ltc_hash_descriptor blake2s_160_desc =
     &blake2s_process,
     &blake2s_done,
     &blake2s_160_test,
-    NULL
+    NULL,
+    &blake2s_clone,
+    &blake2s_160_export_state,
+    &blake2s_160_import_state
 };
 
 const struct ltc_hash_descriptor blake2s_224_desc =
@@ -109,7 +115,10 @@ const struct ltc_hash_descriptor blake2s_224_desc =
     &blake2s_process,
     &blake2s_done,
     &blake2s_224_test,
-    NULL
+    NULL,
+    &blake2s_clone,
+    &blake2s_224_export_state,
+    &blake2s_224_import_state
 };
 
 const struct ltc_hash_descriptor blake2s_256_desc =
@@ -124,7 +133,10 @@ const struct ltc_hash_descriptor blake2s_256_desc =
     &blake2s_process,
     &blake2s_done,
     &blake2s_256_test,
-    NULL
+    NULL,
+    &blake2s_clone,
+    &blake2s_256_export_state,
+    &blake2s_256_import_state
 };
 
 static const ulong32 blake2s_IV[8] = {
@@ -271,6 +283,12 @@ static int blake2s_compress(hash_state *md, const unsigned char *buf)
    ulong32 m[16];
    ulong32 v[16];
 
+#ifdef LTC_BLAKE2_SIMD
+   if (blake2s_simd_is_supported()) {
+      return blake2s_simd_compress(md, buf);
+   }
+#endif
+
    for (i = 0; i < 16; ++i) {
       LOAD32L(m[i], buf + i * sizeof(m[i]));
    }
@@ -377,6 +395,63 @@ int blake2s_done(hash_state *md, unsigned char *out)
    return CRYPT_OK;
 }
 
+HASH_CLONE(blake2s_clone, blake2s)
+
+static const ltc_hash_field _blake2s_fields[] = {
+   { offsetof(hash_state, blake2s.h),         LTC_HASH_U32,     8,   0 },
+   { offsetof(hash_state, blake2s.t),         LTC_HASH_U32,     2,   0 },
+   { offsetof(hash_state, blake2s.f),         LTC_HASH_U32,     2,   0 },
+   { offsetof(hash_state, blake2s.buf),       LTC_HASH_U8,     64,   0 },
+   { offsetof(hash_state, blake2s.curlen),    LTC_HASH_ULONG,   1,  64 },
+   { offsetof(hash_state, blake2s.outlen),    LTC_HASH_ULONG,   1,   0 },
+   { offsetof(hash_state, blake2s.last_node), LTC_HASH_U8,      1,   1 }
+};
+
+/* blake2s_done() writes outlen octets, which must fit the digest of the descriptor */
+static int _blake2s_import_state(const struct ltc_hash_descriptor *desc, hash_state *md,
+                                 const unsigned char *in, unsigned long inlen)
+{
+   int err;
+
+   err = hash_state_import(desc->ID, _blake2s_fields, sizeof(_blake2s_fields) / sizeof(_blake2s_fields[0]), md, in, inlen);
+   if (err != CRYPT_OK) {
+      return err;
+   }
+   if (md->blake2s.outlen == 0 || md->blake2s.outlen > desc->hashsize) {
+      zeromem(md, sizeof(*md));
+      return CRYPT_INVALID_PACKET;
+   }
+   return CRYPT_OK;
+}
+
+HASH_EXPORT_STATE(blake2s_256_export_state, blake2s_256_desc, _blake2s_fields)
+
+int blake2s_256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _blake2s_import_state(&blake2s_256_desc, md, in, inlen);
+}
+
+HASH_EXPORT_STATE(blake2s_224_export_state, blake2s_224_desc, _blake2s_fields)
+
+int blake2s_224_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _blake2s_import_state(&blake2s_224_desc, md, in, inlen);
+}
+
+HASH_EXPORT_STATE(blake2s_160_export_state, blake2s_160_desc, _blake2s_fields)
+
+int blake2s_160_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _blake2s_import_state(&blake2s_160_desc, md, in, inlen);
+}
+
+HASH_EXPORT_STATE(blake2s_128_export_state, blake2s_128_desc, _blake2s_fields)
+
+int blake2s_128_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _blake2s_import_state(&blake2s_128_desc, md, in, inlen);
+}
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
@@ -0,0 +1,609 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file blake2sp.c
+  BLAKE2sp, the 8-way parallel tree mode of BLAKE2s
+
+  Works like blake2bp.c with eight leaves of 64 byte blocks, a stride of eight blocks is
+  compressed with one leaf per 32-bit AVX2 lane.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_BLAKE2SP
+
+enum {
+   BLAKE2SP_PARALLELISM = 8,
+   BLAKE2SP_BLOCKBYTES = 64,
+   BLAKE2SP_OUTBYTES = 32,
+   BLAKE2SP_KEYBYTES = 32,
+   BLAKE2SP_STRIDE = BLAKE2SP_PARALLELISM * BLAKE2SP_BLOCKBYTES,
+   /* a stride may only be compressed once the last leaf has seen data after it */
+   BLAKE2SP_PENDING = BLAKE2SP_STRIDE + (BLAKE2SP_PARALLELISM - 1) * BLAKE2SP_BLOCKBYTES
+};
+
+const struct ltc_hash_descriptor blake2sp_256_desc =
+{
+    "blake2sp-256",
+    29,
+    32,
+    64,
+    { 0 },
+    0,
+    &blake2sp_256_init,
+    &blake2sp_process,
+    &blake2sp_done,
+    &blake2sp_256_test,
+    NULL,
+    &blake2sp_clone,
+    &blake2sp_256_export_state,
+    &blake2sp_256_import_state
+};
+
+static const ulong32 blake2sp_IV[8] = {
+   0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+   0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+static const unsigned char blake2sp_sigma[10][16] = {
+   { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+   { 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+   { 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+   { 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+   { 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+   { 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+   { 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+   { 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+   { 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+   { 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+};
+
+/* IV xor the parameter block of a leaf (node_depth 0) or of the root (node_depth 1),
+ * fanout 8, depth 2 and inner_length 32, the other fields are zero */
+static void _blake2sp_param(ulong32 *h, unsigned long outlen, unsigned long keylen, ulong32 node_offset, ulong32 node_depth)
+{
+   int i;
+
+   for (i = 0; i < 8; i++) {
+      h[i] = blake2sp_IV[i];
+   }
+   h[0] ^= (ulong32)outlen | ((ulong32)keylen << 8) | ((ulong32)BLAKE2SP_PARALLELISM << 16) | ((ulong32)2 << 24);
+   h[2] ^= node_offset;
+   h[3] ^= (node_depth << 16) | ((ulong32)BLAKE2SP_OUTBYTES << 24);
+}
+
+#define G(r, i, a, b, c, d)                                                                                            \
+   do {                                                                                                                \
+      a = a + b + m[blake2sp_sigma[r][2 * i + 0]];                                                                     \
+      d = ROR(d ^ a, 16);                                                                                              \
+      c = c + d;                                                                                                       \
+      b = ROR(b ^ c, 12);                                                                                              \
+      a = a + b + m[blake2sp_sigma[r][2 * i + 1]];                                                                     \
+      d = ROR(d ^ a, 8);                                                                                               \
+      c = c + d;                                                                                                       \
+      b = ROR(b ^ c, 7);                                                                                               \
+   } while (0)
+
+#define ROUND(r)                                                                                                       \
+   do {                                                                                                                \
+      G(r, 0, v[0], v[4], v[8], v[12]);                                                                                \
+      G(r, 1, v[1], v[5], v[9], v[13]);                                                                                \
+      G(r, 2, v[2], v[6], v[10], v[14]);                                                                               \
+      G(r, 3, v[3], v[7], v[11], v[15]);                                                                               \
+      G(r, 4, v[0], v[5], v[10], v[15]);                                                                               \
+      G(r, 5, v[1], v[6], v[11], v[12]);                                                                               \
+      G(r, 6, v[2], v[7], v[8], v[13]);                                                                                \
+      G(r, 7, v[3], v[4], v[9], v[14]);                                                                                \
+   } while (0)
+
+/* plain BLAKE2s compression of one node, t is the byte counter including this block */
+static void _blake2sp_compress(ulong32 *h, const unsigned char *buf, ulong64 t, ulong32 f0, ulong32 f1)
+{
+   ulong32 m[16];
+   ulong32 v[16];
+   int i;
+
+   for (i = 0; i < 16; ++i) {
+      LOAD32L(m[i], buf + i * sizeof(m[i]));
+   }
+
+   for (i = 0; i < 8; ++i) {
+      v[i] = h[i];
+      v[i + 8] = blake2sp_IV[i];
+   }
+   v[12] ^= (ulong32)t;
+   v[13] ^= (ulong32)(t >> 32);
+   v[14] ^= f0;
+   v[15] ^= f1;
+
+   ROUND(0);
+   ROUND(1);
+   ROUND(2);
+   ROUND(3);
+   ROUND(4);
+   ROUND(5);
+   ROUND(6);
+   ROUND(7);
+   ROUND(8);
+   ROUND(9);
+
+   for (i = 0; i < 8; ++i) {
+      h[i] = h[i] ^ v[i] ^ v[i + 8];
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(m, sizeof(m));
+   zeromem(v, sizeof(v));
+#endif
+}
+
+#undef G
+#undef ROUND
+
+/* compress a block of leaf i */
+static void _blake2sp_leaf(struct blake2sp_state *st, int i, const unsigned char *buf, ulong64 t, int last)
+{
+   ulong32 h[8];
+   int j;
+
+   for (j = 0; j < 8; j++) {
+      h[j] = st->h[j][i];
+   }
+   _blake2sp_compress(h, buf, t,
+                      last ? 0xffffffffUL : 0,
+                      (last && i == BLAKE2SP_PARALLELISM - 1) ? 0xffffffffUL : 0);
+   for (j = 0; j < 8; j++) {
+      st->h[j][i] = h[j];
+   }
+}
+
+#ifdef LTC_BLAKE2_SIMD
+
+/* see chacha_simd.c */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+#define SP_ROR(x, n)    _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+#define SP_G(r, i, a, b, c, d)                                                             \
+   a = _mm256_add_epi32(_mm256_add_epi32(a, b), M[blake2sp_sigma[r][2 * i + 0]]);          \
+   d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);                                 \
+   c = _mm256_add_epi32(c, d);                                                             \
+   b = SP_ROR(_mm256_xor_si256(b, c), 12);                                                 \
+   a = _mm256_add_epi32(_mm256_add_epi32(a, b), M[blake2sp_sigma[r][2 * i + 1]]);          \
+   d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);                                  \
+   c = _mm256_add_epi32(c, d);                                                             \
+   b = SP_ROR(_mm256_xor_si256(b, c), 7);
+
+#define SP_ROUND(r)                                                                        \
+   SP_G(r, 0, v0, v4, v8,  v12)                                                            \
+   SP_G(r, 1, v1, v5, v9,  v13)                                                            \
+   SP_G(r, 2, v2, v6, v10, v14)                                                            \
+   SP_G(r, 3, v3, v7, v11, v15)                                                            \
+   SP_G(r, 4, v0, v5, v10, v15)                                                            \
+   SP_G(r, 5, v1, v6, v11, v12)                                                            \
+   SP_G(r, 6, v2, v7, v8,  v13)                                                            \
+   SP_G(r, 7, v3, v4, v9,  v14)
+
+#define SP_LOAD(p)      _mm256_loadu_si256((const __m256i*)(const void*)(p))
+
+/* compress whole strides, one leaf per 32-bit lane */
+LTC_TARGET("avx2")
+static void _blake2sp_strides_avx2(struct blake2sp_state *st, const unsigned char *in, unsigned long strides)
+{
+   const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                          2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+   const __m256i rot8 = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+                                         1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+   __m256i H[8], M[16], t[8], u[8];
+   __m256i v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15;
+   int i, j;
+
+   for (i = 0; i < 8; i++) {
+      H[i] = SP_LOAD(st->h[i]);
+   }
+
+   for (; strides > 0; strides--, in += BLAKE2SP_STRIDE) {
+      /* transpose the eight blocks, M[w] holds word w of every leaf (x86 is little endian) */
+      for (i = 0; i < 16; i += 8) {
+         for (j = 0; j < 8; j += 2) {
+            t[j + 0] = _mm256_unpacklo_epi32(SP_LOAD(in + 4 * i + 64 * j), SP_LOAD(in + 4 * i + 64 * j + 64));
+            t[j + 1] = _mm256_unpackhi_epi32(SP_LOAD(in + 4 * i + 64 * j), SP_LOAD(in + 4 * i + 64 * j + 64));
+         }
+         for (j = 0; j < 8; j += 4) {
+            u[j + 0] = _mm256_unpacklo_epi64(t[j + 0], t[j + 2]);
+            u[j + 1] = _mm256_unpackhi_epi64(t[j + 0], t[j + 2]);
+            u[j + 2] = _mm256_unpacklo_epi64(t[j + 1], t[j + 3]);
+            u[j + 3] = _mm256_unpackhi_epi64(t[j + 1], t[j + 3]);
+         }
+         for (j = 0; j < 4; j++) {
+            M[i + j]     = _mm256_permute2x128_si256(u[j], u[j + 4], 0x20);
+            M[i + j + 4] = _mm256_permute2x128_si256(u[j], u[j + 4], 0x31);
+         }
+      }
+
+      st->t += BLAKE2SP_BLOCKBYTES;
+
+      v0  = H[0]; v1 = H[1]; v2 = H[2]; v3 = H[3];
+      v4  = H[4]; v5 = H[5]; v6 = H[6]; v7 = H[7];
+      v8  = _mm256_set1_epi32((int)blake2sp_IV[0]);
+      v9  = _mm256_set1_epi32((int)blake2sp_IV[1]);
+      v10 = _mm256_set1_epi32((int)blake2sp_IV[2]);
+      v11 = _mm256_set1_epi32((int)blake2sp_IV[3]);
+      v12 = _mm256_set1_epi32((int)(blake2sp_IV[4] ^ (ulong32)st->t));
+      v13 = _mm256_set1_epi32((int)(blake2sp_IV[5] ^ (ulong32)(st->t >> 32)));
+      v14 = _mm256_set1_epi32((int)blake2sp_IV[6]);
+      v15 = _mm256_set1_epi32((int)blake2sp_IV[7]);
+
+      SP_ROUND(0)
+      SP_ROUND(1)
+      SP_ROUND(2)
+      SP_ROUND(3)
+      SP_ROUND(4)
+      SP_ROUND(5)
+      SP_ROUND(6)
+      SP_ROUND(7)
+      SP_ROUND(8)
+      SP_ROUND(9)
+
+      H[0] = _mm256_xor_si256(H[0], _mm256_xor_si256(v0, v8));
+      H[1] = _mm256_xor_si256(H[1], _mm256_xor_si256(v1, v9));
+      H[2] = _mm256_xor_si256(H[2], _mm256_xor_si256(v2, v10));
+      H[3] = _mm256_xor_si256(H[3], _mm256_xor_si256(v3, v11));
+      H[4] = _mm256_xor_si256(H[4], _mm256_xor_si256(v4, v12));
+      H[5] = _mm256_xor_si256(H[5], _mm256_xor_si256(v5, v13));
+      H[6] = _mm256_xor_si256(H[6], _mm256_xor_si256(v6, v14));
+      H[7] = _mm256_xor_si256(H[7], _mm256_xor_si256(v7, v15));
+   }
+
+   for (i = 0; i < 8; i++) {
+      _mm256_storeu_si256((__m256i*)(void*)st->h[i], H[i]);
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(M, sizeof(M));
+   zeromem(t, sizeof(t));
+   zeromem(u, sizeof(u));
+#endif
+}
+
+#undef SP_G
+#undef SP_ROUND
+#undef SP_LOAD
+
+#endif /* LTC_BLAKE2_SIMD */
+
+/* compress whole strides, none of which holds the last block of a leaf */
+static void _blake2sp_strides(struct blake2sp_state *st, const unsigned char *in, unsigned long strides)
+{
+   int i;
+
+#ifdef LTC_BLAKE2_SIMD
+   if (crypt_cpu_features() & LTC_CPU_AVX2) {
+      _blake2sp_strides_avx2(st, in, strides);
+      return;
+   }
+#endif
+
+   for (; strides > 0; strides--, in += BLAKE2SP_STRIDE) {
+      st->t += BLAKE2SP_BLOCKBYTES;
+      for (i = 0; i < BLAKE2SP_PARALLELISM; i++) {
+         _blake2sp_leaf(st, i, in + i * BLAKE2SP_BLOCKBYTES, st->t, 0);
+      }
+   }
+}
+
+/* the key block is the first block of every leaf, it is held back until
+ * it is known whether it is also the last one */
+static int _blake2sp_key_pending(const struct blake2sp_state *st)
+{
+   return st->keylen != 0 && st->t == 0;
+}
+
+static void _blake2sp_key_block(const struct blake2sp_state *st, unsigned char *block)
+{
+   XMEMSET(block, 0, BLAKE2SP_BLOCKBYTES);
+   XMEMCPY(block, st->key, st->keylen);
+}
+
+/**
+  Initialize the hash state
+  @param md      The hash state you wish to initialize
+  @param outlen  The desired digest length, 1 to 32 octets
+  @param key     The key for keyed hashing (MAC), NULL for none
+  @param keylen  The length of the key, up to 32 octets
+  @return CRYPT_OK if successful
+*/
+int blake2sp_init(hash_state *md, unsigned long outlen, const unsigned char *key, unsigned long keylen)
+{
+   ulong32 h[8];
+   int i, j;
+
+   LTC_ARGCHK(md != NULL);
+
+   if ((!outlen) || (outlen > BLAKE2SP_OUTBYTES))
+      return CRYPT_INVALID_ARG;
+
+   if ((key && !keylen) || (keylen && !key) || (keylen > BLAKE2SP_KEYBYTES))
+      return CRYPT_INVALID_ARG;
+
+   XMEMSET(&md->blake2sp, 0, sizeof(md->blake2sp));
+
+   for (i = 0; i < BLAKE2SP_PARALLELISM; i++) {
+      _blake2sp_param(h, outlen, keylen, (ulong32)i, 0);
+      for (j = 0; j < 8; j++) {
+         md->blake2sp.h[j][i] = h[j];
+      }
+   }
+   if (key) {
+      XMEMCPY(md->blake2sp.key, key, keylen);
+   }
+   md->blake2sp.keylen = keylen;
+   md->blake2sp.outlen = outlen;
+
+   return CRYPT_OK;
+}
+
+/**
+  Initialize the hash state for a 32 octet digest
+  @param md   The hash state you wish to initialize
+  @return CRYPT_OK if successful
+*/
+int blake2sp_256_init(hash_state *md) { return blake2sp_init(md, 32, NULL, 0); }
+
+/**
+  Process a block of memory though the hash
+  @param md     The hash state
+  @param in     The data to hash
+  @param inlen  The length of the data (octets)
+  @return CRYPT_OK if successful
+*/
+int blake2sp_process(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   struct blake2sp_state *st;
+   unsigned char block[BLAKE2SP_STRIDE];
+   unsigned long n;
+   int i;
+
+   LTC_ARGCHK(md != NULL);
+   LTC_ARGCHK(in != NULL);
+
+   st = &md->blake2sp;
+   if (st->buflen > sizeof(st->buf)) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   if (st->buflen + inlen > BLAKE2SP_PENDING && _blake2sp_key_pending(st)) {
+      _blake2sp_key_block(st, block);
+      for (i = 1; i < BLAKE2SP_PARALLELISM; i++) {
+         XMEMCPY(block + i * BLAKE2SP_BLOCKBYTES, block, BLAKE2SP_BLOCKBYTES);
+      }
+      _blake2sp_strides(st, block, 1);
+      zeromem(st->key, sizeof(st->key));
+#ifdef LTC_CLEAN_STACK
+      zeromem(block, sizeof(block));
+#endif
+   }
+
+   while (st->buflen + inlen > BLAKE2SP_PENDING) {
+      if (st->buflen == 0) {
+         n = (inlen - (BLAKE2SP_PENDING - BLAKE2SP_STRIDE) - 1) / BLAKE2SP_STRIDE;
+         _blake2sp_strides(st, in, n);
+         in += n * BLAKE2SP_STRIDE;
+         inlen -= n * BLAKE2SP_STRIDE;
+      } else if (st->buflen < BLAKE2SP_STRIDE) {
+         n = BLAKE2SP_STRIDE - st->buflen;
+         XMEMCPY(st->buf + st->buflen, in, n);
+         in += n;
+         inlen -= n;
+         _blake2sp_strides(st, st->buf, 1);
+         st->buflen = 0;
+      } else {
+         _blake2sp_strides(st, st->buf, 1);
+         st->buflen -= BLAKE2SP_STRIDE;
+         XMEMMOVE(st->buf, st->buf + BLAKE2SP_STRIDE, st->buflen);
+      }
+   }
+
+   XMEMCPY(st->buf + st->buflen, in, inlen);
+   st->buflen += inlen;
+   return CRYPT_OK;
+}
+
+/**
+  Terminate the hash to get the digest
+  @param md   The hash state
+  @param out  [out] The destination of the hash (outlen octets as given to blake2sp_init())
+  @return CRYPT_OK if successful
+*/
+int blake2sp_done(hash_state *md, unsigned char *out)
+{
+   struct blake2sp_state *st;
+   unsigned char block[BLAKE2SP_BLOCKBYTES];
+   unsigned char leaves[BLAKE2SP_PARALLELISM * BLAKE2SP_OUTBYTES];
+   ulong32 h[8];
+   ulong64 t;
+   unsigned long k, n;
+   int i, j;
+
+   LTC_ARGCHK(md != NULL);
+   LTC_ARGCHK(out != NULL);
+
+   st = &md->blake2sp;
+   if (st->buflen > sizeof(st->buf) || st->outlen == 0) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   for (i = 0; i < BLAKE2SP_PARALLELISM; i++) {
+      t = st->t;
+      k = (unsigned long)i * BLAKE2SP_BLOCKBYTES;
+      if (_blake2sp_key_pending(st)) {
+         _blake2sp_key_block(st, block);
+         t += BLAKE2SP_BLOCKBYTES;
+         _blake2sp_leaf(st, i, block, t, st->buflen <= k);
+         if (st->buflen <= k) {
+            continue;
+         }
+      }
+      /* the buffer holds up to two blocks of this leaf, only the last one is final */
+      for (;; k += BLAKE2SP_STRIDE) {
+         if (st->buflen <= k + BLAKE2SP_STRIDE) {
+            n = st->buflen > k ? MIN(st->buflen - k, BLAKE2SP_BLOCKBYTES) : 0;
+            XMEMSET(block, 0, sizeof(block));
+            XMEMCPY(block, st->buf + k, n);
+            _blake2sp_leaf(st, i, block, t + n, 1);
+            break;
+         }
+         t += BLAKE2SP_BLOCKBYTES;
+         _blake2sp_leaf(st, i, st->buf + k, t, 0);
+      }
+   }
+
+   for (i = 0; i < BLAKE2SP_PARALLELISM; i++) {
+      for (j = 0; j < 8; j++) {
+         STORE32L(st->h[j][i], leaves + i * BLAKE2SP_OUTBYTES + j * 4);
+      }
+   }
+
+   /* the root takes the key length into its parameter block, but not the key block */
+   _blake2sp_param(h, st->outlen, st->keylen, 0, 1);
+   for (i = 0; i < BLAKE2SP_PARALLELISM * BLAKE2SP_OUTBYTES; i += BLAKE2SP_BLOCKBYTES) {
+      if (i + BLAKE2SP_BLOCKBYTES < BLAKE2SP_PARALLELISM * BLAKE2SP_OUTBYTES) {
+         _blake2sp_compress(h, leaves + i, (ulong64)i + BLAKE2SP_BLOCKBYTES, 0, 0);
+      } else {
+         _blake2sp_compress(h, leaves + i, (ulong64)i + BLAKE2SP_BLOCKBYTES, 0xffffffffUL, 0xffffffffUL);
+      }
+   }
+
+   for (j = 0; j < 8; j++) {
+      STORE32L(h[j], leaves + j * 4);
+   }
+   XMEMCPY(out, leaves, st->outlen);
+   zeromem(md, sizeof(hash_state));
+#ifdef LTC_CLEAN_STACK
+   zeromem(block, sizeof(block));
+   zeromem(leaves, sizeof(leaves));
+   zeromem(h, sizeof(h));
+#endif
+   return CRYPT_OK;
+}
+
+/**
+  Copy the hash state
+  @param src  The hash state to copy
+  @param dst  [out] The destination hash state
+  @return CRYPT_OK if successful
+*/
+HASH_CLONE(blake2sp_clone, blake2sp)
+
+static const ltc_hash_field _blake2sp_fields[] = {
+   { offsetof(hash_state, blake2sp.h),      LTC_HASH_U32,   8 * BLAKE2SP_PARALLELISM, 0                 },
+   { offsetof(hash_state, blake2sp.t),      LTC_HASH_U64,   1,                        0                 },
+   { offsetof(hash_state, blake2sp.buf),    LTC_HASH_U8,    BLAKE2SP_PENDING,         0                 },
+   { offsetof(hash_state, blake2sp.key),    LTC_HASH_U8,    BLAKE2SP_KEYBYTES,        0                 },
+   { offsetof(hash_state, blake2sp.buflen), LTC_HASH_ULONG, 1,                        BLAKE2SP_PENDING  },
+   { offsetof(hash_state, blake2sp.keylen), LTC_HASH_ULONG, 1,                        BLAKE2SP_KEYBYTES },
+   { offsetof(hash_state, blake2sp.outlen), LTC_HASH_ULONG, 1,                        BLAKE2SP_OUTBYTES }
+};
+
+/**
+  Serialize the hash state
+  @param md     The hash state
+  @param out    [out] The destination of the serialized state
+  @param outlen [in/out] The max size and resulting size of the serialized state
+  @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(blake2sp_256_export_state, blake2sp_256_desc, _blake2sp_fields)
+
+/**
+  Load a hash state serialized by blake2sp_256_export_state()
+  @param md     [out] The hash state
+  @param in     The serialized state
+  @param inlen  The length of the serialized state (octets)
+  @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(blake2sp_256_import_state, blake2sp_256_desc, _blake2sp_fields)
+
+/**
+  Self-test the hash
+  @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
+*/
+int blake2sp_256_test(void)
+{
+#ifndef LTC_TEST
+   return CRYPT_NOP;
+#else
+   /* the message is 0, 1, 2, ... and the key 0, 1, ..., 31, as in the BLAKE2 reference KAT */
+   static const struct {
+      int keyed;
+      unsigned long len;
+      unsigned char hash[32];
+   } tests[] = {
+      { 0,    0,
+        { 0xdd, 0x0e, 0x89, 0x17, 0x76, 0x93, 0x3f, 0x43,
+          0xc7, 0xd0, 0x32, 0xb0, 0x8a, 0x91, 0x7e, 0x25,
+          0x74, 0x1f, 0x8a, 0xa9, 0xa1, 0x2c, 0x12, 0xe1,
+          0xca, 0xc8, 0x80, 0x15, 0x00, 0xf2, 0xca, 0x4f } },
+      { 0, 1000,
+        { 0x7e, 0x28, 0x30, 0xf7, 0x4f, 0xc7, 0xc4, 0xd2,
+          0x24, 0xa2, 0x01, 0xb4, 0x6f, 0x95, 0xe3, 0x7e,
+          0xbb, 0xfb, 0x56, 0xdd, 0xdc, 0x49, 0x2f, 0x82,
+          0x27, 0xe4, 0xd9, 0x05, 0x20, 0x17, 0x34, 0xb8 } },
+      { 1,    0,
+        { 0x71, 0x5c, 0xb1, 0x38, 0x95, 0xae, 0xb6, 0x78,
+          0xf6, 0x12, 0x41, 0x60, 0xbf, 0xf2, 0x14, 0x65,
+          0xb3, 0x0f, 0x4f, 0x68, 0x74, 0x19, 0x3f, 0xc8,
+          0x51, 0xb4, 0x62, 0x10, 0x43, 0xf0, 0x9c, 0xc6 } },
+      { 1,  255,
+        { 0x0c, 0x8a, 0x36, 0x59, 0x7d, 0x74, 0x61, 0xc6,
+          0x3a, 0x94, 0x73, 0x28, 0x21, 0xc9, 0x41, 0x85,
+          0x6c, 0x66, 0x83, 0x76, 0x60, 0x6c, 0x86, 0xa5,
+          0x2d, 0xe0, 0xee, 0x41, 0x04, 0xc6, 0x15, 0xdb } },
+      { 1, 1000,
+        { 0x68, 0x6d, 0x69, 0x5f, 0x44, 0x9e, 0x51, 0x56,
+          0xd7, 0x0c, 0x54, 0xcd, 0x7c, 0x3f, 0x74, 0x0c,
+          0x92, 0x33, 0xdc, 0xa1, 0x72, 0xff, 0xca, 0xdb,
+          0xa9, 0x48, 0x84, 0x14, 0xda, 0x9c, 0x14, 0x15 } }
+   };
+
+   unsigned char msg[1000], key[32], tmp[32];
+   hash_state md;
+   int i, err;
+
+   for (i = 0; i < (int)sizeof(msg); i++) {
+      msg[i] = (unsigned char)i;
+   }
+   for (i = 0; i < (int)sizeof(key); i++) {
+      key[i] = (unsigned char)i;
+   }
+
+   for (i = 0; i < (int)(sizeof(tests) / sizeof(tests[0])); i++) {
+      if ((err = blake2sp_init(&md, 32, tests[i].keyed ? key : NULL, tests[i].keyed ? 32 : 0)) != CRYPT_OK) {
+         return err;
+      }
+      /* in two parts, so the buffered path is taken as well */
+      blake2sp_process(&md, msg, tests[i].len / 3);
+      blake2sp_process(&md, msg + tests[i].len / 3, tests[i].len - tests[i].len / 3);
+      blake2sp_done(&md, tmp);
+      if (compare_testvector(tmp, sizeof(tmp), tests[i].hash, sizeof(tests[i].hash), "BLAKE2SP_256", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+   }
+   return CRYPT_OK;
+#endif
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -29,7 +29,10 @@ const struct ltc_hash_descriptor chc_desc = {
    &chc_process,
    &chc_done,
    &chc_test,
-   NULL
+   NULL,
+   &chc_clone,
+   &chc_export_state,
+   &chc_import_state
 };
 
 /**
@@ -243,6 +246,95 @@ int chc_done(hash_state *md, unsigned char *out)
     return CRYPT_OK;
 }
 
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(chc_clone, chc)
+
+/* the state and buffer are one block of the cipher */
+static void _chc_fields(ltc_hash_field *fields)
+{
+   fields[0].offset = offsetof(hash_state, chc.length);
+   fields[0].type   = LTC_HASH_U64;
+   fields[0].count  = 1;
+   fields[0].max    = 0;
+   fields[1].offset = offsetof(hash_state, chc.curlen);
+   fields[1].type   = LTC_HASH_U32;
+   fields[1].count  = 1;
+   fields[1].max    = (unsigned long)cipher_blocksize - 1;
+   fields[2].offset = offsetof(hash_state, chc.state);
+   fields[2].type   = LTC_HASH_U8;
+   fields[2].count  = (unsigned long)cipher_blocksize;
+   fields[2].max    = 0;
+   fields[3].offset = offsetof(hash_state, chc.buf);
+   fields[3].type   = LTC_HASH_U8;
+   fields[3].count  = (unsigned long)cipher_blocksize;
+   fields[3].max    = 0;
+}
+
+/**
+   Serialize the hash state, the ID of the cipher is appended to the fields
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+int chc_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen)
+{
+   ltc_hash_field fields[4];
+   unsigned long len;
+   int err;
+
+   LTC_ARGCHK(md     != NULL);
+   LTC_ARGCHK(out    != NULL);
+   LTC_ARGCHK(outlen != NULL);
+
+   if ((err = cipher_is_valid(cipher_idx)) != CRYPT_OK) {
+      return err;
+   }
+   _chc_fields(fields);
+
+   /* keep one octet for the ID of the cipher */
+   len = (*outlen > 0) ? *outlen - 1 : 0;
+   err = hash_state_export(chc_desc.ID, fields, 4, md, out, &len);
+   if (err == CRYPT_OK) {
+      out[len] = cipher_descriptor[cipher_idx].ID;
+   }
+   if (err == CRYPT_OK || err == CRYPT_BUFFER_OVERFLOW) {
+      *outlen = len + 1;
+   }
+   return err;
+}
+
+/**
+   Load a hash state serialized by chc_export_state(), the same cipher must be registered
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+int chc_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   ltc_hash_field fields[4];
+   int err;
+
+   LTC_ARGCHK(md != NULL);
+   LTC_ARGCHK(in != NULL);
+
+   if ((err = cipher_is_valid(cipher_idx)) != CRYPT_OK) {
+      return err;
+   }
+   if (inlen == 0 || in[inlen - 1] != cipher_descriptor[cipher_idx].ID) {
+      return CRYPT_INVALID_PACKET;
+   }
+   _chc_fields(fields);
+
+   return hash_state_import(chc_desc.ID, fields, 4, md, in, inlen - 1);
+}
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
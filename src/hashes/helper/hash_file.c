@@ -14,6 +14,17 @@
   Hash a file, Tom St Denis
 */
 
+typedef struct {
+   int        hash;
+   hash_state md;
+} _hash_file_state;
+
+static int _hash_file_process(void *state, const unsigned char *in, unsigned long inlen)
+{
+   _hash_file_state *st = state;
+   return hash_descriptor[st->hash].process(&st->md, in, inlen);
+}
+
 /**
   @param hash   The index of the hash desired
   @param fname  The name of the file you wish to hash
@@ -23,7 +34,7 @@
 */
 int hash_file(int hash, const char *fname, unsigned char *out, unsigned long *outlen)
 {
-    FILE *in;
+    _hash_file_state st;
     int err;
     LTC_ARGCHK(fname  != NULL);
     LTC_ARGCHK(out    != NULL);
@@ -33,16 +44,27 @@ int hash_file(int hash, const char *fname, unsigned char *out, unsigned long *ou
         return err;
     }
 
-    in = fopen(fname, "rb");
-    if (in == NULL) {
-       return CRYPT_FILE_NOTFOUND;
+    if (*outlen < hash_descriptor[hash].hashsize) {
+       *outlen = hash_descriptor[hash].hashsize;
+       return CRYPT_BUFFER_OVERFLOW;
     }
 
-    err = hash_filehandle(hash, in, out, outlen);
-    if (fclose(in) != 0) {
-       return CRYPT_ERROR;
+    st.hash = hash;
+    if ((err = hash_descriptor[hash].init(&st.md)) != CRYPT_OK) {
+       return err;
     }
 
+    if ((err = crypt_process_file(fname, _hash_file_process, &st)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+
+    err = hash_descriptor[hash].done(&st.md, out);
+    *outlen = hash_descriptor[hash].hashsize;
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+    zeromem(&st, sizeof(st));
+#endif
     return err;
 }
 #endif /* #ifndef LTC_NO_FILE */
@@ -0,0 +1,221 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+/* 64-bit file offsets with fseeko()/ftello() also on 32-bit POSIX systems */
+#ifndef _FILE_OFFSET_BITS
+   #define _FILE_OFFSET_BITS 64
+#endif
+#ifndef _LARGEFILE_SOURCE
+   #define _LARGEFILE_SOURCE
+#endif
+#include "tomcrypt.h"
+
+#ifndef LTC_NO_FILE
+/**
+  @file hash_file_tree.c
+  Hash a file as a Merkle tree of fixed-size chunks, on several threads
+
+  Leaf i is H(0x00 || chunk i), an empty file has one empty chunk.  The nodes of the next level
+  are H(0x01 || up to fanout digests of the level below), taken in order, until one digest is
+  left, which is the result.
+*/
+
+typedef struct {
+   int           hash;
+   const char    *fname;
+   unsigned long chunksize, chunks, per;
+   ulong64       size;
+   unsigned char *digests;
+} _hash_tree;
+
+/* seek and tell with offsets of more than 31 bits where the platform has them */
+#if defined(_MSC_VER)
+   typedef __int64 _tree_off;
+   #define _TREE_FSEEK(f, o)  _fseeki64(f, o, SEEK_SET)
+   #define _TREE_FTELL(f)     _ftelli64(f)
+#elif defined(__unix__) || defined(__APPLE__)
+   #include <sys/types.h>
+   typedef off_t _tree_off;
+   #define _TREE_FSEEK(f, o)  fseeko(f, o, SEEK_SET)
+   #define _TREE_FTELL(f)     ftello(f)
+#else
+   typedef long _tree_off;
+   #define _TREE_FSEEK(f, o)  fseek(f, o, SEEK_SET)
+   #define _TREE_FTELL(f)     ftell(f)
+#endif
+
+/* hash the leaves of job idx, the chunks idx * per up to (idx + 1) * per */
+static int _hash_tree_job(void *arg, unsigned long idx)
+{
+   _hash_tree *t = arg;
+   const unsigned char prefix = 0x00;
+   hash_state md;
+   unsigned char *buf;
+   unsigned long c, last;
+   ulong64 off, left;
+   size_t x;
+   FILE *in;
+   int err;
+
+   c = idx * t->per;
+   last = MIN(c + t->per, t->chunks);
+   off = (ulong64)c * t->chunksize;
+
+   if ((buf = XMALLOC(LTC_FILE_READ_BUFSIZE)) == NULL) {
+      return CRYPT_MEM;
+   }
+   if ((in = fopen(t->fname, "rb")) == NULL) {
+      err = CRYPT_FILE_NOTFOUND;
+      goto LBL_ERR;
+   }
+   if ((ulong64)(_tree_off)off != off || _TREE_FSEEK(in, (_tree_off)off) != 0) {
+      err = CRYPT_ERROR;
+      goto LBL_CLOSE;
+   }
+
+   for (; c < last; c++) {
+      if ((err = hash_descriptor[t->hash].init(&md)) != CRYPT_OK) {
+         goto LBL_CLOSE;
+      }
+      if ((err = hash_descriptor[t->hash].process(&md, &prefix, 1)) != CRYPT_OK) {
+         goto LBL_CLOSE;
+      }
+      for (left = MIN(t->chunksize, t->size - off); left > 0; left -= x) {
+         x = fread(buf, 1, (size_t)MIN(left, LTC_FILE_READ_BUFSIZE), in);
+         if (x == 0) {
+            /* the file got shorter */
+            err = CRYPT_ERROR;
+            goto LBL_CLOSE;
+         }
+         if ((err = hash_descriptor[t->hash].process(&md, buf, (unsigned long)x)) != CRYPT_OK) {
+            goto LBL_CLOSE;
+         }
+      }
+      if ((err = hash_descriptor[t->hash].done(&md, t->digests + c * hash_descriptor[t->hash].hashsize)) != CRYPT_OK) {
+         goto LBL_CLOSE;
+      }
+      off += t->chunksize;
+   }
+   err = CRYPT_OK;
+
+LBL_CLOSE:
+   fclose(in);
+LBL_ERR:
+   zeromem(buf, LTC_FILE_READ_BUFSIZE);
+   XFREE(buf);
+   return err;
+}
+
+/**
+  Hash a file as a Merkle tree, the leaves are hashed on several threads
+  @param hash       The index of the hash desired
+  @param fname      The name of the file you wish to hash
+  @param chunksize  The size of the leaves (octets)
+  @param fanout     The number of children of the inner nodes (at least 2)
+  @param threads    The maximum number of jobs hashing leaves in parallel
+  @param exec       The executor that runs the jobs (NULL for the default, see crypt_mt_run())
+  @param exec_ctx   The context passed to the executor
+  @param out        [out] The destination of the root digest
+  @param outlen     [in/out] The max size and resulting size of the digest
+  @return CRYPT_OK if successful
+*/
+int hash_file_tree(int hash, const char *fname, unsigned long chunksize, unsigned long fanout,
+                   unsigned long threads, ltc_mt_executor exec, void *exec_ctx,
+                   unsigned char *out, unsigned long *outlen)
+{
+   const unsigned char prefix = 0x01;
+   _hash_tree t;
+   hash_state md;
+   unsigned long hs, count, j, n;
+   ulong64 chunks;
+   _tree_off size;
+   FILE *in;
+   int err;
+
+   LTC_ARGCHK(fname  != NULL);
+   LTC_ARGCHK(out    != NULL);
+   LTC_ARGCHK(outlen != NULL);
+
+   if ((err = hash_is_valid(hash)) != CRYPT_OK) {
+      return err;
+   }
+   hs = hash_descriptor[hash].hashsize;
+   if (*outlen < hs) {
+      *outlen = hs;
+      return CRYPT_BUFFER_OVERFLOW;
+   }
+   if (chunksize == 0 || fanout < 2) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   if ((in = fopen(fname, "rb")) == NULL) {
+      return CRYPT_FILE_NOTFOUND;
+   }
+   size = -1;
+   if (fseek(in, 0, SEEK_END) == 0) {
+      size = _TREE_FTELL(in);
+   }
+   if (fclose(in) != 0 || size < 0) {
+      return CRYPT_ERROR;
+   }
+
+   t.hash      = hash;
+   t.fname     = fname;
+   t.chunksize = chunksize;
+   t.size      = (ulong64)size;
+   chunks      = (size == 0) ? 1 : (t.size - 1) / chunksize + 1;
+   t.chunks    = (unsigned long)chunks;
+   if (t.chunks != chunks || t.chunks > ULONG_MAX / hs) {
+      return CRYPT_OVERFLOW;
+   }
+
+   /* every job gets the same number of consecutive chunks, except the last one */
+   n = MIN(MAX(threads, 1), t.chunks);
+   t.per = (t.chunks + n - 1) / n;
+   n = (t.chunks + t.per - 1) / t.per;
+
+   if ((t.digests = XCALLOC(t.chunks, hs)) == NULL) {
+      return CRYPT_MEM;
+   }
+   if ((err = crypt_mt_run(exec, exec_ctx, _hash_tree_job, &t, n)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+
+   /* node j of a level overwrites digest j of the level below, which its parent has already consumed */
+   for (count = t.chunks; count > 1; count = (count + fanout - 1) / fanout) {
+      for (j = 0; j * fanout < count; j++) {
+         if ((err = hash_descriptor[hash].init(&md)) != CRYPT_OK) {
+            goto LBL_ERR;
+         }
+         if ((err = hash_descriptor[hash].process(&md, &prefix, 1)) != CRYPT_OK) {
+            goto LBL_ERR;
+         }
+         n = MIN(fanout, count - j * fanout);
+         if ((err = hash_descriptor[hash].process(&md, t.digests + j * fanout * hs, n * hs)) != CRYPT_OK) {
+            goto LBL_ERR;
+         }
+         if ((err = hash_descriptor[hash].done(&md, t.digests + j * hs)) != CRYPT_OK) {
+            goto LBL_ERR;
+         }
+      }
+   }
+
+   XMEMCPY(out, t.digests, hs);
+   *outlen = hs;
+
+LBL_ERR:
+   zeromem(t.digests, t.chunks * hs);
+   XFREE(t.digests);
+   return err;
+}
+#endif /* #ifndef LTC_NO_FILE */
+
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -0,0 +1,171 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file hash_state.c
+  Serialize hash states (midstates), used by the export_state and import_state functions of the hashes
+
+  The format is the ID of the hash descriptor (1 octet), LTC_HASH_STATE_VERSION (1 octet) and the fields
+  of the state in the order of the table, every element stored big endian in the number of octets of its
+  type, which doesn't depend on the platform.
+*/
+
+/* octets per element, indexed by enum ltc_hash_field_type */
+static const unsigned char _hash_field_size[] = { 1, 2, 4, 8, 8 };
+
+static unsigned long _hash_state_size(const ltc_hash_field *fields, unsigned long nfields)
+{
+   unsigned long x, len;
+
+   for (len = 2, x = 0; x < nfields; x++) {
+      len += fields[x].count * _hash_field_size[fields[x].type];
+   }
+   return len;
+}
+
+/**
+  Serialize a hash state
+  @param id      The ID of the hash descriptor
+  @param fields  The fields of the state
+  @param nfields The number of fields
+  @param md      The hash state
+  @param out     [out] The destination of the serialized state
+  @param outlen  [in/out] The max size and resulting size of the serialized state
+  @return CRYPT_OK if successful
+*/
+int hash_state_export(unsigned char id, const ltc_hash_field *fields, unsigned long nfields,
+                      const hash_state *md, unsigned char *out, unsigned long *outlen)
+{
+   const unsigned char *p;
+   unsigned long x, y, len;
+   ulong64 v;
+
+   LTC_ARGCHK(fields != NULL);
+   LTC_ARGCHK(md     != NULL);
+   LTC_ARGCHK(out    != NULL);
+   LTC_ARGCHK(outlen != NULL);
+
+   len = _hash_state_size(fields, nfields);
+   if (*outlen < len) {
+      *outlen = len;
+      return CRYPT_BUFFER_OVERFLOW;
+   }
+
+   out[0] = id;
+   out[1] = LTC_HASH_STATE_VERSION;
+   out += 2;
+   for (x = 0; x < nfields; x++) {
+      p = (const unsigned char *)md + fields[x].offset;
+      for (y = 0; y < fields[x].count; y++) {
+         switch (fields[x].type) {
+            case LTC_HASH_U8:
+               *out++ = p[y];
+               break;
+            case LTC_HASH_U16:
+               v = ((const unsigned short *)p)[y];
+               out[0] = (unsigned char)(v >> 8);
+               out[1] = (unsigned char)v;
+               out += 2;
+               break;
+            case LTC_HASH_U32:
+               STORE32H(((const ulong32 *)p)[y], out);
+               out += 4;
+               break;
+            case LTC_HASH_U64:
+               STORE64H(((const ulong64 *)p)[y], out);
+               out += 8;
+               break;
+            default:
+               v = ((const unsigned long *)p)[y];
+               STORE64H(v, out);
+               out += 8;
+               break;
+         }
+      }
+   }
+   *outlen = len;
+   return CRYPT_OK;
+}
+
+/**
+  Load a hash state serialized by hash_state_export(), the fields that aren't serialized are zeroed
+  @param id      The ID of the hash descriptor
+  @param fields  The fields of the state
+  @param nfields The number of fields
+  @param md      [out] The hash state
+  @param in      The serialized state
+  @param inlen   The length of the serialized state (octets)
+  @return CRYPT_OK if successful, CRYPT_INVALID_PACKET if the input isn't a valid state of this hash
+*/
+int hash_state_import(unsigned char id, const ltc_hash_field *fields, unsigned long nfields,
+                      hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   unsigned char *p;
+   unsigned long x, y;
+   ulong64 v;
+
+   LTC_ARGCHK(fields != NULL);
+   LTC_ARGCHK(md     != NULL);
+   LTC_ARGCHK(in     != NULL);
+
+   if (inlen != _hash_state_size(fields, nfields) || in[0] != id || in[1] != LTC_HASH_STATE_VERSION) {
+      return CRYPT_INVALID_PACKET;
+   }
+
+   zeromem(md, sizeof(*md));
+   in += 2;
+   for (x = 0; x < nfields; x++) {
+      p = (unsigned char *)md + fields[x].offset;
+      for (y = 0; y < fields[x].count; y++) {
+         switch (fields[x].type) {
+            case LTC_HASH_U8:
+               v = *in++;
+               p[y] = (unsigned char)v;
+               break;
+            case LTC_HASH_U16:
+               v = ((ulong64)in[0] << 8) | in[1];
+               ((unsigned short *)p)[y] = (unsigned short)v;
+               in += 2;
+               break;
+            case LTC_HASH_U32:
+               LOAD32H(((ulong32 *)p)[y], in);
+               v = ((ulong32 *)p)[y];
+               in += 4;
+               break;
+            case LTC_HASH_U64:
+               LOAD64H(v, in);
+               ((ulong64 *)p)[y] = v;
+               in += 8;
+               break;
+            default:
+               LOAD64H(v, in);
+               if ((ulong64)(unsigned long)v != v) {
+                  goto LBL_ERR;
+               }
+               ((unsigned long *)p)[y] = (unsigned long)v;
+               in += 8;
+               break;
+         }
+         if (fields[x].max != 0 && v > fields[x].max) {
+            goto LBL_ERR;
+         }
+      }
+   }
+   return CRYPT_OK;
+
+LBL_ERR:
+   zeromem(md, sizeof(*md));
+   return CRYPT_INVALID_PACKET;
+}
+
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
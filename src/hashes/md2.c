@@ -30,7 +30,10 @@ const struct ltc_hash_descriptor md2_desc =
     &md2_process,
     &md2_done,
     &md2_test,
-    NULL
+    NULL,
+    &md2_clone,
+    &md2_export_state,
+    &md2_import_state
 };
 
 static const unsigned char PI_SUBST[256] = {
@@ -181,6 +184,39 @@ int md2_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _md2_fields[] = {
+   { offsetof(hash_state, md2.chksum), LTC_HASH_U8,    16,  0 },
+   { offsetof(hash_state, md2.X),      LTC_HASH_U8,    48,  0 },
+   { offsetof(hash_state, md2.curlen), LTC_HASH_ULONG,  1, 15 },
+   { offsetof(hash_state, md2.buf),    LTC_HASH_U8,    16,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(md2_clone, md2)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(md2_export_state, md2_desc, _md2_fields)
+
+/**
+   Load a hash state serialized by md2_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(md2_import_state, md2_desc, _md2_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
@@ -30,7 +30,10 @@ const struct ltc_hash_descriptor md4_desc =
     &md4_process,
     &md4_done,
     &md4_test,
-    NULL
+    NULL,
+    &md4_clone,
+    &md4_export_state,
+    &md4_import_state
 };
 
 #define S11 3
@@ -244,6 +247,39 @@ int md4_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _md4_fields[] = {
+   { offsetof(hash_state, md4.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, md4.state),  LTC_HASH_U32,  4,  0 },
+   { offsetof(hash_state, md4.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, md4.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(md4_clone, md4)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(md4_export_state, md4_desc, _md4_fields)
+
+/**
+   Load a hash state serialized by md4_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(md4_import_state, md4_desc, _md4_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
@@ -31,7 +31,10 @@ const struct ltc_hash_descriptor md5_desc =
     &md5_process,
     &md5_done,
     &md5_test,
-    NULL
+    NULL,
+    &md5_clone,
+    &md5_export_state,
+    &md5_import_state
 };
 
 #define F(x,y,z)  (z ^ (x & (y ^ z)))
@@ -304,6 +307,39 @@ int md5_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _md5_fields[] = {
+   { offsetof(hash_state, md5.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, md5.state),  LTC_HASH_U32,  4,  0 },
+   { offsetof(hash_state, md5.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, md5.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(md5_clone, md5)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(md5_export_state, md5_desc, _md5_fields)
+
+/**
+   Load a hash state serialized by md5_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(md5_import_state, md5_desc, _md5_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
@@ -36,7 +36,10 @@ const struct ltc_hash_descriptor rmd128_desc =
     &rmd128_process,
     &rmd128_done,
     &rmd128_test,
-    NULL
+    NULL,
+    &rmd128_clone,
+    &rmd128_export_state,
+    &rmd128_import_state
 };
 
 /* the four basic functions F(), G() and H() */
@@ -343,6 +346,39 @@ int rmd128_done(hash_state * md, unsigned char *out)
    return CRYPT_OK;
 }
 
+static const ltc_hash_field _rmd128_fields[] = {
+   { offsetof(hash_state, rmd128.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, rmd128.state),  LTC_HASH_U32,  4,  0 },
+   { offsetof(hash_state, rmd128.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, rmd128.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(rmd128_clone, rmd128)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(rmd128_export_state, rmd128_desc, _rmd128_fields)
+
+/**
+   Load a hash state serialized by rmd128_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(rmd128_import_state, rmd128_desc, _rmd128_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
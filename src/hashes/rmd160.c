@@ -36,7 +36,10 @@ const struct ltc_hash_descriptor rmd160_desc =
     &rmd160_process,
     &rmd160_done,
     &rmd160_test,
-    NULL
+    NULL,
+    &rmd160_clone,
+    &rmd160_export_state,
+    &rmd160_import_state
 };
 
 /* the five basic functions F(), G() and H() */
@@ -402,6 +405,39 @@ int rmd160_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _rmd160_fields[] = {
+   { offsetof(hash_state, rmd160.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, rmd160.state),  LTC_HASH_U32,  5,  0 },
+   { offsetof(hash_state, rmd160.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, rmd160.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(rmd160_clone, rmd160)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(rmd160_export_state, rmd160_desc, _rmd160_fields)
+
+/**
+   Load a hash state serialized by rmd160_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(rmd160_import_state, rmd160_desc, _rmd160_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
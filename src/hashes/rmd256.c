@@ -30,7 +30,10 @@ const struct ltc_hash_descriptor rmd256_desc =
     &rmd256_process,
     &rmd256_done,
     &rmd256_test,
-    NULL
+    NULL,
+    &rmd256_clone,
+    &rmd256_export_state,
+    &rmd256_import_state
 };
 
 /* the four basic functions F(), G() and H() */
@@ -356,6 +359,39 @@ int rmd256_done(hash_state * md, unsigned char *out)
    return CRYPT_OK;
 }
 
+static const ltc_hash_field _rmd256_fields[] = {
+   { offsetof(hash_state, rmd256.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, rmd256.state),  LTC_HASH_U32,  8,  0 },
+   { offsetof(hash_state, rmd256.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, rmd256.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(rmd256_clone, rmd256)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(rmd256_export_state, rmd256_desc, _rmd256_fields)
+
+/**
+   Load a hash state serialized by rmd256_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(rmd256_import_state, rmd256_desc, _rmd256_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
@@ -31,7 +31,10 @@ const struct ltc_hash_descriptor rmd320_desc =
     &rmd320_process,
     &rmd320_done,
     &rmd320_test,
-    NULL
+    NULL,
+    &rmd320_clone,
+    &rmd320_export_state,
+    &rmd320_import_state
 };
 
 /* the five basic functions F(), G() and H() */
@@ -421,6 +424,39 @@ int rmd320_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _rmd320_fields[] = {
+   { offsetof(hash_state, rmd320.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, rmd320.state),  LTC_HASH_U32, 10,  0 },
+   { offsetof(hash_state, rmd320.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, rmd320.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(rmd320_clone, rmd320)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(rmd320_export_state, rmd320_desc, _rmd320_fields)
+
+/**
+   Load a hash state serialized by rmd320_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(rmd320_import_state, rmd320_desc, _rmd320_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
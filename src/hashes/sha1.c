@@ -31,7 +31,10 @@ const struct ltc_hash_descriptor sha1_desc =
     &sha1_process,
     &sha1_done,
     &sha1_test,
-    NULL
+    NULL,
+    &sha1_clone,
+    &sha1_export_state,
+    &sha1_import_state
 };
 
 #define F0(x,y,z)  (z ^ (x & (y ^ z)))
@@ -50,6 +53,12 @@ static int  sha1_compress(hash_state *md, unsigned char *buf)
     ulong32 t;
 #endif
 
+#ifdef LTC_SHA_NI
+    if (sha_ni_is_supported()) {
+        return sha1_ni_compress(md, buf);
+    }
+#endif
+
     /* copy the state into 512-bits into W[0..15] */
     for (i = 0; i < 16; i++) {
         LOAD32H(W[i], buf + (4*i));
@@ -236,6 +245,39 @@ int sha1_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _sha1_fields[] = {
+   { offsetof(hash_state, sha1.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, sha1.state),  LTC_HASH_U32,  5,  0 },
+   { offsetof(hash_state, sha1.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, sha1.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(sha1_clone, sha1)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(sha1_export_state, sha1_desc, _sha1_fields)
+
+/**
+   Load a hash state serialized by sha1_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(sha1_import_state, sha1_desc, _sha1_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
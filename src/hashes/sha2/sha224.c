@@ -30,7 +30,10 @@ const struct ltc_hash_descriptor sha224_desc =
     &sha256_process,
     &sha224_done,
     &sha224_test,
-    NULL
+    NULL,
+    &sha256_clone,
+    &sha224_export_state,
+    &sha224_import_state
 };
 
 /* init the sha256 er... sha224 state ;-) */
@@ -78,6 +81,31 @@ int sha224_done(hash_state * md, unsigned char *out)
     return err;
 }
 
+static const ltc_hash_field _sha224_fields[] = {
+   { offsetof(hash_state, sha256.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, sha256.state),  LTC_HASH_U32,  8,  0 },
+   { offsetof(hash_state, sha256.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, sha256.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(sha224_export_state, sha224_desc, _sha224_fields)
+
+/**
+   Load a hash state serialized by sha224_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(sha224_import_state, sha224_desc, _sha224_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
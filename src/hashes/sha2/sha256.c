@@ -30,7 +30,10 @@ const struct ltc_hash_descriptor sha256_desc =
     &sha256_process,
     &sha256_done,
     &sha256_test,
-    NULL
+    NULL,
+    &sha256_clone,
+    &sha256_export_state,
+    &sha256_import_state
 };
 
 #ifdef LTC_SMALL_CODE
@@ -75,6 +78,12 @@ static int  sha256_compress(hash_state * md, unsigned char *buf)
 #endif
     int i;
 
+#ifdef LTC_SHA_NI
+    if (sha_ni_is_supported()) {
+        return sha256_ni_compress(md, buf);
+    }
+#endif
+
     /* copy state into S */
     for (i = 0; i < 8; i++) {
         S[i] = md->sha256.state[i];
@@ -282,6 +291,39 @@ int sha256_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _sha256_fields[] = {
+   { offsetof(hash_state, sha256.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, sha256.state),  LTC_HASH_U32,  8,  0 },
+   { offsetof(hash_state, sha256.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, sha256.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(sha256_clone, sha256)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(sha256_export_state, sha256_desc, _sha256_fields)
+
+/**
+   Load a hash state serialized by sha256_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(sha256_import_state, sha256_desc, _sha256_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
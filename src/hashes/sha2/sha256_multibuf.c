@@ -0,0 +1,372 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file sha256_multibuf.c
+  SHA-256 of many independent messages at once
+
+  Each 32-bit lane of a vector register holds the state of another message, so 4, 8 or 16
+  messages are compressed at once with SSE2, AVX2 or AVX-512.  A lane that has finished its
+  message (including the padding) takes the next one, so messages of different lengths keep
+  all lanes busy until the last few.  The last remaining message is finished with sha256_process().
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_SHA256
+
+#ifdef LTC_SHA256_MULTIBUF_SIMD
+
+/* see chacha_simd.c */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+#define SHA256_MB_MAX_LANES 16
+
+static const ulong32 K[64] = {
+    0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL,
+    0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL, 0xd807aa98UL, 0x12835b01UL,
+    0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL,
+    0xc19bf174UL, 0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL,
+    0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL, 0x983e5152UL,
+    0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL,
+    0x06ca6351UL, 0x14292967UL, 0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL,
+    0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+    0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL,
+    0xd6990624UL, 0xf40e3585UL, 0x106aa070UL, 0x19a4c116UL, 0x1e376c08UL,
+    0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL,
+    0x682e6ff3UL, 0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL,
+    0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
+};
+
+/* the rounds are written with the V_* operations, which every instruction set below defines */
+#define MB_Ch(x,y,z)    V_XOR(V_AND(x, y), V_ANDN(x, z))
+#define MB_Maj(x,y,z)   V_OR(V_AND(V_OR(x, y), z), V_AND(x, y))
+#define MB_Sigma0(x)    V_XOR(V_XOR(V_ROR(x, 2), V_ROR(x, 13)), V_ROR(x, 22))
+#define MB_Sigma1(x)    V_XOR(V_XOR(V_ROR(x, 6), V_ROR(x, 11)), V_ROR(x, 25))
+#define MB_Gamma0(x)    V_XOR(V_XOR(V_ROR(x, 7), V_ROR(x, 18)), V_SHR(x, 3))
+#define MB_Gamma1(x)    V_XOR(V_XOR(V_ROR(x, 17), V_ROR(x, 19)), V_SHR(x, 10))
+
+/* round i + j, the message word is w[j] as i is a multiple of 16 */
+#define MB_RND(a,b,c,d,e,f,g,h,i,j)                                                       \
+   if ((i) > 0) {                                                                         \
+      w[j] = V_ADD(V_ADD(w[j], MB_Gamma1(w[((j) + 14) & 15])),                            \
+                   V_ADD(w[((j) + 9) & 15], MB_Gamma0(w[((j) + 1) & 15])));               \
+   }                                                                                      \
+   t0 = V_ADD(V_ADD(h, MB_Sigma1(e)), V_ADD(MB_Ch(e, f, g), V_ADD(V_SET1(K[(i) + (j)]), w[j]))); \
+   t1 = V_ADD(MB_Sigma0(a), MB_Maj(a, b, c));                                             \
+   d = V_ADD(d, t0);                                                                      \
+   h = V_ADD(t0, t1);
+
+#define MB_RND8(i, j)                                                                     \
+   MB_RND(s[0],s[1],s[2],s[3],s[4],s[5],s[6],s[7],i,(j)+0)                                \
+   MB_RND(s[7],s[0],s[1],s[2],s[3],s[4],s[5],s[6],i,(j)+1)                                \
+   MB_RND(s[6],s[7],s[0],s[1],s[2],s[3],s[4],s[5],i,(j)+2)                                \
+   MB_RND(s[5],s[6],s[7],s[0],s[1],s[2],s[3],s[4],i,(j)+3)                                \
+   MB_RND(s[4],s[5],s[6],s[7],s[0],s[1],s[2],s[3],i,(j)+4)                                \
+   MB_RND(s[3],s[4],s[5],s[6],s[7],s[0],s[1],s[2],i,(j)+5)                                \
+   MB_RND(s[2],s[3],s[4],s[5],s[6],s[7],s[0],s[1],i,(j)+6)                                \
+   MB_RND(s[1],s[2],s[3],s[4],s[5],s[6],s[7],s[0],i,(j)+7)
+
+/* compress one block of every lane, S holds the eight state words and W the 16 message words of each lane */
+#define MB_COMPRESS(name, target, V, N)                                                   \
+LTC_TARGET(target)                                                                        \
+static void name(ulong32 *S, const ulong32 *W)                                            \
+{                                                                                         \
+   V s[8], w[16], t0, t1;                                                                 \
+   int i;                                                                                 \
+                                                                                          \
+   for (i = 0; i < 8; i++) {                                                              \
+      s[i] = V_LOAD(S + i * (N));                                                         \
+   }                                                                                      \
+   for (i = 0; i < 16; i++) {                                                             \
+      w[i] = V_LOAD(W + i * (N));                                                         \
+   }                                                                                      \
+   for (i = 0; i < 64; i += 16) {                                                         \
+      MB_RND8(i, 0)                                                                       \
+      MB_RND8(i, 8)                                                                       \
+   }                                                                                      \
+   for (i = 0; i < 8; i++) {                                                              \
+      V_STORE(S + i * (N), V_ADD(s[i], V_LOAD(S + i * (N))));                             \
+   }                                                                                      \
+}
+
+/* ---- SSE2, 4 lanes ---- */
+
+#define V_LOAD(p)       _mm_loadu_si128((const __m128i*)(const void*)(p))
+#define V_STORE(p, x)   _mm_storeu_si128((__m128i*)(void*)(p), x)
+#define V_SET1(x)       _mm_set1_epi32((int)(x))
+#define V_ADD(x, y)     _mm_add_epi32(x, y)
+#define V_XOR(x, y)     _mm_xor_si128(x, y)
+#define V_AND(x, y)     _mm_and_si128(x, y)
+#define V_ANDN(x, y)    _mm_andnot_si128(x, y)
+#define V_OR(x, y)      _mm_or_si128(x, y)
+#define V_SHR(x, n)     _mm_srli_epi32(x, n)
+#define V_ROR(x, n)     _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - (n)))
+
+MB_COMPRESS(_sha256_x4, "sse2", __m128i, 4)
+
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_ANDN
+#undef V_OR
+#undef V_SHR
+#undef V_ROR
+
+/* ---- AVX2, 8 lanes ---- */
+
+#define V_LOAD(p)       _mm256_loadu_si256((const __m256i*)(const void*)(p))
+#define V_STORE(p, x)   _mm256_storeu_si256((__m256i*)(void*)(p), x)
+#define V_SET1(x)       _mm256_set1_epi32((int)(x))
+#define V_ADD(x, y)     _mm256_add_epi32(x, y)
+#define V_XOR(x, y)     _mm256_xor_si256(x, y)
+#define V_AND(x, y)     _mm256_and_si256(x, y)
+#define V_ANDN(x, y)    _mm256_andnot_si256(x, y)
+#define V_OR(x, y)      _mm256_or_si256(x, y)
+#define V_SHR(x, n)     _mm256_srli_epi32(x, n)
+#define V_ROR(x, n)     _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+MB_COMPRESS(_sha256_x8, "avx2", __m256i, 8)
+
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_ANDN
+#undef V_OR
+#undef V_SHR
+#undef V_ROR
+
+/* ---- AVX-512, 16 lanes ---- */
+
+#define V_LOAD(p)       _mm512_loadu_si512((const void*)(p))
+#define V_STORE(p, x)   _mm512_storeu_si512((void*)(p), x)
+#define V_SET1(x)       _mm512_set1_epi32((int)(x))
+#define V_ADD(x, y)     _mm512_add_epi32(x, y)
+#define V_XOR(x, y)     _mm512_xor_si512(x, y)
+#define V_AND(x, y)     _mm512_and_si512(x, y)
+#define V_ANDN(x, y)    _mm512_andnot_si512(x, y)
+#define V_OR(x, y)      _mm512_or_si512(x, y)
+#define V_SHR(x, n)     _mm512_srli_epi32(x, n)
+#define V_ROR(x, n)     _mm512_ror_epi32(x, n)
+
+MB_COMPRESS(_sha256_x16, "avx512f", __m512i, 16)
+
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_ADD
+#undef V_XOR
+#undef V_AND
+#undef V_ANDN
+#undef V_OR
+#undef V_SHR
+#undef V_ROR
+
+typedef struct {
+   const unsigned char *in;      /* the whole blocks of the message not processed yet */
+   unsigned long blocks;
+   unsigned char tail[128];      /* the rest of the message and the padding */
+   int tailblocks, tailpos;
+   int idx;                      /* the message in this lane, -1 if the lane is idle */
+} _sha256_lane;
+
+/* start message idx in lane l */
+static void _sha256_lane_start(_sha256_lane *lane, ulong32 *S, int N, int l, int idx,
+                               const unsigned char *in, unsigned long inlen)
+{
+   static const ulong32 IV[8] = {
+      0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+      0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+   };
+   unsigned long r;
+   int i;
+
+   lane->in = in;
+   lane->blocks = inlen / 64;
+   r = inlen % 64;
+   XMEMSET(lane->tail, 0, sizeof(lane->tail));
+   XMEMCPY(lane->tail, in + lane->blocks * 64, r);
+   lane->tail[r] = 0x80;
+   lane->tailblocks = (r < 56) ? 1 : 2;
+   lane->tailpos = 0;
+   STORE64H((ulong64)inlen * 8, lane->tail + lane->tailblocks * 64 - 8);
+   lane->idx = idx;
+   for (i = 0; i < 8; i++) {
+      S[i * N + l] = IV[i];
+   }
+}
+
+static int _sha256_multibuf_simd(const unsigned char **in, const unsigned long *inlen, unsigned char **out, int n)
+{
+   _sha256_lane lane[SHA256_MB_MAX_LANES];
+   ulong32 S[8 * SHA256_MB_MAX_LANES], W[16 * SHA256_MB_MAX_LANES];
+   void (*compress)(ulong32 *, const ulong32 *);
+   const unsigned char *p;
+   hash_state md;
+   unsigned long cpu;
+   int N, l, i, next, active, err;
+
+   cpu = crypt_cpu_features();
+#ifdef LTC_SHA_NI
+   /* one message after the other with the SHA extensions is faster than 4 or 8 lanes */
+   if (sha_ni_is_supported()) {
+      cpu &= ~(LTC_CPU_AVX2 | LTC_CPU_SSE2);
+   }
+#endif
+   if ((cpu & LTC_CPU_AVX512F) && n >= 12) {
+      N = 16;
+      compress = _sha256_x16;
+   } else if ((cpu & LTC_CPU_AVX2) && n >= 6) {
+      N = 8;
+      compress = _sha256_x8;
+   } else if ((cpu & LTC_CPU_SSE2) && n >= 3) {
+      N = 4;
+      compress = _sha256_x4;
+   } else {
+      return CRYPT_NOP;
+   }
+
+   /* idle lanes compress whatever is left in W */
+   zeromem(W, sizeof(W));
+   for (l = 0, next = 0; l < N; l++) {
+      if (next < n) {
+         _sha256_lane_start(&lane[l], S, N, l, next, in[next], inlen[next]);
+         next++;
+      } else {
+         lane[l].idx = -1;
+      }
+   }
+   active = MIN(n, N);
+   err = CRYPT_OK;
+
+   while (active > 0) {
+      /* finish a long straggler on its own instead of compressing N lanes for one */
+      if (active == 1) {
+         l = 0;
+         while (lane[l].idx < 0) {
+            l++;
+         }
+         if (lane[l].blocks > 1) {
+            sha256_init(&md);
+            for (i = 0; i < 8; i++) {
+               md.sha256.state[i] = S[i * N + l];
+            }
+            md.sha256.length = (ulong64)(lane[l].in - in[lane[l].idx]) * 8;
+            if ((err = sha256_process(&md, lane[l].in, inlen[lane[l].idx] - (unsigned long)(lane[l].in - in[lane[l].idx]))) != CRYPT_OK ||
+                (err = sha256_done(&md, out[lane[l].idx])) != CRYPT_OK) {
+               goto done;
+            }
+            break;
+         }
+      }
+
+      /* transpose the next block of every lane into W */
+      for (l = 0; l < N; l++) {
+         if (lane[l].idx < 0) {
+            continue;
+         }
+         if (lane[l].blocks > 0) {
+            p = lane[l].in;
+            lane[l].in += 64;
+            lane[l].blocks--;
+         } else {
+            p = lane[l].tail + 64 * lane[l].tailpos++;
+         }
+         for (i = 0; i < 16; i++) {
+            LOAD32H(W[i * N + l], p + 4 * i);
+         }
+      }
+
+      compress(S, W);
+
+      /* store the finished digests and refill the lanes */
+      for (l = 0; l < N; l++) {
+         if (lane[l].idx < 0 || lane[l].blocks > 0 || lane[l].tailpos < lane[l].tailblocks) {
+            continue;
+         }
+         for (i = 0; i < 8; i++) {
+            STORE32H(S[i * N + l], out[lane[l].idx] + 4 * i);
+         }
+         if (next < n) {
+            _sha256_lane_start(&lane[l], S, N, l, next, in[next], inlen[next]);
+            next++;
+         } else {
+            lane[l].idx = -1;
+            active--;
+         }
+      }
+   }
+
+done:
+#ifdef LTC_CLEAN_STACK
+   zeromem(lane, sizeof(lane));
+   zeromem(S, sizeof(S));
+   zeromem(W, sizeof(W));
+   zeromem(&md, sizeof(md));
+#endif
+   return err;
+}
+
+#endif /* LTC_SHA256_MULTIBUF_SIMD */
+
+/**
+  Hash several independent messages with SHA-256, the same as calling hash_memory() for each of them
+  @param in      The messages
+  @param inlen   The lengths of the messages (octets)
+  @param out     [out] The destinations of the digests (32 bytes each)
+  @param n       The number of messages
+  @return CRYPT_OK if successful
+*/
+int sha256_memory_multibuf(const unsigned char **in, const unsigned long *inlen, unsigned char **out, int n)
+{
+   hash_state md;
+   int i, err;
+
+   LTC_ARGCHK(in    != NULL);
+   LTC_ARGCHK(inlen != NULL);
+   LTC_ARGCHK(out   != NULL);
+
+   if (n < 0) {
+      return CRYPT_INVALID_ARG;
+   }
+
+#ifdef LTC_SHA256_MULTIBUF_SIMD
+   if ((err = _sha256_multibuf_simd(in, inlen, out, n)) != CRYPT_NOP) {
+      return err;
+   }
+#endif
+
+   err = CRYPT_OK;
+   for (i = 0; i < n; i++) {
+      if ((err = sha256_init(&md)) != CRYPT_OK ||
+          (err = sha256_process(&md, in[i], inlen[i])) != CRYPT_OK ||
+          (err = sha256_done(&md, out[i])) != CRYPT_OK) {
+         break;
+      }
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(&md, sizeof(md));
+#endif
+   return err;
+}
+
+#endif /* LTC_SHA256 */
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -30,7 +30,10 @@ const struct ltc_hash_descriptor sha512_desc =
     &sha512_process,
     &sha512_done,
     &sha512_test,
-    NULL
+    NULL,
+    &sha512_clone,
+    &sha512_export_state,
+    &sha512_import_state
 };
 
 /* the K array */
@@ -97,6 +100,12 @@ static int  sha512_compress(hash_state * md, unsigned char *buf)
     ulong64 S[8], W[80], t0, t1;
     int i;
 
+#ifdef LTC_SHA512_AVX2
+    if (sha512_avx2_is_supported()) {
+        return sha512_avx2_compress(md, buf);
+    }
+#endif
+
     /* copy state into S */
     for (i = 0; i < 8; i++) {
         S[i] = md->sha512.state[i];
@@ -252,6 +261,39 @@ int sha512_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _sha512_fields[] = {
+   { offsetof(hash_state, sha512.length), LTC_HASH_U64,     1,   0 },
+   { offsetof(hash_state, sha512.state),  LTC_HASH_U64,     8,   0 },
+   { offsetof(hash_state, sha512.curlen), LTC_HASH_ULONG,   1, 127 },
+   { offsetof(hash_state, sha512.buf),    LTC_HASH_U8,    128,   0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(sha512_clone, sha512)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(sha512_export_state, sha512_desc, _sha512_fields)
+
+/**
+   Load a hash state serialized by sha512_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(sha512_import_state, sha512_desc, _sha512_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
@@ -30,7 +30,10 @@ const struct ltc_hash_descriptor sha512_256_desc =
     &sha512_process,
     &sha512_256_done,
     &sha512_256_test,
-    NULL
+    NULL,
+    &sha512_clone,
+    &sha512_256_export_state,
+    &sha512_256_import_state
 };
 
 /**
@@ -80,6 +83,31 @@ int sha512_256_done(hash_state * md, unsigned char *out)
    return CRYPT_OK;
 }
 
+static const ltc_hash_field _sha512_256_fields[] = {
+   { offsetof(hash_state, sha512.length), LTC_HASH_U64,     1,   0 },
+   { offsetof(hash_state, sha512.state),  LTC_HASH_U64,     8,   0 },
+   { offsetof(hash_state, sha512.curlen), LTC_HASH_ULONG,   1, 127 },
+   { offsetof(hash_state, sha512.buf),    LTC_HASH_U8,    128,   0 }
+};
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(sha512_256_export_state, sha512_256_desc, _sha512_256_fields)
+
+/**
+   Load a hash state serialized by sha512_256_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(sha512_256_import_state, sha512_256_desc, _sha512_256_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
@@ -0,0 +1,175 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file sha512_avx2.c
+  SHA-512 compression with AVX2 and BMI2
+
+  The message schedule is expanded four words at a time in AVX2 registers, 16 words ahead of the
+  rounds, and stored with the round constants already added.  The rounds stay scalar, but are
+  compiled for BMI2 so the rotations become RORX, which does not touch the flags and leaves the
+  source intact.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_SHA512_AVX2
+
+/* see chacha_simd.c */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+static const ulong64 K[80] = {
+CONST64(0x428a2f98d728ae22), CONST64(0x7137449123ef65cd),
+CONST64(0xb5c0fbcfec4d3b2f), CONST64(0xe9b5dba58189dbbc),
+CONST64(0x3956c25bf348b538), CONST64(0x59f111f1b605d019),
+CONST64(0x923f82a4af194f9b), CONST64(0xab1c5ed5da6d8118),
+CONST64(0xd807aa98a3030242), CONST64(0x12835b0145706fbe),
+CONST64(0x243185be4ee4b28c), CONST64(0x550c7dc3d5ffb4e2),
+CONST64(0x72be5d74f27b896f), CONST64(0x80deb1fe3b1696b1),
+CONST64(0x9bdc06a725c71235), CONST64(0xc19bf174cf692694),
+CONST64(0xe49b69c19ef14ad2), CONST64(0xefbe4786384f25e3),
+CONST64(0x0fc19dc68b8cd5b5), CONST64(0x240ca1cc77ac9c65),
+CONST64(0x2de92c6f592b0275), CONST64(0x4a7484aa6ea6e483),
+CONST64(0x5cb0a9dcbd41fbd4), CONST64(0x76f988da831153b5),
+CONST64(0x983e5152ee66dfab), CONST64(0xa831c66d2db43210),
+CONST64(0xb00327c898fb213f), CONST64(0xbf597fc7beef0ee4),
+CONST64(0xc6e00bf33da88fc2), CONST64(0xd5a79147930aa725),
+CONST64(0x06ca6351e003826f), CONST64(0x142929670a0e6e70),
+CONST64(0x27b70a8546d22ffc), CONST64(0x2e1b21385c26c926),
+CONST64(0x4d2c6dfc5ac42aed), CONST64(0x53380d139d95b3df),
+CONST64(0x650a73548baf63de), CONST64(0x766a0abb3c77b2a8),
+CONST64(0x81c2c92e47edaee6), CONST64(0x92722c851482353b),
+CONST64(0xa2bfe8a14cf10364), CONST64(0xa81a664bbc423001),
+CONST64(0xc24b8b70d0f89791), CONST64(0xc76c51a30654be30),
+CONST64(0xd192e819d6ef5218), CONST64(0xd69906245565a910),
+CONST64(0xf40e35855771202a), CONST64(0x106aa07032bbd1b8),
+CONST64(0x19a4c116b8d2d0c8), CONST64(0x1e376c085141ab53),
+CONST64(0x2748774cdf8eeb99), CONST64(0x34b0bcb5e19b48a8),
+CONST64(0x391c0cb3c5c95a63), CONST64(0x4ed8aa4ae3418acb),
+CONST64(0x5b9cca4f7763e373), CONST64(0x682e6ff3d6b2b8a3),
+CONST64(0x748f82ee5defb2fc), CONST64(0x78a5636f43172f60),
+CONST64(0x84c87814a1f0ab72), CONST64(0x8cc702081a6439ec),
+CONST64(0x90befffa23631e28), CONST64(0xa4506cebde82bde9),
+CONST64(0xbef9a3f7b2c67915), CONST64(0xc67178f2e372532b),
+CONST64(0xca273eceea26619c), CONST64(0xd186b8c721c0c207),
+CONST64(0xeada7dd6cde0eb1e), CONST64(0xf57d4f7fee6ed178),
+CONST64(0x06f067aa72176fba), CONST64(0x0a637dc5a2c898a6),
+CONST64(0x113f9804bef90dae), CONST64(0x1b710b35131c471b),
+CONST64(0x28db77f523047d84), CONST64(0x32caab7b40c72493),
+CONST64(0x3c9ebe0a15c9bebc), CONST64(0x431d67c49c100d4c),
+CONST64(0x4cc5d4becb3e42b6), CONST64(0x597f299cfc657e2a),
+CONST64(0x5fcb6fab3ad6faec), CONST64(0x6c44198c4a475817)
+};
+
+#define SHA512_AVX2_TARGET LTC_TARGET("avx2,bmi2")
+
+/* plain C rotations, with BMI2 enabled the compiler emits RORX for them */
+#define S(x, n)         (((x) >> (n)) | ((x) << (64 - (n))))
+#define Ch(x,y,z)       (z ^ (x & (y ^ z)))
+#define Maj(x,y,z)      (((x | y) & z) | (x & y))
+#define Sigma0(x)       (S(x, 28) ^ S(x, 34) ^ S(x, 39))
+#define Sigma1(x)       (S(x, 14) ^ S(x, 18) ^ S(x, 41))
+
+#define V_ROR(x, n)     _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - (n)))
+#define V_Gamma0(x)     _mm256_xor_si256(_mm256_xor_si256(V_ROR(x, 1), V_ROR(x, 8)), _mm256_srli_epi64(x, 7))
+#define V_Gamma1(x)     _mm256_xor_si256(_mm256_xor_si256(V_ROR(x, 19), V_ROR(x, 61)), _mm256_srli_epi64(x, 6))
+
+/**
+  Check whether the CPU supports AVX2 and BMI2
+  @return 1 if sha512_avx2_compress() can be used, 0 otherwise
+*/
+int sha512_avx2_is_supported(void)
+{
+   const unsigned long need = LTC_CPU_AVX2 | LTC_CPU_BMI2;
+   return (crypt_cpu_features() & need) == need;
+}
+
+/**
+  Compress one block with SHA-512
+  @param md    The hash state
+  @param buf   The 128 byte block
+  @return CRYPT_OK
+*/
+SHA512_AVX2_TARGET
+int sha512_avx2_compress(hash_state *md, const unsigned char *buf)
+{
+   const __m256i bswap = _mm256_set_epi64x(0x08090a0b0c0d0e0fLL, 0x0001020304050607LL,
+                                           0x08090a0b0c0d0e0fLL, 0x0001020304050607LL);
+   const __m256i lo = _mm256_set_epi64x(0, 0, -1, -1);
+   ulong64 W[80], WK[80], S[8], t0, t1;
+   __m256i x, y;
+   int i;
+
+   for (i = 0; i < 16; i += 4) {
+      x = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(const void*)(buf + 8 * i)), bswap);
+      _mm256_storeu_si256((__m256i*)(void*)(W + i), x);
+      _mm256_storeu_si256((__m256i*)(void*)(WK + i), _mm256_add_epi64(x, _mm256_loadu_si256((const __m256i*)(const void*)(K + i))));
+   }
+
+   for (i = 0; i < 8; i++) {
+      S[i] = md->sha512.state[i];
+   }
+
+#define RND(a,b,c,d,e,f,g,h,i)                       \
+     t0 = h + Sigma1(e) + Ch(e, f, g) + WK[i];        \
+     t1 = Sigma0(a) + Maj(a, b, c);                  \
+     d += t0;                                        \
+     h  = t0 + t1;
+
+/* W[i..i+3] = Gamma1(W[i-2..i+1]) + W[i-7..i-4] + Gamma0(W[i-15..i-12]) + W[i-16..i-13],
+ * where W[i] and W[i+1] are only known after the first half */
+#define SCHED(i)                                                                                                  \
+     x = _mm256_add_epi64(_mm256_add_epi64(_mm256_loadu_si256((const __m256i*)(const void*)(W + (i) - 16)),       \
+                                           _mm256_loadu_si256((const __m256i*)(const void*)(W + (i) - 7))),       \
+                          V_Gamma0(_mm256_loadu_si256((const __m256i*)(const void*)(W + (i) - 15))));             \
+     y = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(const void*)(W + (i) - 2)));                \
+     x = _mm256_add_epi64(x, _mm256_and_si256(V_Gamma1(y), lo));                                                  \
+     y = _mm256_permute4x64_epi64(x, 0x44);                                                                       \
+     x = _mm256_add_epi64(x, _mm256_andnot_si256(lo, V_Gamma1(y)));                                               \
+     _mm256_storeu_si256((__m256i*)(void*)(W + (i)), x);                                                          \
+     _mm256_storeu_si256((__m256i*)(void*)(WK + (i)), _mm256_add_epi64(x, _mm256_loadu_si256((const __m256i*)(const void*)(K + (i)))));
+
+   /* the schedule runs 16 words ahead of the rounds, so the vector and the scalar units work in parallel */
+   for (i = 0; i < 80; i += 8) {
+      if (i < 64) {
+         SCHED(i + 16)
+      }
+      RND(S[0],S[1],S[2],S[3],S[4],S[5],S[6],S[7],i+0);
+      RND(S[7],S[0],S[1],S[2],S[3],S[4],S[5],S[6],i+1);
+      RND(S[6],S[7],S[0],S[1],S[2],S[3],S[4],S[5],i+2);
+      RND(S[5],S[6],S[7],S[0],S[1],S[2],S[3],S[4],i+3);
+      if (i < 64) {
+         SCHED(i + 20)
+      }
+      RND(S[4],S[5],S[6],S[7],S[0],S[1],S[2],S[3],i+4);
+      RND(S[3],S[4],S[5],S[6],S[7],S[0],S[1],S[2],i+5);
+      RND(S[2],S[3],S[4],S[5],S[6],S[7],S[0],S[1],i+6);
+      RND(S[1],S[2],S[3],S[4],S[5],S[6],S[7],S[0],i+7);
+   }
+
+   for (i = 0; i < 8; i++) {
+      md->sha512.state[i] += S[i];
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(W, sizeof(W));
+   zeromem(WK, sizeof(WK));
+   zeromem(S, sizeof(S));
+#endif
+   return CRYPT_OK;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -25,7 +25,10 @@ const struct ltc_hash_descriptor sha3_224_desc =
    &sha3_process,
    &sha3_done,
    &sha3_224_test,
-   NULL
+   NULL,
+   &sha3_clone,
+   &sha3_224_export_state,
+   &sha3_224_import_state
 };
 
 const struct ltc_hash_descriptor sha3_256_desc =
@@ -40,7 +43,10 @@ const struct ltc_hash_descriptor sha3_256_desc =
    &sha3_process,
    &sha3_done,
    &sha3_256_test,
-   NULL
+   NULL,
+   &sha3_clone,
+   &sha3_256_export_state,
+   &sha3_256_import_state
 };
 
 const struct ltc_hash_descriptor sha3_384_desc =
@@ -55,7 +61,10 @@ const struct ltc_hash_descriptor sha3_384_desc =
    &sha3_process,
    &sha3_done,
    &sha3_384_test,
-   NULL
+   NULL,
+   &sha3_clone,
+   &sha3_384_export_state,
+   &sha3_384_import_state
 };
 
 const struct ltc_hash_descriptor sha3_512_desc =
@@ -70,7 +79,10 @@ const struct ltc_hash_descriptor sha3_512_desc =
    &sha3_process,
    &sha3_done,
    &sha3_512_test,
-   NULL
+   NULL,
+   &sha3_clone,
+   &sha3_512_export_state,
+   &sha3_512_import_state
 };
 
 #define SHA3_KECCAK_SPONGE_WORDS 25 /* 1600 bits > 200 bytes > 25 x ulong64 */
@@ -91,6 +103,7 @@ static const ulong64 keccakf_rndc[24] = {
    CONST64(0x0000000080000001), CONST64(0x8000000080008008)
 };
 
+#ifdef LTC_SMALL_CODE
 static const unsigned keccakf_rotc[24] = {
    1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44
 };
@@ -98,6 +111,9 @@ static const unsigned keccakf_rotc[24] = {
 static const unsigned keccakf_piln[24] = {
    10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
 };
+#endif
+
+#ifdef LTC_SMALL_CODE
 
 static void keccakf(ulong64 s[25])
 {
@@ -134,6 +150,108 @@ static void keccakf(ulong64 s[25])
    }
 }
 
+#else
+
+/* The lanes are named after their row (b, g, k, m, s) and column (a, e, i, o, u), so s[x + 5*y] is
+ * e.g. Abe for x=1, y=0.  One round computes the E lanes from the A lanes, with rho and pi folded
+ * into the indices.  The lanes Abe, Abi, Ago, Aki, Ami and Asa are kept complemented, which turns
+ * most of the ~b & c in chi into b | c or b & c, one NOT per row is left. */
+#define KECCAK_ROUND(A, E, round)                                                               \
+   Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa;                                                  \
+   Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se;                                                  \
+   Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si;                                                  \
+   Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so;                                                  \
+   Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su;                                                  \
+   Da = Cu ^ ROL64c(Ce, 1);                                                                     \
+   De = Ca ^ ROL64c(Ci, 1);                                                                     \
+   Di = Ce ^ ROL64c(Co, 1);                                                                     \
+   Do = Ci ^ ROL64c(Cu, 1);                                                                     \
+   Du = Co ^ ROL64c(Ca, 1);                                                                     \
+                                                                                                \
+   Ba = A##ba ^ Da;                                                                             \
+   Be = ROL64c(A##ge ^ De, 44);                                                                 \
+   Bi = ROL64c(A##ki ^ Di, 43);                                                                 \
+   Bo = ROL64c(A##mo ^ Do, 21);                                                                 \
+   Bu = ROL64c(A##su ^ Du, 14);                                                                 \
+   E##ba = Ba ^ (Be | Bi) ^ keccakf_rndc[round];                                                \
+   E##be = Be ^ ((~Bi) | Bo);                                                                   \
+   E##bi = Bi ^ (Bo & Bu);                                                                      \
+   E##bo = Bo ^ (Bu | Ba);                                                                      \
+   E##bu = Bu ^ (Ba & Be);                                                                      \
+                                                                                                \
+   Ba = ROL64c(A##bo ^ Do, 28);                                                                 \
+   Be = ROL64c(A##gu ^ Du, 20);                                                                 \
+   Bi = ROL64c(A##ka ^ Da, 3);                                                                  \
+   Bo = ROL64c(A##me ^ De, 45);                                                                 \
+   Bu = ROL64c(A##si ^ Di, 61);                                                                 \
+   E##ga = Ba ^ (Be | Bi);                                                                      \
+   E##ge = Be ^ (Bi & Bo);                                                                      \
+   E##gi = Bi ^ (Bo | (~Bu));                                                                   \
+   E##go = Bo ^ (Bu | Ba);                                                                      \
+   E##gu = Bu ^ (Ba & Be);                                                                      \
+                                                                                                \
+   Ba = ROL64c(A##be ^ De, 1);                                                                  \
+   Be = ROL64c(A##gi ^ Di, 6);                                                                  \
+   Bi = ROL64c(A##ko ^ Do, 25);                                                                 \
+   Bo = ROL64c(A##mu ^ Du, 8);                                                                  \
+   Bu = ROL64c(A##sa ^ Da, 18);                                                                 \
+   E##ka = Ba ^ (Be | Bi);                                                                      \
+   E##ke = Be ^ (Bi & Bo);                                                                      \
+   E##ki = Bi ^ ((~Bo) & Bu);                                                                   \
+   E##ko = (~Bo) ^ (Bu | Ba);                                                                   \
+   E##ku = Bu ^ (Ba & Be);                                                                      \
+                                                                                                \
+   Ba = ROL64c(A##bu ^ Du, 27);                                                                 \
+   Be = ROL64c(A##ga ^ Da, 36);                                                                 \
+   Bi = ROL64c(A##ke ^ De, 10);                                                                 \
+   Bo = ROL64c(A##mi ^ Di, 15);                                                                 \
+   Bu = ROL64c(A##so ^ Do, 56);                                                                 \
+   E##ma = Ba ^ (Be & Bi);                                                                      \
+   E##me = Be ^ (Bi | Bo);                                                                      \
+   E##mi = Bi ^ ((~Bo) | Bu);                                                                   \
+   E##mo = (~Bo) ^ (Bu & Ba);                                                                   \
+   E##mu = Bu ^ (Ba | Be);                                                                      \
+                                                                                                \
+   Ba = ROL64c(A##bi ^ Di, 62);                                                                 \
+   Be = ROL64c(A##go ^ Do, 55);                                                                 \
+   Bi = ROL64c(A##ku ^ Du, 39);                                                                 \
+   Bo = ROL64c(A##ma ^ Da, 41);                                                                 \
+   Bu = ROL64c(A##se ^ De, 2);                                                                  \
+   E##sa = Ba ^ ((~Be) & Bi);                                                                   \
+   E##se = (~Be) ^ (Bi | Bo);                                                                   \
+   E##si = Bi ^ (Bo & Bu);                                                                      \
+   E##so = Bo ^ (Bu | Ba);                                                                      \
+   E##su = Bu ^ (Ba & Be);
+
+static void keccakf(ulong64 s[25])
+{
+   ulong64 Aba, Abe, Abi, Abo, Abu, Aga, Age, Agi, Ago, Agu, Aka, Ake, Aki, Ako, Aku;
+   ulong64 Ama, Ame, Ami, Amo, Amu, Asa, Ase, Asi, Aso, Asu;
+   ulong64 Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki, Eko, Eku;
+   ulong64 Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu;
+   ulong64 Ba, Be, Bi, Bo, Bu, Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du;
+   int round;
+
+   Aba =  s[ 0]; Abe = ~s[ 1]; Abi = ~s[ 2]; Abo =  s[ 3]; Abu =  s[ 4];
+   Aga =  s[ 5]; Age =  s[ 6]; Agi =  s[ 7]; Ago = ~s[ 8]; Agu =  s[ 9];
+   Aka =  s[10]; Ake =  s[11]; Aki = ~s[12]; Ako =  s[13]; Aku =  s[14];
+   Ama =  s[15]; Ame =  s[16]; Ami = ~s[17]; Amo =  s[18]; Amu =  s[19];
+   Asa = ~s[20]; Ase =  s[21]; Asi =  s[22]; Aso =  s[23]; Asu =  s[24];
+
+   for (round = 0; round < SHA3_KECCAK_ROUNDS; round += 2) {
+      KECCAK_ROUND(A, E, round)
+      KECCAK_ROUND(E, A, round + 1)
+   }
+
+   s[ 0] =  Aba; s[ 1] = ~Abe; s[ 2] = ~Abi; s[ 3] =  Abo; s[ 4] =  Abu;
+   s[ 5] =  Aga; s[ 6] =  Age; s[ 7] =  Agi; s[ 8] = ~Ago; s[ 9] =  Agu;
+   s[10] =  Aka; s[11] =  Ake; s[12] = ~Aki; s[13] =  Ako; s[14] =  Aku;
+   s[15] =  Ama; s[16] =  Ame; s[17] = ~Ami; s[18] =  Amo; s[19] =  Amu;
+   s[20] = ~Asa; s[21] =  Ase; s[22] =  Asi; s[23] =  Aso; s[24] =  Asu;
+}
+
+#endif
+
 /* Public Inteface */
 
 int sha3_224_init(hash_state *md)
@@ -252,8 +370,8 @@ int sha3_done(hash_state *md, unsigned char *hash)
 int sha3_shake_done(hash_state *md, unsigned char *out, unsigned long outlen)
 {
    /* IMPORTANT NOTE: sha3_shake_done can be called many times */
-   unsigned long idx;
-   unsigned i;
+   unsigned long len;
+   unsigned i, rate;
 
    if (outlen == 0) return CRYPT_OK; /* nothing to do */
    LTC_ARGCHK(md  != NULL);
@@ -272,8 +390,9 @@ int sha3_shake_done(hash_state *md, unsigned char *out, unsigned long outlen)
       md->sha3.xof_flag = 1;
    }
 
-   for (idx = 0; idx < outlen; idx++) {
-      if(md->sha3.byte_index >= (SHA3_KECCAK_SPONGE_WORDS - md->sha3.capacity_words) * 8) {
+   rate = (SHA3_KECCAK_SPONGE_WORDS - md->sha3.capacity_words) * 8;
+   while (outlen > 0) {
+      if(md->sha3.byte_index >= rate) {
          keccakf(md->sha3.s);
          /* store sha3.s[] as little-endian bytes into sha3.sb */
          for(i = 0; i < SHA3_KECCAK_SPONGE_WORDS; i++) {
@@ -281,7 +400,12 @@ int sha3_shake_done(hash_state *md, unsigned char *out, unsigned long outlen)
          }
          md->sha3.byte_index = 0;
       }
-      out[idx] = md->sha3.sb[md->sha3.byte_index++];
+      /* copy what is left of the current block */
+      len = MIN(outlen, rate - md->sha3.byte_index);
+      XMEMCPY(out, md->sha3.sb + md->sha3.byte_index, len);
+      md->sha3.byte_index += (unsigned short)len;
+      out += len;
+      outlen -= len;
    }
    return CRYPT_OK;
 }
@@ -299,6 +423,163 @@ int sha3_shake_memory(int num, const unsigned char *in, unsigned long inlen, uns
    return CRYPT_OK;
 }
 
+/**
+   Copy the hash state, of any SHA3 or SHAKE variant
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(sha3_clone, sha3)
+
+/* sb and xof_flag are only used by sha3_shake_done(), capacity_words is given by the variant */
+static const ltc_hash_field _sha3_fields[] = {
+   { offsetof(hash_state, sha3.s),          LTC_HASH_U64,  25,  0 },
+   { offsetof(hash_state, sha3.saved),      LTC_HASH_U64,   1,  0 },
+   { offsetof(hash_state, sha3.byte_index), LTC_HASH_U16,   1,  7 },
+   { offsetof(hash_state, sha3.word_index), LTC_HASH_U16,   1, 24 }
+};
+
+/**
+   Serialize the state of a SHA3 variant
+   @param id              The ID of the descriptor of the variant
+   @param capacity_words  The capacity of the variant (64-bit words)
+   @param md              The hash state
+   @param out             [out] The destination of the serialized state
+   @param outlen          [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful, CRYPT_INVALID_ARG if md is the state of another variant or a squeezing SHAKE state
+*/
+static int _sha3_export_state(unsigned char id, unsigned short capacity_words,
+                              const hash_state *md, unsigned char *out, unsigned long *outlen)
+{
+   LTC_ARGCHK(md != NULL);
+   /* the variant isn't part of the serialized state, it's implied by the ID; a SHAKE state after
+    * sha3_shake_done() lives in sb and xof_flag, which aren't serialized
+    */
+   if (md->sha3.capacity_words != capacity_words || md->sha3.xof_flag != 0) {
+      return CRYPT_INVALID_ARG;
+   }
+   return hash_state_export(id, _sha3_fields, sizeof(_sha3_fields) / sizeof(_sha3_fields[0]), md, out, outlen);
+}
+
+/**
+   Load a serialized state of a SHA3 variant
+   @param id              The ID of the descriptor of the variant
+   @param capacity_words  The capacity of the variant (64-bit words)
+   @param md              [out] The hash state
+   @param in              The serialized state
+   @param inlen           The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+static int _sha3_import_state(unsigned char id, unsigned short capacity_words,
+                              hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   int err;
+   err = hash_state_import(id, _sha3_fields, sizeof(_sha3_fields) / sizeof(_sha3_fields[0]), md, in, inlen);
+   if (err != CRYPT_OK) return err;
+   if (md->sha3.word_index >= SHA3_KECCAK_SPONGE_WORDS - capacity_words) {
+      zeromem(md, sizeof(*md));
+      return CRYPT_INVALID_PACKET;
+   }
+   md->sha3.capacity_words = capacity_words;
+   return CRYPT_OK;
+}
+
+/**
+   Serialize a SHA3-224 hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful, CRYPT_INVALID_ARG if md isn't a SHA3-224 state
+*/
+int sha3_224_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen)
+{
+   return _sha3_export_state(sha3_224_desc.ID, 2 * 224 / (8 * sizeof(ulong64)), md, out, outlen);
+}
+
+/**
+   Load a hash state serialized by sha3_224_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+int sha3_224_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _sha3_import_state(sha3_224_desc.ID, 2 * 224 / (8 * sizeof(ulong64)), md, in, inlen);
+}
+
+/**
+   Serialize a SHA3-256 hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful, CRYPT_INVALID_ARG if md isn't a SHA3-256 state
+*/
+int sha3_256_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen)
+{
+   return _sha3_export_state(sha3_256_desc.ID, 2 * 256 / (8 * sizeof(ulong64)), md, out, outlen);
+}
+
+/**
+   Load a hash state serialized by sha3_256_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+int sha3_256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _sha3_import_state(sha3_256_desc.ID, 2 * 256 / (8 * sizeof(ulong64)), md, in, inlen);
+}
+
+/**
+   Serialize a SHA3-384 hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful, CRYPT_INVALID_ARG if md isn't a SHA3-384 state
+*/
+int sha3_384_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen)
+{
+   return _sha3_export_state(sha3_384_desc.ID, 2 * 384 / (8 * sizeof(ulong64)), md, out, outlen);
+}
+
+/**
+   Load a hash state serialized by sha3_384_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+int sha3_384_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _sha3_import_state(sha3_384_desc.ID, 2 * 384 / (8 * sizeof(ulong64)), md, in, inlen);
+}
+
+/**
+   Serialize a SHA3-512 hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful, CRYPT_INVALID_ARG if md isn't a SHA3-512 state
+*/
+int sha3_512_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen)
+{
+   return _sha3_export_state(sha3_512_desc.ID, 2 * 512 / (8 * sizeof(ulong64)), md, out, outlen);
+}
+
+/**
+   Load a hash state serialized by sha3_512_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+int sha3_512_import_state(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   return _sha3_import_state(sha3_512_desc.ID, 2 * 512 / (8 * sizeof(ulong64)), md, in, inlen);
+}
+
 #endif
 
 /* ref:         $Format:%D$ */
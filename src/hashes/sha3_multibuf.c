@@ -0,0 +1,397 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file sha3_multibuf.c
+  SHA3 and SHAKE of many independent messages at once
+
+  With AVX2 each 64-bit lane of the 25 state registers belongs to another message, so four
+  Keccak-f[1600] permutations run at once.  A lane that has absorbed its message and squeezed
+  all of its output takes the next message.  The last remaining message is finished with the
+  scalar code.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_SHA3
+
+#ifdef LTC_SHA3_AVX2
+
+/* see chacha_simd.c */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+#define SHA3_LANES 4
+
+static const ulong64 keccakf_rndc[24] = {
+   CONST64(0x0000000000000001), CONST64(0x0000000000008082),
+   CONST64(0x800000000000808a), CONST64(0x8000000080008000),
+   CONST64(0x000000000000808b), CONST64(0x0000000080000001),
+   CONST64(0x8000000080008081), CONST64(0x8000000000008009),
+   CONST64(0x000000000000008a), CONST64(0x0000000000000088),
+   CONST64(0x0000000080008009), CONST64(0x000000008000000a),
+   CONST64(0x000000008000808b), CONST64(0x800000000000008b),
+   CONST64(0x8000000000008089), CONST64(0x8000000000008003),
+   CONST64(0x8000000000008002), CONST64(0x8000000000000080),
+   CONST64(0x000000000000800a), CONST64(0x800000008000000a),
+   CONST64(0x8000000080008081), CONST64(0x8000000000008080),
+   CONST64(0x0000000080000001), CONST64(0x8000000080008008)
+};
+
+#define V_XOR(x, y)     _mm256_xor_si256(x, y)
+#define V_ANDN(x, y)    _mm256_andnot_si256(x, y)
+#define V_ROL(x, n)     _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - (n)))
+#define V_CHI(a, b, c)  V_XOR(a, V_ANDN(b, c))
+
+/* the same round as in sha3.c, without the complemented lanes since AVX2 has ANDN */
+#define KECCAK_X4_ROUND(A, E, round)                                                            \
+   Ca = V_XOR(V_XOR(V_XOR(A##ba, A##ga), V_XOR(A##ka, A##ma)), A##sa);                          \
+   Ce = V_XOR(V_XOR(V_XOR(A##be, A##ge), V_XOR(A##ke, A##me)), A##se);                          \
+   Ci = V_XOR(V_XOR(V_XOR(A##bi, A##gi), V_XOR(A##ki, A##mi)), A##si);                          \
+   Co = V_XOR(V_XOR(V_XOR(A##bo, A##go), V_XOR(A##ko, A##mo)), A##so);                          \
+   Cu = V_XOR(V_XOR(V_XOR(A##bu, A##gu), V_XOR(A##ku, A##mu)), A##su);                          \
+   Da = V_XOR(Cu, V_ROL(Ce, 1));                                                                \
+   De = V_XOR(Ca, V_ROL(Ci, 1));                                                                \
+   Di = V_XOR(Ce, V_ROL(Co, 1));                                                                \
+   Do = V_XOR(Ci, V_ROL(Cu, 1));                                                                \
+   Du = V_XOR(Co, V_ROL(Ca, 1));                                                                \
+                                                                                                \
+   Ba = V_XOR(A##ba, Da);                                                                       \
+   Be = V_ROL(V_XOR(A##ge, De), 44);                                                            \
+   Bi = V_ROL(V_XOR(A##ki, Di), 43);                                                            \
+   Bo = V_ROL(V_XOR(A##mo, Do), 21);                                                            \
+   Bu = V_ROL(V_XOR(A##su, Du), 14);                                                            \
+   E##ba = V_XOR(V_CHI(Ba, Be, Bi), _mm256_set1_epi64x((long long)keccakf_rndc[round]));        \
+   E##be = V_CHI(Be, Bi, Bo);                                                                   \
+   E##bi = V_CHI(Bi, Bo, Bu);                                                                   \
+   E##bo = V_CHI(Bo, Bu, Ba);                                                                   \
+   E##bu = V_CHI(Bu, Ba, Be);                                                                   \
+                                                                                                \
+   Ba = V_ROL(V_XOR(A##bo, Do), 28);                                                            \
+   Be = V_ROL(V_XOR(A##gu, Du), 20);                                                            \
+   Bi = V_ROL(V_XOR(A##ka, Da), 3);                                                             \
+   Bo = V_ROL(V_XOR(A##me, De), 45);                                                            \
+   Bu = V_ROL(V_XOR(A##si, Di), 61);                                                            \
+   E##ga = V_CHI(Ba, Be, Bi);                                                                   \
+   E##ge = V_CHI(Be, Bi, Bo);                                                                   \
+   E##gi = V_CHI(Bi, Bo, Bu);                                                                   \
+   E##go = V_CHI(Bo, Bu, Ba);                                                                   \
+   E##gu = V_CHI(Bu, Ba, Be);                                                                   \
+                                                                                                \
+   Ba = V_ROL(V_XOR(A##be, De), 1);                                                             \
+   Be = V_ROL(V_XOR(A##gi, Di), 6);                                                             \
+   Bi = V_ROL(V_XOR(A##ko, Do), 25);                                                            \
+   Bo = V_ROL(V_XOR(A##mu, Du), 8);                                                             \
+   Bu = V_ROL(V_XOR(A##sa, Da), 18);                                                            \
+   E##ka = V_CHI(Ba, Be, Bi);                                                                   \
+   E##ke = V_CHI(Be, Bi, Bo);                                                                   \
+   E##ki = V_CHI(Bi, Bo, Bu);                                                                   \
+   E##ko = V_CHI(Bo, Bu, Ba);                                                                   \
+   E##ku = V_CHI(Bu, Ba, Be);                                                                   \
+                                                                                                \
+   Ba = V_ROL(V_XOR(A##bu, Du), 27);                                                            \
+   Be = V_ROL(V_XOR(A##ga, Da), 36);                                                            \
+   Bi = V_ROL(V_XOR(A##ke, De), 10);                                                            \
+   Bo = V_ROL(V_XOR(A##mi, Di), 15);                                                            \
+   Bu = V_ROL(V_XOR(A##so, Do), 56);                                                            \
+   E##ma = V_CHI(Ba, Be, Bi);                                                                   \
+   E##me = V_CHI(Be, Bi, Bo);                                                                   \
+   E##mi = V_CHI(Bi, Bo, Bu);                                                                   \
+   E##mo = V_CHI(Bo, Bu, Ba);                                                                   \
+   E##mu = V_CHI(Bu, Ba, Be);                                                                   \
+                                                                                                \
+   Ba = V_ROL(V_XOR(A##bi, Di), 62);                                                            \
+   Be = V_ROL(V_XOR(A##go, Do), 55);                                                            \
+   Bi = V_ROL(V_XOR(A##ku, Du), 39);                                                            \
+   Bo = V_ROL(V_XOR(A##ma, Da), 41);                                                            \
+   Bu = V_ROL(V_XOR(A##se, De), 2);                                                             \
+   E##sa = V_CHI(Ba, Be, Bi);                                                                   \
+   E##se = V_CHI(Be, Bi, Bo);                                                                   \
+   E##si = V_CHI(Bi, Bo, Bu);                                                                   \
+   E##so = V_CHI(Bo, Bu, Ba);                                                                   \
+   E##su = V_CHI(Bu, Ba, Be);
+
+#define V_LD(i)         _mm256_loadu_si256((const __m256i*)(const void*)(S + 4 * (i)))
+#define V_ST(i, x)      _mm256_storeu_si256((__m256i*)(void*)(S + 4 * (i)), x)
+
+/* four permutations, word w of lane l is S[4*w + l] */
+LTC_TARGET("avx2")
+static void _keccakf_x4(ulong64 *S)
+{
+   __m256i Aba, Abe, Abi, Abo, Abu, Aga, Age, Agi, Ago, Agu, Aka, Ake, Aki, Ako, Aku;
+   __m256i Ama, Ame, Ami, Amo, Amu, Asa, Ase, Asi, Aso, Asu;
+   __m256i Eba, Ebe, Ebi, Ebo, Ebu, Ega, Ege, Egi, Ego, Egu, Eka, Eke, Eki, Eko, Eku;
+   __m256i Ema, Eme, Emi, Emo, Emu, Esa, Ese, Esi, Eso, Esu;
+   __m256i Ba, Be, Bi, Bo, Bu, Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du;
+   int round;
+
+   Aba = V_LD( 0); Abe = V_LD( 1); Abi = V_LD( 2); Abo = V_LD( 3); Abu = V_LD( 4);
+   Aga = V_LD( 5); Age = V_LD( 6); Agi = V_LD( 7); Ago = V_LD( 8); Agu = V_LD( 9);
+   Aka = V_LD(10); Ake = V_LD(11); Aki = V_LD(12); Ako = V_LD(13); Aku = V_LD(14);
+   Ama = V_LD(15); Ame = V_LD(16); Ami = V_LD(17); Amo = V_LD(18); Amu = V_LD(19);
+   Asa = V_LD(20); Ase = V_LD(21); Asi = V_LD(22); Aso = V_LD(23); Asu = V_LD(24);
+
+   for (round = 0; round < 24; round += 2) {
+      KECCAK_X4_ROUND(A, E, round)
+      KECCAK_X4_ROUND(E, A, round + 1)
+   }
+
+   V_ST( 0, Aba); V_ST( 1, Abe); V_ST( 2, Abi); V_ST( 3, Abo); V_ST( 4, Abu);
+   V_ST( 5, Aga); V_ST( 6, Age); V_ST( 7, Agi); V_ST( 8, Ago); V_ST( 9, Agu);
+   V_ST(10, Aka); V_ST(11, Ake); V_ST(12, Aki); V_ST(13, Ako); V_ST(14, Aku);
+   V_ST(15, Ama); V_ST(16, Ame); V_ST(17, Ami); V_ST(18, Amo); V_ST(19, Amu);
+   V_ST(20, Asa); V_ST(21, Ase); V_ST(22, Asi); V_ST(23, Aso); V_ST(24, Asu);
+}
+
+typedef struct {
+   const unsigned char *in;      /* the whole blocks of the message not absorbed yet */
+   unsigned long blocks;
+   unsigned char tail[200];      /* the last block with the padding */
+   int padded;                   /* the last block has been absorbed, the lane is squeezing */
+   unsigned char *out;
+   unsigned long outlen;         /* the output still to produce */
+   int idx;                      /* the message in this lane, -1 if the lane is idle */
+} _sha3_lane;
+
+/* start message idx in lane l */
+static void _sha3_lane_start(_sha3_lane *lane, ulong64 *S, int l, int idx, const unsigned char *in, unsigned long inlen,
+                             unsigned char *out, unsigned long outlen, unsigned rate, unsigned char pad)
+{
+   unsigned long r;
+   int i;
+
+   lane->in = in;
+   lane->blocks = inlen / rate;
+   r = inlen % rate;
+   XMEMSET(lane->tail, 0, sizeof(lane->tail));
+   XMEMCPY(lane->tail, in + lane->blocks * rate, r);
+   lane->tail[r] ^= pad;
+   lane->tail[rate - 1] ^= 0x80;
+   lane->padded = 0;
+   lane->out = out;
+   lane->outlen = outlen;
+   lane->idx = idx;
+   for (i = 0; i < 25; i++) {
+      S[4 * i + l] = 0;
+   }
+}
+
+/* capacity_words and pad select the function, outlen is the same for all messages */
+static int _sha3_multibuf_avx2(const unsigned char **in, const unsigned long *inlen, unsigned char **out,
+                               unsigned long outlen, int n, unsigned short capacity_words, unsigned char pad)
+{
+   _sha3_lane lane[SHA3_LANES];
+   ulong64 S[25 * SHA3_LANES], t;
+   unsigned char buf[200];
+   const unsigned char *p;
+   hash_state md;
+   unsigned long len;
+   unsigned rate;
+   int l, i, next, active, err;
+
+   if (n < 2 || (crypt_cpu_features() & LTC_CPU_AVX2) == 0) {
+      return CRYPT_NOP;
+   }
+
+   rate = (25 - capacity_words) * 8;
+   zeromem(S, sizeof(S));
+   for (l = 0, next = 0; l < SHA3_LANES; l++) {
+      if (next < n) {
+         _sha3_lane_start(&lane[l], S, l, next, in[next], inlen[next], out[next], outlen, rate, pad);
+         next++;
+      } else {
+         lane[l].idx = -1;
+      }
+   }
+   active = MIN(n, SHA3_LANES);
+   err = CRYPT_OK;
+
+   while (active > 0) {
+      /* finish a straggler with the scalar code instead of permuting four states for one */
+      if (active == 1) {
+         l = 0;
+         while (lane[l].idx < 0) {
+            l++;
+         }
+         if (lane[l].blocks > 1 || (pad == 0x1F && lane[l].padded && lane[l].outlen > rate)) {
+            XMEMSET(&md, 0, sizeof(md));
+            md.sha3.capacity_words = capacity_words;
+            for (i = 0; i < 25; i++) {
+               md.sha3.s[i] = S[4 * i + l];
+            }
+            if (lane[l].padded) {
+               /* continue squeezing with a new permutation */
+               md.sha3.byte_index = (unsigned short)rate;
+               md.sha3.xof_flag = 1;
+               err = sha3_shake_done(&md, lane[l].out, lane[l].outlen);
+            } else {
+               len = inlen[lane[l].idx] - (unsigned long)(lane[l].in - in[lane[l].idx]);
+               if ((err = sha3_process(&md, lane[l].in, len)) == CRYPT_OK) {
+                  err = (pad == 0x1F) ? sha3_shake_done(&md, lane[l].out, lane[l].outlen) : sha3_done(&md, lane[l].out);
+               }
+            }
+            goto done;
+         }
+      }
+
+      /* absorb the next block of every lane */
+      for (l = 0; l < SHA3_LANES; l++) {
+         if (lane[l].idx < 0 || lane[l].padded) {
+            continue;
+         }
+         if (lane[l].blocks > 0) {
+            p = lane[l].in;
+            lane[l].in += rate;
+            lane[l].blocks--;
+         } else {
+            p = lane[l].tail;
+            lane[l].padded = 1;
+         }
+         for (i = 0; i < (int)rate / 8; i++) {
+            LOAD64L(t, p + 8 * i);
+            S[4 * i + l] ^= t;
+         }
+      }
+
+      _keccakf_x4(S);
+
+      /* squeeze, store the finished outputs and refill the lanes */
+      for (l = 0; l < SHA3_LANES; l++) {
+         if (lane[l].idx < 0 || !lane[l].padded) {
+            continue;
+         }
+         len = MIN(lane[l].outlen, rate);
+         for (i = 0; i < (int)(len + 7) / 8; i++) {
+            STORE64L(S[4 * i + l], buf + 8 * i);
+         }
+         XMEMCPY(lane[l].out, buf, len);
+         lane[l].out += len;
+         lane[l].outlen -= len;
+         if (lane[l].outlen > 0) {
+            continue;
+         }
+         if (next < n) {
+            _sha3_lane_start(&lane[l], S, l, next, in[next], inlen[next], out[next], outlen, rate, pad);
+            next++;
+         } else {
+            lane[l].idx = -1;
+            active--;
+         }
+      }
+   }
+
+done:
+#ifdef LTC_CLEAN_STACK
+   zeromem(lane, sizeof(lane));
+   zeromem(S, sizeof(S));
+   zeromem(buf, sizeof(buf));
+   zeromem(&md, sizeof(md));
+#endif
+   return err;
+}
+
+#endif /* LTC_SHA3_AVX2 */
+
+/**
+  Hash several independent messages with SHA3, the same as calling hash_memory() for each of them
+  @param num     The SHA3 variant, 224, 256, 384 or 512
+  @param in      The messages
+  @param inlen   The lengths of the messages (octets)
+  @param out     [out] The destinations of the digests (num/8 bytes each)
+  @param n       The number of messages
+  @return CRYPT_OK if successful
+*/
+int sha3_memory_multibuf(int num, const unsigned char **in, const unsigned long *inlen, unsigned char **out, int n)
+{
+   hash_state md;
+   int i, err;
+
+   LTC_ARGCHK(in    != NULL);
+   LTC_ARGCHK(inlen != NULL);
+   LTC_ARGCHK(out   != NULL);
+
+   if ((num != 224 && num != 256 && num != 384 && num != 512) || n < 0) {
+      return CRYPT_INVALID_ARG;
+   }
+
+#ifdef LTC_SHA3_AVX2
+   if ((err = _sha3_multibuf_avx2(in, inlen, out, (unsigned long)num / 8, n, (unsigned short)(num / 32), 0x06)) != CRYPT_NOP) {
+      return err;
+   }
+#endif
+
+   err = CRYPT_OK;
+   for (i = 0; i < n; i++) {
+      XMEMSET(&md.sha3, 0, sizeof(md.sha3));
+      md.sha3.capacity_words = (unsigned short)(num / 32);
+      if ((err = sha3_process(&md, in[i], inlen[i])) != CRYPT_OK ||
+          (err = sha3_done(&md, out[i])) != CRYPT_OK) {
+         break;
+      }
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(&md, sizeof(md));
+#endif
+   return err;
+}
+
+/**
+  Compute SHAKE of several independent messages, the same as calling sha3_shake_memory() for each of them
+  @param num     The SHAKE variant, 128 or 256
+  @param in      The messages
+  @param inlen   The lengths of the messages (octets)
+  @param out     [out] The destinations of the outputs (outlen bytes each)
+  @param outlen  The length of each output (octets)
+  @param n       The number of messages
+  @return CRYPT_OK if successful
+*/
+int sha3_shake_memory_multibuf(int num, const unsigned char **in, const unsigned long *inlen, unsigned char **out,
+                               unsigned long outlen, int n)
+{
+   hash_state md;
+   int i, err;
+
+   LTC_ARGCHK(in    != NULL);
+   LTC_ARGCHK(inlen != NULL);
+   LTC_ARGCHK(out   != NULL);
+
+   if ((num != 128 && num != 256) || n < 0) {
+      return CRYPT_INVALID_ARG;
+   }
+   if (outlen == 0) {
+      return CRYPT_OK;
+   }
+
+#ifdef LTC_SHA3_AVX2
+   if ((err = _sha3_multibuf_avx2(in, inlen, out, outlen, n, (unsigned short)(num / 32), 0x1F)) != CRYPT_NOP) {
+      return err;
+   }
+#endif
+
+   err = CRYPT_OK;
+   for (i = 0; i < n; i++) {
+      if ((err = sha3_shake_init(&md, num)) != CRYPT_OK ||
+          (err = sha3_shake_process(&md, in[i], inlen[i])) != CRYPT_OK ||
+          (err = sha3_shake_done(&md, out[i], outlen)) != CRYPT_OK) {
+         break;
+      }
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(&md, sizeof(md));
+#endif
+   return err;
+}
+
+#endif /* LTC_SHA3 */
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
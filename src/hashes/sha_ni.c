@@ -0,0 +1,178 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file sha_ni.c
+  SHA-1 and SHA-256 compression with the Intel SHA extensions
+
+  The message words are kept in four XMM registers, SHA1MSG1/SHA1MSG2 and SHA256MSG1/SHA256MSG2
+  expand them four at a time while SHA1RNDS4 and SHA256RNDS2 run the rounds.  The steps are
+  written as macros with constant indices, so the compiler keeps everything in registers.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_SHA_NI
+
+/* see chacha_simd.c */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+#define SHA_NI_TARGET LTC_TARGET("sha,sse4.1,ssse3")
+
+/**
+  Check whether the CPU supports the SHA extensions
+  @return 1 if sha1_ni_compress() and sha256_ni_compress() can be used, 0 otherwise
+*/
+int sha_ni_is_supported(void)
+{
+   const unsigned long need = LTC_CPU_SHA | LTC_CPU_SSE41 | LTC_CPU_SSSE3;
+   return (crypt_cpu_features() & need) == need;
+}
+
+#ifdef LTC_SHA1
+
+/* rounds 4*g .. 4*g+3 with the round function f,
+ * the message words of group g are in M[g&3], the E value alternates between E[0] and E[1] */
+#define SHA1_G(g, f)                                                                \
+   if ((g) == 0) {                                                                  \
+      E[0] = _mm_add_epi32(E[0], M[0]);                                             \
+   } else {                                                                         \
+      E[(g) & 1] = _mm_sha1nexte_epu32(E[(g) & 1], M[(g) & 3]);                     \
+   }                                                                                \
+   E[((g) + 1) & 1] = ABCD;                                                         \
+   if ((g) >= 3 && (g) <= 18) {                                                     \
+      M[((g) + 1) & 3] = _mm_sha1msg2_epu32(M[((g) + 1) & 3], M[(g) & 3]);          \
+   }                                                                                \
+   ABCD = _mm_sha1rnds4_epu32(ABCD, E[(g) & 1], f);                                 \
+   if ((g) >= 1 && (g) <= 16) {                                                     \
+      M[((g) - 1) & 3] = _mm_sha1msg1_epu32(M[((g) - 1) & 3], M[(g) & 3]);          \
+   }                                                                                \
+   if ((g) >= 2 && (g) <= 17) {                                                     \
+      M[((g) - 2) & 3] = _mm_xor_si128(M[((g) - 2) & 3], M[(g) & 3]);               \
+   }
+
+/**
+  Compress one block with SHA-1
+  @param md    The hash state
+  @param buf   The 64 byte block
+  @return CRYPT_OK
+*/
+SHA_NI_TARGET
+int sha1_ni_compress(hash_state *md, const unsigned char *buf)
+{
+   const __m128i bswap = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+   __m128i ABCD, ABCD_SAVE, E_SAVE, E[2], M[4];
+   int i;
+
+   ABCD = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(const void*)md->sha1.state), 0x1b);
+   E[0] = _mm_set_epi32((int)md->sha1.state[4], 0, 0, 0);
+   ABCD_SAVE = ABCD;
+   E_SAVE = E[0];
+
+   for (i = 0; i < 4; i++) {
+      M[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(buf + 16 * i)), bswap);
+   }
+
+   SHA1_G( 0, 0) SHA1_G( 1, 0) SHA1_G( 2, 0) SHA1_G( 3, 0) SHA1_G( 4, 0)
+   SHA1_G( 5, 1) SHA1_G( 6, 1) SHA1_G( 7, 1) SHA1_G( 8, 1) SHA1_G( 9, 1)
+   SHA1_G(10, 2) SHA1_G(11, 2) SHA1_G(12, 2) SHA1_G(13, 2) SHA1_G(14, 2)
+   SHA1_G(15, 3) SHA1_G(16, 3) SHA1_G(17, 3) SHA1_G(18, 3) SHA1_G(19, 3)
+
+   E[0] = _mm_sha1nexte_epu32(E[0], E_SAVE);
+   ABCD = _mm_add_epi32(ABCD, ABCD_SAVE);
+
+   _mm_storeu_si128((__m128i*)(void*)md->sha1.state, _mm_shuffle_epi32(ABCD, 0x1b));
+   md->sha1.state[4] = (ulong32)_mm_extract_epi32(E[0], 3);
+   return CRYPT_OK;
+}
+
+#endif /* LTC_SHA1 */
+
+#ifdef LTC_SHA256
+
+static const ulong32 K256[64] = {
+    0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL,
+    0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL, 0xd807aa98UL, 0x12835b01UL,
+    0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL,
+    0xc19bf174UL, 0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL,
+    0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL, 0x983e5152UL,
+    0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL,
+    0x06ca6351UL, 0x14292967UL, 0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL,
+    0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+    0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL,
+    0xd6990624UL, 0xf40e3585UL, 0x106aa070UL, 0x19a4c116UL, 0x1e376c08UL,
+    0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL,
+    0x682e6ff3UL, 0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL,
+    0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
+};
+
+/* rounds 4*g .. 4*g+3, the message words of group g are in M[g&3] */
+#define SHA256_G(g)                                                                 \
+   T = _mm_add_epi32(M[(g) & 3], _mm_setr_epi32((int)K256[4 * (g)], (int)K256[4 * (g) + 1], \
+                                                (int)K256[4 * (g) + 2], (int)K256[4 * (g) + 3])); \
+   CDGH = _mm_sha256rnds2_epu32(CDGH, ABEF, T);                                     \
+   if ((g) >= 3 && (g) <= 14) {                                                     \
+      M[((g) + 1) & 3] = _mm_add_epi32(M[((g) + 1) & 3], _mm_alignr_epi8(M[(g) & 3], M[((g) - 1) & 3], 4)); \
+      M[((g) + 1) & 3] = _mm_sha256msg2_epu32(M[((g) + 1) & 3], M[(g) & 3]);        \
+   }                                                                                \
+   ABEF = _mm_sha256rnds2_epu32(ABEF, CDGH, _mm_shuffle_epi32(T, 0x0e));            \
+   if ((g) >= 1 && (g) <= 12) {                                                     \
+      M[((g) - 1) & 3] = _mm_sha256msg1_epu32(M[((g) - 1) & 3], M[(g) & 3]);        \
+   }
+
+/**
+  Compress one block with SHA-256
+  @param md    The hash state
+  @param buf   The 64 byte block
+  @return CRYPT_OK
+*/
+SHA_NI_TARGET
+int sha256_ni_compress(hash_state *md, const unsigned char *buf)
+{
+   const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+   __m128i ABEF, CDGH, ABEF_SAVE, CDGH_SAVE, T, M[4];
+   int i;
+
+   /* the state words are reordered into the ABEF and CDGH registers the instructions work on */
+   T    = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(const void*)md->sha256.state), 0xb1);
+   CDGH = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)(const void*)(md->sha256.state + 4)), 0x1b);
+   ABEF = _mm_alignr_epi8(T, CDGH, 8);
+   CDGH = _mm_blend_epi16(CDGH, T, 0xf0);
+   ABEF_SAVE = ABEF;
+   CDGH_SAVE = CDGH;
+
+   for (i = 0; i < 4; i++) {
+      M[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(const void*)(buf + 16 * i)), bswap);
+   }
+
+   SHA256_G( 0) SHA256_G( 1) SHA256_G( 2) SHA256_G( 3)
+   SHA256_G( 4) SHA256_G( 5) SHA256_G( 6) SHA256_G( 7)
+   SHA256_G( 8) SHA256_G( 9) SHA256_G(10) SHA256_G(11)
+   SHA256_G(12) SHA256_G(13) SHA256_G(14) SHA256_G(15)
+
+   ABEF = _mm_add_epi32(ABEF, ABEF_SAVE);
+   CDGH = _mm_add_epi32(CDGH, CDGH_SAVE);
+
+   T    = _mm_shuffle_epi32(ABEF, 0x1b);
+   CDGH = _mm_shuffle_epi32(CDGH, 0xb1);
+   _mm_storeu_si128((__m128i*)(void*)md->sha256.state, _mm_blend_epi16(T, CDGH, 0xf0));
+   _mm_storeu_si128((__m128i*)(void*)(md->sha256.state + 4), _mm_alignr_epi8(CDGH, T, 8));
+   return CRYPT_OK;
+}
+
+#endif /* LTC_SHA256 */
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
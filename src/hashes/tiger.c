@@ -31,7 +31,10 @@ const struct ltc_hash_descriptor tiger_desc =
     &tiger_process,
     &tiger_done,
     &tiger_test,
-    NULL
+    NULL,
+    &tiger_clone,
+    &tiger_export_state,
+    &tiger_import_state
 };
 
 #define t1 (table)
@@ -725,6 +728,39 @@ int tiger_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _tiger_fields[] = {
+   { offsetof(hash_state, tiger.length), LTC_HASH_U64,    1,  0 },
+   { offsetof(hash_state, tiger.state),  LTC_HASH_U64,    3,  0 },
+   { offsetof(hash_state, tiger.curlen), LTC_HASH_ULONG,  1, 63 },
+   { offsetof(hash_state, tiger.buf),    LTC_HASH_U8,    64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(tiger_clone, tiger)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(tiger_export_state, tiger_desc, _tiger_fields)
+
+/**
+   Load a hash state serialized by tiger_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(tiger_import_state, tiger_desc, _tiger_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
@@ -31,7 +31,10 @@ const struct ltc_hash_descriptor whirlpool_desc =
     &whirlpool_process,
     &whirlpool_done,
     &whirlpool_test,
-    NULL
+    NULL,
+    &whirlpool_clone,
+    &whirlpool_export_state,
+    &whirlpool_import_state
 };
 
 /* the sboxes */
@@ -194,6 +197,39 @@ int whirlpool_done(hash_state * md, unsigned char *out)
     return CRYPT_OK;
 }
 
+static const ltc_hash_field _whirlpool_fields[] = {
+   { offsetof(hash_state, whirlpool.length), LTC_HASH_U64,  1,  0 },
+   { offsetof(hash_state, whirlpool.state),  LTC_HASH_U64,  8,  0 },
+   { offsetof(hash_state, whirlpool.curlen), LTC_HASH_U32,  1, 63 },
+   { offsetof(hash_state, whirlpool.buf),    LTC_HASH_U8,  64,  0 }
+};
+
+/**
+   Copy the hash state
+   @param src  The hash state to copy
+   @param dst  [out] The destination hash state
+   @return CRYPT_OK if successful
+*/
+HASH_CLONE(whirlpool_clone, whirlpool)
+
+/**
+   Serialize the hash state
+   @param md     The hash state
+   @param out    [out] The destination of the serialized state
+   @param outlen [in/out] The max size and resulting size of the serialized state
+   @return CRYPT_OK if successful
+*/
+HASH_EXPORT_STATE(whirlpool_export_state, whirlpool_desc, _whirlpool_fields)
+
+/**
+   Load a hash state serialized by whirlpool_export_state()
+   @param md     [out] The hash state
+   @param in     The serialized state
+   @param inlen  The length of the serialized state (octets)
+   @return CRYPT_OK if successful
+*/
+HASH_IMPORT_STATE(whirlpool_import_state, whirlpool_desc, _whirlpool_fields)
+
 /**
   Self-test the hash
   @return CRYPT_OK if successful, CRYPT_NOP if self-tests have been disabled
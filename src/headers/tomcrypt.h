@@ -80,13 +80,13 @@ enum {
 
 #include <tomcrypt_cfg.h>
 #include <tomcrypt_macros.h>
+#include <tomcrypt_misc.h>
 #include <tomcrypt_cipher.h>
 #include <tomcrypt_hash.h>
 #include <tomcrypt_mac.h>
 #include <tomcrypt_prng.h>
 #include <tomcrypt_pk.h>
 #include <tomcrypt_math.h>
-#include <tomcrypt_misc.h>
 #include <tomcrypt_argchk.h>
 #include <tomcrypt_pkcs.h>
 
@@ -271,6 +271,77 @@ typedef ulong32 ltc_mp_digit;
    #define LTC_HAVE_BSWAP_BUILTIN
 #endif
 
+/* GCC and clang provide 128-bit integers on 64-bit targets */
+#if !defined(LTC_NO_ASM) && defined(ENDIAN_64BITWORD) && defined(__SIZEOF_INT128__)
+   #define LTC_HAVE_INT128
+#endif
+
+/* x86_64 instruction set extensions (AES-NI, SSSE3, AVX2, ...)
+ *
+ * The optimized routines are written with compiler intrinsics and tagged with LTC_TARGET(),
+ * so they are built regardless of the -m flags the library is compiled with.  They are only
+ * executed after crypt_cpu_features() has confirmed that the CPU supports them.
+ * This requires GCC 4.9+ or clang 3.8+, define LTC_NO_X86_SIMD to disable all of them.
+ */
+#if !defined(LTC_NO_ASM) && !defined(LTC_NO_X86_SIMD) && defined(__x86_64__) &&         \
+    ((defined(__clang__) && (__clang_major__ * 100 + __clang_minor__ >= 308)) ||        \
+     (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ * 100 + __GNUC_MINOR__ >= 409)))
+   #define LTC_X86_SIMD
+   #define LTC_TARGET(x) __attribute__((__target__(x)))
+#endif
+
+#if defined(LTC_X86_SIMD) && defined(LTC_RIJNDAEL) && !defined(LTC_NO_AES_NI)
+   #define LTC_AES_NI
+#endif
+
+#if defined(LTC_X86_SIMD) && defined(LTC_GCM_MODE) && !defined(LTC_NO_GCM_PCLMUL)
+   #define LTC_GCM_PCLMUL
+#endif
+
+/* the GCM tables: the 64KiB ones, or the 4-bit ones if the GHASH normally uses PCLMULQDQ and they are
+ * only the fallback for CPUs without it
+ */
+#if defined(LTC_GCM_MODE) && !defined(LTC_NO_TABLES) && !defined(LTC_GCM_TABLES) && !defined(LTC_GCM_TABLES_4BIT)
+   #if defined(LTC_GCM_PCLMUL) && !defined(LTC_GCM_TABLES_SSE2)
+      #define LTC_GCM_TABLES_4BIT
+   #else
+      #define LTC_GCM_TABLES
+   #endif
+#endif
+
+#if defined(LTC_X86_SIMD) && defined(LTC_CHACHA) && !defined(LTC_NO_CHACHA_SIMD)
+   #define LTC_CHACHA_SIMD
+#endif
+
+#if defined(LTC_X86_SIMD) && defined(LTC_POLY1305) && !defined(LTC_NO_POLY1305_AVX2)
+   #define LTC_POLY1305_AVX2
+#endif
+
+#if defined(LTC_X86_SIMD) && (defined(LTC_SHA1) || defined(LTC_SHA256)) && !defined(LTC_NO_SHA_NI)
+   #define LTC_SHA_NI
+#endif
+
+#if defined(LTC_X86_SIMD) && defined(LTC_SHA512) && !defined(LTC_NO_SHA512_AVX2)
+   #define LTC_SHA512_AVX2
+#endif
+
+#if defined(LTC_X86_SIMD) && (defined(LTC_BLAKE2S) || defined(LTC_BLAKE2B) || defined(LTC_BLAKE2SP) || defined(LTC_BLAKE2BP)) && !defined(LTC_NO_BLAKE2_SIMD)
+   #define LTC_BLAKE2_SIMD
+#endif
+
+#if defined(LTC_X86_SIMD) && defined(LTC_SHA3) && !defined(LTC_NO_SHA3_AVX2)
+   #define LTC_SHA3_AVX2
+#endif
+
+#if defined(LTC_X86_SIMD) && defined(LTC_SHA256) && !defined(LTC_NO_SHA256_MULTIBUF_SIMD)
+   #define LTC_SHA256_MULTIBUF_SIMD
+#endif
+
+/* the file functions map the file with mmap() on POSIX systems */
+#if !defined(LTC_NO_FILE) && !defined(LTC_NO_FILE_MMAP) && (defined(__unix__) || defined(__APPLE__))
+   #define LTC_FILE_MMAP
+#endif
+
 
 /* ref:         $Format:%D$ */
 /* git commit:  $Format:%H$ */
@@ -46,6 +46,13 @@ struct rijndael_key {
 };
 #endif
 
+#ifdef LTC_AES_BS
+struct aes_bs_key {
+   ulong64 sk[120];
+   int Nr;
+};
+#endif
+
 #ifdef LTC_KSEED
 struct kseed_key {
     ulong32 K[32], dK[32];
@@ -183,6 +190,9 @@ typedef union Symmetric_key {
 #ifdef LTC_RIJNDAEL
    struct rijndael_key rijndael;
 #endif
+#ifdef LTC_AES_BS
+   struct aes_bs_key   aes_bs;
+#endif
 #ifdef LTC_XTEA
    struct xtea_key     xtea;
 #endif
@@ -687,6 +697,41 @@ void rijndael_enc_done(symmetric_key *skey);
 int rijndael_enc_keysize(int *keysize);
 extern const struct ltc_cipher_descriptor rijndael_desc, aes_desc;
 extern const struct ltc_cipher_descriptor rijndael_enc_desc, aes_enc_desc;
+
+#ifdef LTC_AES_NI
+/* AES-NI backend of rijndael_desc, the accel functions fall back to the tables if the CPU lacks AES-NI */
+int aesni_is_supported(void);
+int aesni_ecb_encrypt(const unsigned char *pt, unsigned char *ct, symmetric_key *skey);
+int aesni_ecb_decrypt(const unsigned char *ct, unsigned char *pt, symmetric_key *skey);
+int aesni_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey);
+int aesni_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey);
+int aesni_accel_cbc_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *IV, symmetric_key *skey);
+int aesni_accel_cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, unsigned char *IV, symmetric_key *skey);
+#ifdef LTC_CTR_MODE
+int aesni_accel_ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *IV, int mode, symmetric_key *skey);
+#endif
+#ifdef LTC_XTS_MODE
+int aesni_accel_xts_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *tweak,
+                            symmetric_key *skey1, symmetric_key *skey2);
+int aesni_accel_xts_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, unsigned char *tweak,
+                            symmetric_key *skey1, symmetric_key *skey2);
+#endif
+#endif
+
+#ifdef LTC_AES_BS
+int aes_bs_setup(const unsigned char *key, int keylen, int num_rounds, symmetric_key *skey);
+int aes_bs_ecb_encrypt(const unsigned char *pt, unsigned char *ct, symmetric_key *skey);
+int aes_bs_ecb_decrypt(const unsigned char *ct, unsigned char *pt, symmetric_key *skey);
+int aes_bs_test(void);
+void aes_bs_done(symmetric_key *skey);
+int aes_bs_keysize(int *keysize);
+int aes_bs_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey);
+int aes_bs_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey);
+#ifdef LTC_CTR_MODE
+int aes_bs_accel_ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, unsigned char *IV, int mode, symmetric_key *skey);
+#endif
+extern const struct ltc_cipher_descriptor aes_bs_desc;
+#endif
 #endif
 
 #ifdef LTC_XTEA
@@ -866,6 +911,8 @@ int ctr_start(               int   cipher,
                              int  num_rounds, int ctr_mode,
                    symmetric_CTR *ctr);
 int ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long len, symmetric_CTR *ctr);
+int ctr_encrypt_mt(const unsigned char *pt, unsigned char *ct, unsigned long len, symmetric_CTR *ctr,
+                   unsigned long threads, ltc_mt_executor exec, void *exec_ctx);
 int ctr_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, symmetric_CTR *ctr);
 int ctr_getiv(unsigned char *IV, unsigned long *len, symmetric_CTR *ctr);
 int ctr_setiv(const unsigned char *IV, unsigned long len, symmetric_CTR *ctr);
@@ -932,6 +979,19 @@ int xts_decrypt(
          unsigned char *tweak,
          symmetric_xts *xts);
 
+int xts_encrypt_mt(
+   const unsigned char *pt, unsigned long ptlen,
+         unsigned char *ct,
+         unsigned char *tweak,
+         symmetric_xts *xts,
+         unsigned long threads, ltc_mt_executor exec, void *exec_ctx);
+int xts_decrypt_mt(
+   const unsigned char *ct, unsigned long ptlen,
+         unsigned char *pt,
+         unsigned char *tweak,
+         symmetric_xts *xts,
+         unsigned long threads, ltc_mt_executor exec, void *exec_ctx);
+
 void xts_done(symmetric_xts *xts);
 int  xts_test(void);
 void xts_mult_x(unsigned char *I);
@@ -967,6 +1027,10 @@ int chacha_keystream(chacha_state *st, unsigned char *out, unsigned long outlen)
 int chacha_done(chacha_state *st);
 int chacha_test(void);
 
+#ifdef LTC_CHACHA_SIMD
+unsigned long chacha_simd_crypt(chacha_state *st, const unsigned char *in, unsigned long blocks, unsigned char *out);
+#endif
+
 #endif /* LTC_CHACHA */
 
 #ifdef LTC_RC4_STREAM
@@ -148,6 +148,9 @@
 /* disable all file related functions */
 /* #define LTC_NO_FILE */
 
+/* read files with fread() instead of mapping them with mmap() on POSIX systems */
+/* #define LTC_NO_FILE_MMAP */
+
 /* disable all forms of ASM */
 /* #define LTC_NO_ASM */
 
@@ -157,6 +160,9 @@
 /* disable BSWAP on x86 */
 /* #define LTC_NO_BSWAP */
 
+/* disable all code using x86_64 instruction set extensions like AES-NI or AVX2 */
+/* #define LTC_NO_X86_SIMD */
+
 /* ---> math provider? <--- */
 #ifndef LTC_NO_MATH
 
@@ -180,6 +186,10 @@
 #define LTC_RC6
 #define LTC_SAFERP
 #define LTC_RIJNDAEL
+/* Rijndael uses AES-NI when the CPU supports it (detected at runtime), define this to always use the tables */
+/* #define LTC_NO_AES_NI */
+/* constant-time bitsliced AES as aes_bs_desc */
+#define LTC_AES_BS
 #define LTC_XTEA
 /* _TABLES tells it to use tables during setup, _SMALL means to use the smaller scheduled key format
  * (saves 4KB of ram), _ALL_TABLES enables all tables during setup */
@@ -207,6 +217,8 @@
 
 /* stream ciphers */
 #define LTC_CHACHA
+/* ChaCha processes 4, 8 or 16 blocks at once with SSE2, AVX2 or AVX-512 if available, define this to disable it */
+/* #define LTC_NO_CHACHA_SIMD */
 #define LTC_RC4_STREAM
 #define LTC_SOBER128_STREAM
 
@@ -245,14 +257,25 @@
 #define LTC_CHC_HASH
 #define LTC_WHIRLPOOL
 #define LTC_SHA3
+/* sha3_memory_multibuf() and sha3_shake_memory_multibuf() run four Keccak permutations at once with AVX2,
+ * define this to hash the messages one after the other */
+/* #define LTC_NO_SHA3_AVX2 */
 #define LTC_SHA512
+/* SHA-512 (and SHA-384, SHA-512/256 and SHA-512/224) use AVX2 and BMI2 if the CPU supports them,
+ * define this to always use the C code */
+/* #define LTC_NO_SHA512_AVX2 */
 #define LTC_SHA512_256
 #define LTC_SHA512_224
 #define LTC_SHA384
 #define LTC_SHA256
+/* sha256_memory_multibuf() hashes 4, 8 or 16 messages at once with SSE2, AVX2 or AVX-512,
+ * define this to hash them one after the other */
+/* #define LTC_NO_SHA256_MULTIBUF_SIMD */
 #define LTC_SHA224
 #define LTC_TIGER
 #define LTC_SHA1
+/* SHA-1 and SHA-256 use the SHA extensions if the CPU supports them, define this to always use the C code */
+/* #define LTC_NO_SHA_NI */
 #define LTC_MD5
 #define LTC_MD4
 #define LTC_MD2
@@ -262,6 +285,12 @@
 #define LTC_RIPEMD320
 #define LTC_BLAKE2S
 #define LTC_BLAKE2B
+/* BLAKE2s uses SSSE3, BLAKE2b and the parallel modes use AVX2 if the CPU supports them, define this to always use the C code */
+/* #define LTC_NO_BLAKE2_SIMD */
+/* the 8-way and 4-way parallel tree modes, off by default since their state makes hash_state
+ * (and with it hmac_state and the Fortuna pools) about three times larger */
+/* #define LTC_BLAKE2SP */
+/* #define LTC_BLAKE2BP */
 
 #define LTC_HASH_HELPERS
 
@@ -278,6 +307,8 @@
 #define LTC_F9_MODE
 #define LTC_PELICAN
 #define LTC_POLY1305
+/* Poly1305 processes 4 blocks at once with AVX2 if available, define this to disable it */
+/* #define LTC_NO_POLY1305_AVX2 */
 #define LTC_BLAKE2SMAC
 #define LTC_BLAKE2BMAC
 
@@ -291,15 +322,17 @@
 #define LTC_GCM_MODE
 #define LTC_CHACHA20POLY1305_MODE
 
-/* Use 64KiB tables */
-#ifndef LTC_NO_TABLES
-   #define LTC_GCM_TABLES
-#endif
+/* Disable the PCLMULQDQ based GHASH on x86_64 */
+/* #define LTC_NO_GCM_PCLMUL */
+
+/* Use 64KiB tables, the default unless the GHASH uses PCLMULQDQ (see tomcrypt_cfg.h) */
+/* #define LTC_GCM_TABLES */
 
-/* USE SSE2? requires GCC works on x86_32 and x86_64*/
-#ifdef LTC_GCM_TABLES
+/* Use 256 byte 4-bit tables instead (Shoup's method), the default fallback of the PCLMULQDQ based GHASH */
+/* #define LTC_GCM_TABLES_4BIT */
+
+/* USE SSE2 with the 64KiB tables? requires GCC works on x86_32 and x86_64*/
 /* #define LTC_GCM_TABLES_SSE2 */
-#endif
 
 #endif /* LTC_NO_MACS */
 
@@ -507,6 +540,10 @@
    #define LTC_PKCS_1
 #endif
 
+#if defined(LTC_GCM_TABLES) && defined(LTC_GCM_TABLES_4BIT)
+   #error LTC_GCM_TABLES and LTC_GCM_TABLES_4BIT are mutually exclusive
+#endif
+
 #if defined(LTC_PELICAN) && !defined(LTC_RIJNDAEL)
    #error Pelican-MAC requires LTC_RIJNDAEL
 #endif
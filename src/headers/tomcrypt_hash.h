@@ -147,6 +147,30 @@ struct blake2b_state {
 };
 #endif
 
+#ifdef LTC_BLAKE2SP
+struct blake2sp_state {
+    ulong32 h[8][8];
+    ulong64 t;
+    unsigned char buf[15 * 64];
+    unsigned char key[32];
+    unsigned long buflen;
+    unsigned long keylen;
+    unsigned long outlen;
+};
+#endif
+
+#ifdef LTC_BLAKE2BP
+struct blake2bp_state {
+    ulong64 h[8][4];
+    ulong64 t;
+    unsigned char buf[7 * 128];
+    unsigned char key[64];
+    unsigned long buflen;
+    unsigned long keylen;
+    unsigned long outlen;
+};
+#endif
+
 typedef union Hash_state {
     char dummy[1];
 #ifdef LTC_CHC_HASH
@@ -197,6 +221,12 @@ typedef union Hash_state {
 #ifdef LTC_BLAKE2B
     struct blake2b_state blake2b;
 #endif
+#ifdef LTC_BLAKE2SP
+    struct blake2sp_state blake2sp;
+#endif
+#ifdef LTC_BLAKE2BP
+    struct blake2bp_state blake2bp;
+#endif
 
     void *data;
 } hash_state;
@@ -244,6 +274,27 @@ extern  struct ltc_hash_descriptor {
                        const unsigned char *in,  unsigned long  inlen,
                              unsigned char *out, unsigned long *outlen);
 
+    /** Copy a hash state, e.g. after a common prefix has been processed
+      @param src    The hash state to copy
+      @param dst    [out] The destination hash state
+      @return CRYPT_OK if successful
+    */
+    int (*clone)(const hash_state *src, hash_state *dst);
+    /** Serialize a hash state, see hash_state_export()
+      @param hash   The hash state
+      @param out    [out] The destination of the serialized state
+      @param outlen [in/out] The max size and resulting size of the serialized state
+      @return CRYPT_OK if successful
+    */
+    int (*export_state)(const hash_state *hash, unsigned char *out, unsigned long *outlen);
+    /** Load a hash state serialized by export_state
+      @param hash   [out] The hash state
+      @param in     The serialized state
+      @param inlen  The length of the serialized state (octets)
+      @return CRYPT_OK if successful
+    */
+    int (*import_state)(hash_state *hash, const unsigned char *in, unsigned long inlen);
+
 } hash_descriptor[];
 
 #ifdef LTC_CHC_HASH
@@ -252,6 +303,9 @@ int chc_init(hash_state * md);
 int chc_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int chc_done(hash_state * md, unsigned char *hash);
 int chc_test(void);
+int chc_clone(const hash_state *src, hash_state *dst);
+int chc_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int chc_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor chc_desc;
 #endif
 
@@ -260,31 +314,46 @@ int whirlpool_init(hash_state * md);
 int whirlpool_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int whirlpool_done(hash_state * md, unsigned char *hash);
 int whirlpool_test(void);
+int whirlpool_clone(const hash_state *src, hash_state *dst);
+int whirlpool_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int whirlpool_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor whirlpool_desc;
 #endif
 
 #ifdef LTC_SHA3
 int sha3_512_init(hash_state * md);
 int sha3_512_test(void);
+int sha3_512_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha3_512_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha3_512_desc;
 int sha3_384_init(hash_state * md);
 int sha3_384_test(void);
+int sha3_384_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha3_384_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha3_384_desc;
 int sha3_256_init(hash_state * md);
 int sha3_256_test(void);
+int sha3_256_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha3_256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha3_256_desc;
 int sha3_224_init(hash_state * md);
 int sha3_224_test(void);
+int sha3_224_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha3_224_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha3_224_desc;
 /* process + done are the same for all variants */
 int sha3_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int sha3_done(hash_state *md, unsigned char *hash);
+int sha3_clone(const hash_state *src, hash_state *dst);
 /* SHAKE128 + SHAKE256 */
 int sha3_shake_init(hash_state *md, int num);
 #define sha3_shake_process(a,b,c) sha3_process(a,b,c)
 int sha3_shake_done(hash_state *md, unsigned char *out, unsigned long outlen);
 int sha3_shake_test(void);
 int sha3_shake_memory(int num, const unsigned char *in, unsigned long inlen, unsigned char *out, unsigned long *outlen);
+int sha3_memory_multibuf(int num, const unsigned char **in, const unsigned long *inlen, unsigned char **out, int n);
+int sha3_shake_memory_multibuf(int num, const unsigned char **in, const unsigned long *inlen, unsigned char **out,
+                               unsigned long outlen, int n);
 #endif
 
 #ifdef LTC_SHA512
@@ -292,9 +361,18 @@ int sha512_init(hash_state * md);
 int sha512_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int sha512_done(hash_state * md, unsigned char *hash);
 int sha512_test(void);
+int sha512_clone(const hash_state *src, hash_state *dst);
+int sha512_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha512_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha512_desc;
 #endif
 
+#ifdef LTC_SHA512_AVX2
+/* compression function with AVX2 and BMI2, check sha512_avx2_is_supported() before calling it */
+int sha512_avx2_is_supported(void);
+int sha512_avx2_compress(hash_state *md, const unsigned char *buf);
+#endif
+
 #ifdef LTC_SHA384
 #ifndef LTC_SHA512
    #error LTC_SHA512 is required for LTC_SHA384
@@ -303,6 +381,9 @@ int sha384_init(hash_state * md);
 #define sha384_process sha512_process
 int sha384_done(hash_state * md, unsigned char *hash);
 int sha384_test(void);
+#define sha384_clone sha512_clone
+int sha384_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha384_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha384_desc;
 #endif
 
@@ -314,6 +395,9 @@ int sha512_256_init(hash_state * md);
 #define sha512_256_process sha512_process
 int sha512_256_done(hash_state * md, unsigned char *hash);
 int sha512_256_test(void);
+#define sha512_256_clone sha512_clone
+int sha512_256_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha512_256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha512_256_desc;
 #endif
 
@@ -325,6 +409,9 @@ int sha512_224_init(hash_state * md);
 #define sha512_224_process sha512_process
 int sha512_224_done(hash_state * md, unsigned char *hash);
 int sha512_224_test(void);
+#define sha512_224_clone sha512_clone
+int sha512_224_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha512_224_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha512_224_desc;
 #endif
 
@@ -333,6 +420,10 @@ int sha256_init(hash_state * md);
 int sha256_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int sha256_done(hash_state * md, unsigned char *hash);
 int sha256_test(void);
+int sha256_clone(const hash_state *src, hash_state *dst);
+int sha256_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
+int sha256_memory_multibuf(const unsigned char **in, const unsigned long *inlen, unsigned char **out, int n);
 extern const struct ltc_hash_descriptor sha256_desc;
 
 #ifdef LTC_SHA224
@@ -343,6 +434,9 @@ int sha224_init(hash_state * md);
 #define sha224_process sha256_process
 int sha224_done(hash_state * md, unsigned char *hash);
 int sha224_test(void);
+#define sha224_clone sha256_clone
+int sha224_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha224_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha224_desc;
 #endif
 #endif
@@ -352,51 +446,121 @@ int sha1_init(hash_state * md);
 int sha1_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int sha1_done(hash_state * md, unsigned char *hash);
 int sha1_test(void);
+int sha1_clone(const hash_state *src, hash_state *dst);
+int sha1_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int sha1_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor sha1_desc;
 #endif
 
+#ifdef LTC_SHA_NI
+/* compression functions with the SHA extensions, check sha_ni_is_supported() before calling them */
+int sha_ni_is_supported(void);
+#ifdef LTC_SHA1
+int sha1_ni_compress(hash_state *md, const unsigned char *buf);
+#endif
+#ifdef LTC_SHA256
+int sha256_ni_compress(hash_state *md, const unsigned char *buf);
+#endif
+#endif
+
 #ifdef LTC_BLAKE2S
 extern const struct ltc_hash_descriptor blake2s_256_desc;
 int blake2s_256_init(hash_state * md);
 int blake2s_256_test(void);
+int blake2s_256_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2s_256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 
 extern const struct ltc_hash_descriptor blake2s_224_desc;
 int blake2s_224_init(hash_state * md);
 int blake2s_224_test(void);
+int blake2s_224_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2s_224_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 
 extern const struct ltc_hash_descriptor blake2s_160_desc;
 int blake2s_160_init(hash_state * md);
 int blake2s_160_test(void);
+int blake2s_160_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2s_160_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 
 extern const struct ltc_hash_descriptor blake2s_128_desc;
 int blake2s_128_init(hash_state * md);
 int blake2s_128_test(void);
+int blake2s_128_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2s_128_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 
 int blake2s_init(hash_state * md, unsigned long outlen, const unsigned char *key, unsigned long keylen);
 int blake2s_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int blake2s_done(hash_state * md, unsigned char *hash);
+int blake2s_clone(const hash_state *src, hash_state *dst);
 #endif
 
 #ifdef LTC_BLAKE2B
 extern const struct ltc_hash_descriptor blake2b_512_desc;
 int blake2b_512_init(hash_state * md);
 int blake2b_512_test(void);
+int blake2b_512_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2b_512_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 
 extern const struct ltc_hash_descriptor blake2b_384_desc;
 int blake2b_384_init(hash_state * md);
 int blake2b_384_test(void);
+int blake2b_384_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2b_384_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 
 extern const struct ltc_hash_descriptor blake2b_256_desc;
 int blake2b_256_init(hash_state * md);
 int blake2b_256_test(void);
+int blake2b_256_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2b_256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 
 extern const struct ltc_hash_descriptor blake2b_160_desc;
 int blake2b_160_init(hash_state * md);
 int blake2b_160_test(void);
+int blake2b_160_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2b_160_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 
 int blake2b_init(hash_state * md, unsigned long outlen, const unsigned char *key, unsigned long keylen);
 int blake2b_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int blake2b_done(hash_state * md, unsigned char *hash);
+int blake2b_clone(const hash_state *src, hash_state *dst);
+#endif
+
+#ifdef LTC_BLAKE2SP
+extern const struct ltc_hash_descriptor blake2sp_256_desc;
+int blake2sp_256_init(hash_state * md);
+int blake2sp_256_test(void);
+int blake2sp_256_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2sp_256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
+
+int blake2sp_init(hash_state * md, unsigned long outlen, const unsigned char *key, unsigned long keylen);
+int blake2sp_process(hash_state * md, const unsigned char *in, unsigned long inlen);
+int blake2sp_done(hash_state * md, unsigned char *hash);
+int blake2sp_clone(const hash_state *src, hash_state *dst);
+#endif
+
+#ifdef LTC_BLAKE2BP
+extern const struct ltc_hash_descriptor blake2bp_512_desc;
+int blake2bp_512_init(hash_state * md);
+int blake2bp_512_test(void);
+int blake2bp_512_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int blake2bp_512_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
+
+int blake2bp_init(hash_state * md, unsigned long outlen, const unsigned char *key, unsigned long keylen);
+int blake2bp_process(hash_state * md, const unsigned char *in, unsigned long inlen);
+int blake2bp_done(hash_state * md, unsigned char *hash);
+int blake2bp_clone(const hash_state *src, hash_state *dst);
+#endif
+
+#ifdef LTC_BLAKE2_SIMD
+/* compression functions with SIMD, check blake2X_simd_is_supported() before calling them */
+#ifdef LTC_BLAKE2S
+int blake2s_simd_is_supported(void);
+int blake2s_simd_compress(hash_state *md, const unsigned char *buf);
+#endif
+#ifdef LTC_BLAKE2B
+int blake2b_simd_is_supported(void);
+int blake2b_simd_compress(hash_state *md, const unsigned char *buf);
+#endif
 #endif
 
 #ifdef LTC_MD5
@@ -404,6 +568,9 @@ int md5_init(hash_state * md);
 int md5_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int md5_done(hash_state * md, unsigned char *hash);
 int md5_test(void);
+int md5_clone(const hash_state *src, hash_state *dst);
+int md5_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int md5_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor md5_desc;
 #endif
 
@@ -412,6 +579,9 @@ int md4_init(hash_state * md);
 int md4_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int md4_done(hash_state * md, unsigned char *hash);
 int md4_test(void);
+int md4_clone(const hash_state *src, hash_state *dst);
+int md4_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int md4_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor md4_desc;
 #endif
 
@@ -420,6 +590,9 @@ int md2_init(hash_state * md);
 int md2_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int md2_done(hash_state * md, unsigned char *hash);
 int md2_test(void);
+int md2_clone(const hash_state *src, hash_state *dst);
+int md2_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int md2_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor md2_desc;
 #endif
 
@@ -428,6 +601,9 @@ int tiger_init(hash_state * md);
 int tiger_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int tiger_done(hash_state * md, unsigned char *hash);
 int tiger_test(void);
+int tiger_clone(const hash_state *src, hash_state *dst);
+int tiger_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int tiger_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor tiger_desc;
 #endif
 
@@ -436,6 +612,9 @@ int rmd128_init(hash_state * md);
 int rmd128_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int rmd128_done(hash_state * md, unsigned char *hash);
 int rmd128_test(void);
+int rmd128_clone(const hash_state *src, hash_state *dst);
+int rmd128_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int rmd128_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor rmd128_desc;
 #endif
 
@@ -444,6 +623,9 @@ int rmd160_init(hash_state * md);
 int rmd160_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int rmd160_done(hash_state * md, unsigned char *hash);
 int rmd160_test(void);
+int rmd160_clone(const hash_state *src, hash_state *dst);
+int rmd160_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int rmd160_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor rmd160_desc;
 #endif
 
@@ -452,6 +634,9 @@ int rmd256_init(hash_state * md);
 int rmd256_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int rmd256_done(hash_state * md, unsigned char *hash);
 int rmd256_test(void);
+int rmd256_clone(const hash_state *src, hash_state *dst);
+int rmd256_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int rmd256_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor rmd256_desc;
 #endif
 
@@ -460,6 +645,9 @@ int rmd320_init(hash_state * md);
 int rmd320_process(hash_state * md, const unsigned char *in, unsigned long inlen);
 int rmd320_done(hash_state * md, unsigned char *hash);
 int rmd320_test(void);
+int rmd320_clone(const hash_state *src, hash_state *dst);
+int rmd320_export_state(const hash_state *md, unsigned char *out, unsigned long *outlen);
+int rmd320_import_state(hash_state *md, const unsigned char *in, unsigned long inlen);
 extern const struct ltc_hash_descriptor rmd320_desc;
 #endif
 
@@ -481,9 +669,41 @@ int hash_memory(int hash,
 int hash_memory_multi(int hash, unsigned char *out, unsigned long *outlen,
                       const unsigned char *in, unsigned long inlen, ...);
 
+/** the types of the fields of a hash state */
+enum ltc_hash_field_type {
+   LTC_HASH_U8,        /* unsigned char, 1 octet */
+   LTC_HASH_U16,       /* unsigned short, 2 octets */
+   LTC_HASH_U32,       /* ulong32, 4 octets */
+   LTC_HASH_U64,       /* ulong64, 8 octets */
+   LTC_HASH_ULONG      /* unsigned long, 8 octets */
+};
+
+/** A field of a hash state that is serialized by hash_state_export() */
+typedef struct {
+   /** offsetof() the field in hash_state */
+   unsigned long offset;
+   /** the type of the elements */
+   enum ltc_hash_field_type type;
+   /** the number of elements */
+   unsigned long count;
+   /** the largest valid value of a single element, 0 for no limit */
+   unsigned long max;
+} ltc_hash_field;
+
+/* the version of the serialized hash states */
+#define LTC_HASH_STATE_VERSION 1
+
+int hash_state_export(unsigned char id, const ltc_hash_field *fields, unsigned long nfields,
+                      const hash_state *md, unsigned char *out, unsigned long *outlen);
+int hash_state_import(unsigned char id, const ltc_hash_field *fields, unsigned long nfields,
+                      hash_state *md, const unsigned char *in, unsigned long inlen);
+
 #ifndef LTC_NO_FILE
 int hash_filehandle(int hash, FILE *in, unsigned char *out, unsigned long *outlen);
 int hash_file(int hash, const char *fname, unsigned char *out, unsigned long *outlen);
+int hash_file_tree(int hash, const char *fname, unsigned long chunksize, unsigned long fanout,
+                   unsigned long threads, ltc_mt_executor exec, void *exec_ctx,
+                   unsigned char *out, unsigned long *outlen);
 #endif
 
 /* a simple macro for making hash "process" functions */
@@ -526,6 +746,33 @@ int func_name (hash_state * md, const unsigned char *in, unsigned long inlen)
     return CRYPT_OK;                                                                        \
 }
 
+/* a simple macro for making hash "clone" functions */
+#define HASH_CLONE(func_name, state_var)                                                    \
+int func_name (const hash_state *src, hash_state *dst)                                      \
+{                                                                                           \
+    LTC_ARGCHK(src != NULL);                                                                \
+    LTC_ARGCHK(dst != NULL);                                                                \
+    if (src != dst) {                                                                       \
+       XMEMCPY(&dst-> state_var, &src-> state_var, sizeof(src-> state_var));               \
+    }                                                                                       \
+    return CRYPT_OK;                                                                        \
+}
+
+/* simple macros for making hash "export_state" and "import_state" functions from a table of ltc_hash_field */
+#define HASH_EXPORT_STATE(func_name, desc, fields)                                          \
+int func_name (const hash_state *md, unsigned char *out, unsigned long *outlen)             \
+{                                                                                           \
+    return hash_state_export(desc.ID, fields, sizeof(fields) / sizeof(fields[0]),           \
+                             md, out, outlen);                                              \
+}
+
+#define HASH_IMPORT_STATE(func_name, desc, fields)                                          \
+int func_name (hash_state *md, const unsigned char *in, unsigned long inlen)                \
+{                                                                                           \
+    return hash_state_import(desc.ID, fields, sizeof(fields) / sizeof(fields[0]),           \
+                             md, in, inlen);                                                \
+}
+
 /* ref:         $Format:%D$ */
 /* git commit:  $Format:%H$ */
 /* commit time: $Format:%ai$ */
@@ -15,6 +15,13 @@ typedef struct Hmac_state {
      unsigned char  *key;
 } hmac_state;
 
+/* the hash states after the ipad and opad blocks of a key */
+typedef struct {
+     hash_state     inner;
+     hash_state     outer;
+     int            hash;
+} hmac_key_ctx;
+
 int hmac_init(hmac_state *hmac, int hash, const unsigned char *key, unsigned long keylen);
 int hmac_process(hmac_state *hmac, const unsigned char *in, unsigned long inlen);
 int hmac_done(hmac_state *hmac, unsigned char *out, unsigned long *outlen);
@@ -30,6 +37,10 @@ int hmac_memory_multi(int hash,
 int hmac_file(int hash, const char *fname, const unsigned char *key,
               unsigned long keylen,
               unsigned char *dst, unsigned long *dstlen);
+int hmac_key_init(hmac_key_ctx *ctx, int hash, const unsigned char *key, unsigned long keylen);
+int hmac_memory_ctx(const hmac_key_ctx *ctx,
+                    const unsigned char *in,  unsigned long inlen,
+                          unsigned char *out, unsigned long *outlen);
 #endif
 
 #ifdef LTC_OMAC
@@ -97,11 +108,20 @@ int pmac_file(int cipher,
              const          char *filename,
                    unsigned char *out, unsigned long *outlen);
 
+int pmac_memory_mt(int cipher,
+                   const unsigned char *key, unsigned long keylen,
+                   const unsigned char *in,  unsigned long inlen,
+                   unsigned long threads, ltc_mt_executor exec, void *exec_ctx,
+                   unsigned char *out, unsigned long *outlen);
+
 int pmac_test(void);
 
 /* internal functions */
+/* octets passed to the block cipher accelerator at once, 8 blocks of a 128-bit cipher */
+#define PMAC_BATCH 128
 int pmac_ntz(unsigned long x);
 void pmac_shift_xor(pmac_state *pmac);
+int pmac_process_blocks(pmac_state *pmac, const unsigned char *in, unsigned long blocks);
 
 #endif /* PMAC */
 
@@ -123,6 +143,10 @@ int poly1305_memory(const unsigned char *key, unsigned long keylen, const unsign
 int poly1305_memory_multi(const unsigned char *key, unsigned long keylen, unsigned char *mac, unsigned long *maclen, const unsigned char *in,  unsigned long inlen, ...);
 int poly1305_file(const char *fname, const unsigned char *key, unsigned long keylen, unsigned char *mac, unsigned long *maclen);
 int poly1305_test(void);
+
+#ifdef LTC_POLY1305_AVX2
+unsigned long poly1305_avx2_blocks(poly1305_state *st, const unsigned char *in, unsigned long blocks);
+#endif
 #endif /* LTC_POLY1305 */
 
 #ifdef LTC_BLAKE2SMAC
@@ -161,6 +185,11 @@ typedef struct {
    omac_state    headeromac, ctomac;
 } eax_state;
 
+/* eax_encrypt() and eax_decrypt() interleave CTR and OMAC in chunks of this many octets */
+#ifndef EAX_CHUNK
+   #define EAX_CHUNK 4096UL
+#endif
+
 int eax_init(eax_state *eax, int cipher, const unsigned char *key, unsigned long keylen,
              const unsigned char *nonce, unsigned long noncelen,
              const unsigned char *header, unsigned long headerlen);
@@ -297,11 +326,35 @@ int ocb3_decrypt_verify_memory(int cipher,
     const unsigned char *tag,    unsigned long taglen,
           int           *stat);
 
+int ocb3_encrypt_authenticate_memory_iov(int cipher,
+    const unsigned char *key,    unsigned long keylen,
+    const unsigned char *nonce,  unsigned long noncelen,
+    const ltc_iovec     *adata,  unsigned long adatacnt,
+    const ltc_iovec     *pt,     unsigned long ptcnt,
+    const ltc_iovec     *ct,     unsigned long ctcnt,
+          unsigned char *tag,    unsigned long *taglen);
+
+int ocb3_decrypt_verify_memory_iov(int cipher,
+    const unsigned char *key,    unsigned long keylen,
+    const unsigned char *nonce,  unsigned long noncelen,
+    const ltc_iovec     *adata,  unsigned long adatacnt,
+    const ltc_iovec     *ct,     unsigned long ctcnt,
+    const ltc_iovec     *pt,     unsigned long ptcnt,
+    const unsigned char *tag,    unsigned long taglen,
+          int           *stat);
+
 int ocb3_test(void);
 
 #ifdef LTC_SOURCE
 /* internal helper functions */
-int ocb3_int_aad_add_block(ocb3_state *ocb, const unsigned char *aad_block);
+/* octets processed per call of the block cipher accelerator, 8 blocks of a 128-bit cipher */
+#define OCB3_BATCH 128
+int ocb3_int_aad_add_blocks(ocb3_state *ocb, const unsigned char *aad, unsigned long blocks);
+int ocb3_int_crypt_blocks(ocb3_state *ocb, unsigned char *offset, unsigned long *index,
+                          const unsigned char *in, unsigned char *out, unsigned char *offsets,
+                          unsigned long blocks, int enc);
+int ocb3_int_crypt_iov(ocb3_state *ocb, const ltc_iovec *in, unsigned long incnt,
+                       const ltc_iovec *out, unsigned long outcnt, int enc);
 void ocb3_int_calc_offset_zero(ocb3_state *ocb, const unsigned char *nonce, unsigned long noncelen);
 int ocb3_int_ntz(unsigned long x);
 void ocb3_int_xor_blocks(unsigned char *out, const unsigned char *block_a, const unsigned char *block_b, unsigned long block_len);
@@ -362,8 +415,27 @@ int ccm_memory(int cipher,
           unsigned char *tag,    unsigned long *taglen,
                     int  direction);
 
+int ccm_memory_iov(int cipher,
+    const unsigned char *key,    unsigned long keylen,
+    const unsigned char *nonce,  unsigned long noncelen,
+    const ltc_iovec     *header, unsigned long headercnt,
+    const ltc_iovec     *in,     unsigned long incnt,
+    const ltc_iovec     *out,    unsigned long outcnt,
+          unsigned char *tag,    unsigned long *taglen,
+                    int  direction);
+
 int ccm_test(void);
 
+#ifdef LTC_SOURCE
+/* internal helper functions */
+/* octets of keystream computed at once, 8 blocks */
+#define CCM_BATCH 128
+int ccm_int_process_blocks(int cipher, symmetric_key *skey, unsigned long L,
+                           unsigned char *ctr, unsigned char *PAD,
+                           unsigned char *pt, unsigned char *ct,
+                           unsigned long blocks, int direction);
+#endif /* LTC_SOURCE */
+
 #endif /* LTC_CCM_MODE */
 
 #if defined(LRW_MODE) || defined(LTC_GCM_MODE)
@@ -401,6 +473,16 @@ typedef struct {
    ulong64             totlen,       /* 64-bit counter used for IV and AAD */
                        pttotlen;     /* 64-bit counter for the PT */
 
+#ifdef LTC_GCM_PCLMUL
+   unsigned char       HP[8][16];    /* H^1 ... H^8, byte reversed */
+   int                 pclmul;       /* use PCLMULQDQ? */
+#endif
+
+#ifdef LTC_GCM_TABLES_4BIT
+   ulong64             HL[16],       /* 4-bit tables of H, lower */
+                       HH[16];       /* and upper 64 bits */
+#endif
+
 #ifdef LTC_GCM_TABLES
    unsigned char       PC[16][256][16]  /* 16 tables of 8x128 */
 #ifdef LTC_GCM_TABLES_SSE2
@@ -411,6 +493,14 @@ __attribute__ ((aligned (16)))
 } gcm_state;
 
 void gcm_mult_h(gcm_state *gcm, unsigned char *I);
+void gcm_ghash(gcm_state *gcm, const unsigned char *in, unsigned long blocks);
+
+#ifdef LTC_GCM_PCLMUL
+int  gcm_pclmul_is_supported(void);
+void gcm_pclmul_init(gcm_state *gcm);
+void gcm_pclmul_mult_h(gcm_state *gcm, unsigned char *I);
+void gcm_pclmul_ghash(gcm_state *gcm, const unsigned char *in, unsigned long blocks);
+#endif
 
 int gcm_init(gcm_state *gcm, int cipher,
              const unsigned char *key, int keylen);
@@ -439,6 +529,14 @@ int gcm_memory(      int           cipher,
                      unsigned char *ct,
                      unsigned char *tag,    unsigned long *taglen,
                                int direction);
+int gcm_memory_iov(      int           cipher,
+                   const unsigned char *key,    unsigned long keylen,
+                   const unsigned char *IV,     unsigned long IVlen,
+                   const ltc_iovec     *aad,    unsigned long aadcnt,
+                   const ltc_iovec     *in,     unsigned long incnt,
+                   const ltc_iovec     *out,    unsigned long outcnt,
+                         unsigned char *tag,    unsigned long *taglen,
+                                   int direction);
 int gcm_test(void);
 
 #endif /* LTC_GCM_MODE */
@@ -559,6 +657,13 @@ int chacha20poly1305_memory(const unsigned char *key, unsigned long keylen,
                                   unsigned char *out,
                                   unsigned char *tag, unsigned long *taglen,
                             int direction);
+int chacha20poly1305_memory_iov(const unsigned char *key, unsigned long keylen,
+                                const unsigned char *iv,  unsigned long ivlen,
+                                const ltc_iovec     *aad, unsigned long aadcnt,
+                                const ltc_iovec     *in,  unsigned long incnt,
+                                const ltc_iovec     *out, unsigned long outcnt,
+                                      unsigned char *tag, unsigned long *taglen,
+                                int direction);
 int chacha20poly1305_test(void);
 
 #endif /* LTC_CHACHA20POLY1305_MODE */
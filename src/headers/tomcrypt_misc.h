@@ -65,6 +65,60 @@ extern const char *crypt_build_settings;
 /* ---- HMM ---- */
 int crypt_fsa(void *mp, ...);
 
+/* ---- CPU features ---- */
+#define LTC_CPU_SSE2       0x0001UL
+#define LTC_CPU_SSSE3      0x0002UL
+#define LTC_CPU_SSE41      0x0004UL
+#define LTC_CPU_AESNI      0x0008UL
+#define LTC_CPU_PCLMUL     0x0010UL
+#define LTC_CPU_AVX        0x0020UL
+#define LTC_CPU_AVX2       0x0040UL
+#define LTC_CPU_BMI2       0x0080UL
+#define LTC_CPU_SHA        0x0100UL
+#define LTC_CPU_AVX512F    0x0200UL
+#define LTC_CPU_AVX512VL   0x0400UL
+
+unsigned long crypt_cpu_features(void);
+
+/* ---- Multi-threading ---- */
+/** A job of the multi-threaded modes, processes chunk number idx of arg */
+typedef int (*ltc_mt_job)(void *arg, unsigned long idx);
+
+/** Executor for the multi-threaded modes, must call job(arg, idx) for all idx < jobs
+    (in any order and on any thread) and return after all of them have finished
+    @return CRYPT_OK if all jobs returned CRYPT_OK */
+typedef int (*ltc_mt_executor)(void *ctx, ltc_mt_job job, void *arg, unsigned long jobs);
+
+/* the multi-threaded modes don't split buffers into chunks smaller than this */
+#ifndef LTC_MT_MIN_CHUNK
+   #define LTC_MT_MIN_CHUNK 65536UL
+#endif
+
+int crypt_mt_run(ltc_mt_executor exec, void *exec_ctx, ltc_mt_job job, void *arg, unsigned long jobs);
+
+/* ---- Scatter/gather lists ---- */
+/** A segment of a scatter/gather list, used by the *_memory_iov() functions */
+typedef struct {
+   unsigned char *data;
+   unsigned long  len;
+} ltc_iovec;
+
+/** Callback of crypt_iov_process(), e.g. a wrapper around gcm_process() */
+typedef int (*ltc_iov_cb)(void *state, const unsigned char *in, unsigned char *out, unsigned long len);
+
+unsigned long crypt_iov_len(const ltc_iovec *iov, unsigned long cnt);
+int crypt_iov_process(const ltc_iovec *in,  unsigned long incnt,
+                      const ltc_iovec *out, unsigned long outcnt,
+                      unsigned long granule, ltc_iov_cb process, void *state);
+
+/* ---- File processing ---- */
+#ifndef LTC_NO_FILE
+/** Callback of crypt_process_file(), e.g. a wrapper around hmac_process() */
+typedef int (*ltc_process_file_cb)(void *state, const unsigned char *in, unsigned long inlen);
+
+int crypt_process_file(const char *fname, ltc_process_file_cb process, void *state);
+#endif
+
 /* ---- Dynamic language support ---- */
 int crypt_get_constant(const char* namein, int *valueout);
 int crypt_list_all_constants(char *names_list, unsigned int *names_list_size);
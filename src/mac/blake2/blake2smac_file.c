@@ -11,6 +11,13 @@
 
 #ifdef LTC_BLAKE2SMAC
 
+#ifndef LTC_NO_FILE
+static int _blake2smac_file_process(void *state, const unsigned char *in, unsigned long inlen)
+{
+   return blake2smac_process(state, in, inlen);
+}
+#endif
+
 /**
   BLAKE2S MAC a file
   @param fname    The name of the file you wish to BLAKE2S MAC
@@ -26,9 +33,6 @@ int blake2smac_file(const char *fname, const unsigned char *key, unsigned long k
    return CRYPT_NOP;
 #else
    blake2smac_state st;
-   FILE *in;
-   unsigned char *buf;
-   size_t x;
    int err;
 
    LTC_ARGCHK(fname  != NULL);
@@ -36,42 +40,20 @@ int blake2smac_file(const char *fname, const unsigned char *key, unsigned long k
    LTC_ARGCHK(mac    != NULL);
    LTC_ARGCHK(maclen != NULL);
 
-   if ((buf = XMALLOC(LTC_FILE_READ_BUFSIZE)) == NULL) {
-      return CRYPT_MEM;
-   }
-
    if ((err = blake2smac_init(&st, *maclen, key, keylen)) != CRYPT_OK) {
       goto LBL_ERR;
    }
 
-   in = fopen(fname, "rb");
-   if (in == NULL) {
-      err = CRYPT_FILE_NOTFOUND;
+   if ((err = crypt_process_file(fname, _blake2smac_file_process, &st)) != CRYPT_OK) {
       goto LBL_ERR;
    }
 
-   do {
-      x = fread(buf, 1, LTC_FILE_READ_BUFSIZE, in);
-      if ((err = blake2smac_process(&st, buf, (unsigned long)x)) != CRYPT_OK) {
-         fclose(in);
-         goto LBL_CLEANBUF;
-      }
-   } while (x == LTC_FILE_READ_BUFSIZE);
-
-   if (fclose(in) != 0) {
-      err = CRYPT_ERROR;
-      goto LBL_CLEANBUF;
-   }
-
    err = blake2smac_done(&st, mac, maclen);
 
-LBL_CLEANBUF:
-   zeromem(buf, LTC_FILE_READ_BUFSIZE);
 LBL_ERR:
 #ifdef LTC_CLEAN_STACK
    zeromem(&st, sizeof(blake2smac_state));
 #endif
-   XFREE(buf);
    return err;
 #endif
 }
@@ -0,0 +1,104 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file hmac_key_init.c
+  HMAC support, precompute the midstates of a key
+*/
+
+#ifdef LTC_HMAC
+
+#define LTC_HMAC_BLOCKSIZE hash_descriptor[hash].blocksize
+
+/**
+   Hash the ipad and opad blocks of a key once, for hmac_memory_ctx()
+   @param ctx      [out] The key context
+   @param hash     The index of the hash you want to use
+   @param key      The secret key
+   @param keylen   The length of the secret key (octets)
+   @return CRYPT_OK if successful
+*/
+int hmac_key_init(hmac_key_ctx *ctx, int hash, const unsigned char *key, unsigned long keylen)
+{
+    unsigned char *buf;
+    unsigned long i, z;
+    int err;
+
+    LTC_ARGCHK(ctx != NULL);
+    LTC_ARGCHK(key != NULL);
+
+    /* valid hash? */
+    if ((err = hash_is_valid(hash)) != CRYPT_OK) {
+        return err;
+    }
+
+    /* valid key length? */
+    if (keylen == 0) {
+        return CRYPT_INVALID_KEYSIZE;
+    }
+
+    /* allocate ram for buf */
+    buf = XMALLOC(LTC_HMAC_BLOCKSIZE);
+    if (buf == NULL) {
+       return CRYPT_MEM;
+    }
+
+    /* make sure we have a large enough key */
+    if (keylen > LTC_HMAC_BLOCKSIZE) {
+        z = LTC_HMAC_BLOCKSIZE;
+        if ((err = hash_memory(hash, key, keylen, buf, &z)) != CRYPT_OK) {
+           goto LBL_ERR;
+        }
+        keylen = hash_descriptor[hash].hashsize;
+    } else {
+        XMEMCPY(buf, key, (size_t)keylen);
+    }
+    if (keylen < LTC_HMAC_BLOCKSIZE) {
+       zeromem(buf + keylen, (size_t)(LTC_HMAC_BLOCKSIZE - keylen));
+    }
+
+    /* the inner midstate is H after key ^ ipad */
+    for (i = 0; i < LTC_HMAC_BLOCKSIZE; i++) {
+       buf[i] ^= 0x36;
+    }
+    if ((err = hash_descriptor[hash].init(&ctx->inner)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    if ((err = hash_descriptor[hash].process(&ctx->inner, buf, LTC_HMAC_BLOCKSIZE)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+
+    /* the outer midstate is H after key ^ opad */
+    for (i = 0; i < LTC_HMAC_BLOCKSIZE; i++) {
+       buf[i] ^= 0x36 ^ 0x5C;
+    }
+    if ((err = hash_descriptor[hash].init(&ctx->outer)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    if ((err = hash_descriptor[hash].process(&ctx->outer, buf, LTC_HMAC_BLOCKSIZE)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    ctx->hash = hash;
+
+LBL_ERR:
+    if (err != CRYPT_OK) {
+       zeromem(ctx, sizeof(*ctx));
+    }
+    zeromem(buf, LTC_HMAC_BLOCKSIZE);
+    XFREE(buf);
+    return err;
+}
+
+#endif
+
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
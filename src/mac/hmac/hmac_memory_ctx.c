@@ -0,0 +1,101 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file hmac_memory_ctx.c
+  HMAC support, process a block of memory with a precomputed key
+*/
+
+#ifdef LTC_HMAC
+
+/* start from a midstate of the key, hashes without a clone callback are copied as a whole */
+static int _hmac_clone(int hash, const hash_state *src, hash_state *dst)
+{
+   if (hash_descriptor[hash].clone != NULL) {
+      return hash_descriptor[hash].clone(src, dst);
+   }
+   XMEMCPY(dst, src, sizeof(*dst));
+   return CRYPT_OK;
+}
+
+/**
+   HMAC a block of memory with a key context, which can be shared between threads
+   @param ctx       The key context from hmac_key_init()
+   @param in        The data to HMAC
+   @param inlen     The length of the data to HMAC (octets)
+   @param out       [out] Destination of the authentication tag
+   @param outlen    [in/out] Max size and resulting size of authentication tag
+   @return CRYPT_OK if successful
+*/
+int hmac_memory_ctx(const hmac_key_ctx *ctx,
+                    const unsigned char *in,  unsigned long inlen,
+                          unsigned char *out, unsigned long *outlen)
+{
+    hash_state md;
+    unsigned char buf[MAXBLOCKSIZE];
+    unsigned long hashsize, i;
+    int hash, err;
+
+    LTC_ARGCHK(ctx    != NULL);
+    LTC_ARGCHK(in     != NULL);
+    LTC_ARGCHK(out    != NULL);
+    LTC_ARGCHK(outlen != NULL);
+
+    hash = ctx->hash;
+    if ((err = hash_is_valid(hash)) != CRYPT_OK) {
+        return err;
+    }
+    hashsize = hash_descriptor[hash].hashsize;
+    if (hashsize > sizeof(buf)) {
+        return CRYPT_INVALID_HASH;
+    }
+
+    /* inner hash */
+    if ((err = _hmac_clone(hash, &ctx->inner, &md)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    if ((err = hash_descriptor[hash].process(&md, in, inlen)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    if ((err = hash_descriptor[hash].done(&md, buf)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+
+    /* outer hash */
+    if ((err = _hmac_clone(hash, &ctx->outer, &md)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    if ((err = hash_descriptor[hash].process(&md, buf, hashsize)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    if ((err = hash_descriptor[hash].done(&md, buf)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+
+    /* copy to output  */
+    for (i = 0; i < hashsize && i < *outlen; i++) {
+        out[i] = buf[i];
+    }
+    *outlen = i;
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+    zeromem(&md, sizeof(md));
+    zeromem(buf, sizeof(buf));
+#endif
+    return err;
+}
+
+#endif
+
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
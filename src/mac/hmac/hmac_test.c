@@ -592,6 +592,7 @@ int hmac_test(void)
 
     };
 
+    hmac_key_ctx ctx;
     unsigned long outlen;
     int err;
     int tested=0,failed=0;
@@ -610,6 +611,20 @@ int hmac_test(void)
         if(compare_testvector(digest, outlen, cases[i].digest, (size_t)hash_descriptor[hash].hashsize, cases[i].num, i)) {
             failed++;
         }
+
+        /* the same with the precomputed key */
+        outlen = sizeof(digest);
+        if((err = hmac_key_init(&ctx, hash, cases[i].key, cases[i].keylen)) != CRYPT_OK ||
+           (err = hmac_memory_ctx(&ctx, cases[i].data, cases[i].datalen, digest, &outlen)) != CRYPT_OK) {
+#ifdef LTC_TEST_DBG
+            printf("HMAC-%s ctx test %s, %s\n", cases[i].algo, cases[i].num, error_to_string(err));
+#endif
+            return err;
+        }
+
+        if(compare_testvector(digest, outlen, cases[i].digest, (size_t)hash_descriptor[hash].hashsize, cases[i].num, i)) {
+            failed++;
+        }
     }
 
     if (failed != 0) {
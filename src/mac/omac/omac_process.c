@@ -16,6 +16,53 @@
 
 #ifdef LTC_OMAC
 
+/* octets of output of the accelerated CBC encryption, which is thrown away, per call */
+#define OMAC_BATCH 128
+
+/* prev = E(prev xor block) for whole blocks, which are not the last one of the message */
+static int _omac_blocks(omac_state *omac, const unsigned char *in, unsigned long blocks)
+{
+   unsigned char buf[OMAC_BATCH];
+   unsigned long n, x, blklen;
+   int           err;
+
+   blklen = omac->blklen;
+
+   /* the CBC-MAC is a CBC encryption with prev as IV */
+   if (cipher_descriptor[omac->cipher_idx].accel_cbc_encrypt != NULL) {
+      err = CRYPT_OK;
+      while (blocks > 0) {
+         n = MIN(blocks, OMAC_BATCH / blklen);
+         if ((err = cipher_descriptor[omac->cipher_idx].accel_cbc_encrypt(in, buf, n, omac->prev, &omac->key)) != CRYPT_OK) {
+            break;
+         }
+         in     += n * blklen;
+         blocks -= n;
+      }
+#ifdef LTC_CLEAN_STACK
+      zeromem(buf, sizeof(buf));
+#endif
+      return err;
+   }
+
+   for (; blocks > 0; blocks--) {
+#ifdef LTC_FAST
+      for (x = 0; x < blklen; x += sizeof(LTC_FAST_TYPE)) {
+          *(LTC_FAST_TYPE_PTR_CAST(&omac->prev[x])) ^= *(LTC_FAST_TYPE_PTR_CAST(&in[x]));
+      }
+#else
+      for (x = 0; x < blklen; x++) {
+          omac->prev[x] ^= in[x];
+      }
+#endif
+      if ((err = cipher_descriptor[omac->cipher_idx].ecb_encrypt(omac->prev, omac->prev, &omac->key)) != CRYPT_OK) {
+         return err;
+      }
+      in += blklen;
+   }
+   return CRYPT_OK;
+}
+
 /**
    Process data through OMAC
    @param omac     The OMAC state
@@ -39,38 +86,25 @@ int omac_process(omac_state *omac, const unsigned char *in, unsigned long inlen)
       return CRYPT_INVALID_ARG;
    }
 
-#ifdef LTC_FAST
-   {
-     unsigned long blklen = cipher_descriptor[omac->cipher_idx].block_length;
-
-     if (omac->buflen == 0 && inlen > blklen) {
-        unsigned long y;
-        for (x = 0; x < (inlen - blklen); x += blklen) {
-            for (y = 0; y < blklen; y += sizeof(LTC_FAST_TYPE)) {
-                *(LTC_FAST_TYPE_PTR_CAST(&omac->prev[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&in[y]));
-            }
-            in += blklen;
-            if ((err = cipher_descriptor[omac->cipher_idx].ecb_encrypt(omac->prev, omac->prev, &omac->key)) != CRYPT_OK) {
-               return err;
-            }
-        }
-        inlen -= x;
-     }
-   }
-#endif
-
    while (inlen != 0) {
        /* ok if the block is full we xor in prev, encrypt and replace prev */
        if (omac->buflen == omac->blklen) {
-          for (x = 0; x < (unsigned long)omac->blklen; x++) {
-              omac->block[x] ^= omac->prev[x];
-          }
-          if ((err = cipher_descriptor[omac->cipher_idx].ecb_encrypt(omac->block, omac->prev, &omac->key)) != CRYPT_OK) {
+          if ((err = _omac_blocks(omac, omac->block, 1)) != CRYPT_OK) {
              return err;
           }
           omac->buflen = 0;
        }
 
+       /* whole blocks straight from the input, the last one stays in the buffer for omac_done() */
+       if (omac->buflen == 0 && inlen > (unsigned long)omac->blklen) {
+          x = (inlen - 1) / omac->blklen;
+          if ((err = _omac_blocks(omac, in, x)) != CRYPT_OK) {
+             return err;
+          }
+          in    += x * omac->blklen;
+          inlen -= x * omac->blklen;
+       }
+
        /* add bytes */
        n = MIN(inlen, (unsigned long)(omac->blklen - omac->buflen));
        XMEMCPY(omac->block + omac->buflen, in, n);
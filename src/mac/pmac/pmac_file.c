@@ -15,6 +15,13 @@
 
 #ifdef LTC_PMAC
 
+#ifndef LTC_NO_FILE
+static int _pmac_file_process(void *state, const unsigned char *in, unsigned long inlen)
+{
+   return pmac_process(state, in, inlen);
+}
+#endif
+
 /**
    PMAC a file
    @param cipher       The index of the cipher desired
@@ -33,11 +40,8 @@ int pmac_file(int cipher,
 #ifdef LTC_NO_FILE
    return CRYPT_NOP;
 #else
-   size_t x;
    int err;
    pmac_state pmac;
-   FILE *in;
-   unsigned char *buf;
 
 
    LTC_ARGCHK(key      != NULL);
@@ -45,42 +49,20 @@ int pmac_file(int cipher,
    LTC_ARGCHK(out      != NULL);
    LTC_ARGCHK(outlen   != NULL);
 
-   if ((buf = XMALLOC(LTC_FILE_READ_BUFSIZE)) == NULL) {
-      return CRYPT_MEM;
-   }
-
    if ((err = pmac_init(&pmac, cipher, key, keylen)) != CRYPT_OK) {
       goto LBL_ERR;
    }
 
-   in = fopen(filename, "rb");
-   if (in == NULL) {
-      err = CRYPT_FILE_NOTFOUND;
+   if ((err = crypt_process_file(filename, _pmac_file_process, &pmac)) != CRYPT_OK) {
       goto LBL_ERR;
    }
 
-   do {
-      x = fread(buf, 1, LTC_FILE_READ_BUFSIZE, in);
-      if ((err = pmac_process(&pmac, buf, (unsigned long)x)) != CRYPT_OK) {
-         fclose(in);
-         goto LBL_CLEANBUF;
-      }
-   } while (x == LTC_FILE_READ_BUFSIZE);
-
-   if (fclose(in) != 0) {
-      err = CRYPT_ERROR;
-      goto LBL_CLEANBUF;
-   }
-
    err = pmac_done(&pmac, out, outlen);
 
-LBL_CLEANBUF:
-   zeromem(buf, LTC_FILE_READ_BUFSIZE);
 LBL_ERR:
 #ifdef LTC_CLEAN_STACK
    zeromem(&pmac, sizeof(pmac_state));
 #endif
-   XFREE(buf);
    return err;
 #endif
 }
@@ -0,0 +1,138 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file pmac_memory_mt.c
+  PMAC implementation, process a block of memory on several threads
+*/
+
+#ifdef LTC_PMAC
+
+typedef struct {
+   const unsigned char *in;
+   unsigned long       blocks;
+   pmac_state          pmac;
+} _pmac_mt_chunk;
+
+static int _pmac_mt_job(void *arg, unsigned long idx)
+{
+   _pmac_mt_chunk *c = (_pmac_mt_chunk *)arg + idx;
+   return pmac_process_blocks(&c->pmac, c->in, c->blocks);
+}
+
+/* set the offset to the one after first blocks, which is the xor of the Ls[] of the bits set in the gray code of first */
+static void _pmac_seek(pmac_state *pmac, unsigned long first)
+{
+   unsigned long g;
+   int x, y;
+
+   zeromem(pmac->Li, sizeof(pmac->Li));
+   g = first ^ (first >> 1);
+   for (y = 0; y < 32 && g != 0; y++, g >>= 1) {
+      if (g & 1) {
+         for (x = 0; x < pmac->block_len; x++) {
+            pmac->Li[x] ^= pmac->Ls[y][x];
+         }
+      }
+   }
+   pmac->block_index = first + 1;
+}
+
+/**
+  PMAC a block of memory on several threads, the result is the same as with pmac_memory()
+  @param cipher    The index of the cipher desired
+  @param key       The secret key
+  @param keylen    The length of the secret key (octets)
+  @param in        The data you wish to send through PMAC
+  @param inlen     The length of data you wish to send through PMAC (octets)
+  @param threads   The maximum number of chunks to process in parallel
+  @param exec      The executor that runs the chunks (NULL for the default, see crypt_mt_run())
+  @param exec_ctx  The context passed to the executor
+  @param out       [out] Destination for the authentication tag
+  @param outlen    [in/out] The max size and resulting size of the authentication tag
+  @return CRYPT_OK if successful
+*/
+int pmac_memory_mt(int cipher,
+                   const unsigned char *key, unsigned long keylen,
+                   const unsigned char *in,  unsigned long inlen,
+                   unsigned long threads, ltc_mt_executor exec, void *exec_ctx,
+                   unsigned char *out, unsigned long *outlen)
+{
+   pmac_state *pmac;
+   _pmac_mt_chunk *c;
+   unsigned long bl, full, per, n, x;
+   int err, y;
+
+   LTC_ARGCHK(key    != NULL);
+   LTC_ARGCHK(in     != NULL);
+   LTC_ARGCHK(out    != NULL);
+   LTC_ARGCHK(outlen != NULL);
+
+   n = MIN(threads, inlen / LTC_MT_MIN_CHUNK);
+   if (n <= 1) {
+      return pmac_memory(cipher, key, keylen, in, inlen, out, outlen);
+   }
+
+   pmac = XMALLOC(sizeof(pmac_state));
+   if (pmac == NULL) {
+      return CRYPT_MEM;
+   }
+   c = XCALLOC(n, sizeof(*c));
+   if (c == NULL) {
+      XFREE(pmac);
+      return CRYPT_MEM;
+   }
+
+   if ((err = pmac_init(pmac, cipher, key, keylen)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+
+   /* the last block goes through pmac_done(), the others are split into n chunks which start at a known offset */
+   bl = pmac->block_len;
+   full = (inlen - 1) / bl;
+   per = full / n;
+   for (x = 0; x < n; x++) {
+      XMEMCPY(&c[x].pmac, pmac, sizeof(*pmac));
+      _pmac_seek(&c[x].pmac, x * per);
+      c[x].in     = in + x * per * bl;
+      c[x].blocks = (x == n - 1) ? full - x * per : per;
+   }
+
+   if ((err = crypt_mt_run(exec, exec_ctx, _pmac_mt_job, c, n)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+
+   /* the checksum is the xor of the chunks, continue with the offset of the last one */
+   for (x = 0; x < n; x++) {
+      for (y = 0; y < pmac->block_len; y++) {
+         pmac->checksum[y] ^= c[x].pmac.checksum[y];
+      }
+   }
+   XMEMCPY(pmac->Li, c[n - 1].pmac.Li, sizeof(pmac->Li));
+   pmac->block_index = c[n - 1].pmac.block_index;
+
+   if ((err = pmac_process(pmac, in + full * bl, inlen - full * bl)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   err = pmac_done(pmac, out, outlen);
+
+LBL_ERR:
+   zeromem(c, n * sizeof(*c));
+   zeromem(pmac, sizeof(pmac_state));
+   XFREE(c);
+   XFREE(pmac);
+   return err;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
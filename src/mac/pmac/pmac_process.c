@@ -27,7 +27,6 @@ int pmac_process(pmac_state *pmac, const unsigned char *in, unsigned long inlen)
 {
    int err, n;
    unsigned long x;
-   unsigned char Z[MAXBLOCKSIZE];
 
    LTC_ARGCHK(pmac != NULL);
    LTC_ARGCHK(in   != NULL);
@@ -40,42 +39,25 @@ int pmac_process(pmac_state *pmac, const unsigned char *in, unsigned long inlen)
       return CRYPT_INVALID_ARG;
    }
 
-#ifdef LTC_FAST
-   if (pmac->buflen == 0 && inlen > 16) {
-      unsigned long y;
-      for (x = 0; x < (inlen - 16); x += 16) {
-          pmac_shift_xor(pmac);
-          for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-              *(LTC_FAST_TYPE_PTR_CAST(&Z[y])) = *(LTC_FAST_TYPE_PTR_CAST(&in[y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&pmac->Li[y]));
-          }
-          if ((err = cipher_descriptor[pmac->cipher_idx].ecb_encrypt(Z, Z, &pmac->key)) != CRYPT_OK) {
-             return err;
-          }
-          for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-              *(LTC_FAST_TYPE_PTR_CAST(&pmac->checksum[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&Z[y]));
-          }
-          in += 16;
-      }
-      inlen -= x;
-   }
-#endif
-
    while (inlen != 0) {
        /* ok if the block is full we xor in prev, encrypt and replace prev */
        if (pmac->buflen == pmac->block_len) {
-          pmac_shift_xor(pmac);
-          for (x = 0; x < (unsigned long)pmac->block_len; x++) {
-               Z[x] = pmac->Li[x] ^ pmac->block[x];
-          }
-          if ((err = cipher_descriptor[pmac->cipher_idx].ecb_encrypt(Z, Z, &pmac->key)) != CRYPT_OK) {
+          if ((err = pmac_process_blocks(pmac, pmac->block, 1)) != CRYPT_OK) {
              return err;
-           }
-          for (x = 0; x < (unsigned long)pmac->block_len; x++) {
-              pmac->checksum[x] ^= Z[x];
           }
           pmac->buflen = 0;
        }
 
+       /* whole blocks straight from the input, the last one stays in the buffer for pmac_done() */
+       if (pmac->buflen == 0 && inlen > (unsigned long)pmac->block_len) {
+          x = (inlen - 1) / pmac->block_len;
+          if ((err = pmac_process_blocks(pmac, in, x)) != CRYPT_OK) {
+             return err;
+          }
+          in    += x * pmac->block_len;
+          inlen -= x * pmac->block_len;
+       }
+
        /* add bytes */
        n = MIN(inlen, (unsigned long)(pmac->block_len - pmac->buflen));
        XMEMCPY(pmac->block + pmac->buflen, in, n);
@@ -84,10 +66,6 @@ int pmac_process(pmac_state *pmac, const unsigned char *in, unsigned long inlen)
        in            += n;
    }
 
-#ifdef LTC_CLEAN_STACK
-   zeromem(Z, sizeof(Z));
-#endif
-
    return CRYPT_OK;
 }
 
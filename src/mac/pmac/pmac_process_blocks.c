@@ -0,0 +1,92 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+   @file pmac_process_blocks.c
+   PMAC implementation, internal function, process whole blocks
+*/
+
+#ifdef LTC_PMAC
+
+/**
+  Internal function.  Adds whole blocks that are not the last block of the message to the checksum,
+  the blocks are masked with their offsets and encrypted in batches of PMAC_BATCH octets
+  @param pmac    The PMAC state (with an empty buffer)
+  @param in      The blocks
+  @param blocks  The number of blocks
+  @return CRYPT_OK if successful
+*/
+int pmac_process_blocks(pmac_state *pmac, const unsigned char *in, unsigned long blocks)
+{
+   unsigned char Z[PMAC_BATCH];
+   unsigned long x, y, n, bl;
+   int err;
+
+   bl = pmac->block_len;
+   err = CRYPT_OK;
+   while (blocks > 0) {
+      n = MIN(blocks, PMAC_BATCH / bl);
+
+      /* Z_i = M_i xor L(i), the offsets only depend on the block index */
+      for (x = 0; x < n * bl; x += bl) {
+         pmac_shift_xor(pmac);
+#ifdef LTC_FAST
+         for (y = 0; y < bl; y += sizeof(LTC_FAST_TYPE)) {
+            *(LTC_FAST_TYPE_PTR_CAST(&Z[x + y])) = *(LTC_FAST_TYPE_PTR_CAST(&in[x + y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&pmac->Li[y]));
+         }
+#else
+         for (y = 0; y < bl; y++) {
+            Z[x + y] = in[x + y] ^ pmac->Li[y];
+         }
+#endif
+      }
+
+      /* the encryptions are independent, do them in one call if the cipher is accelerated */
+      if (cipher_descriptor[pmac->cipher_idx].accel_ecb_encrypt != NULL) {
+         if ((err = cipher_descriptor[pmac->cipher_idx].accel_ecb_encrypt(Z, Z, n, &pmac->key)) != CRYPT_OK) {
+            goto LBL_ERR;
+         }
+      } else {
+         for (x = 0; x < n * bl; x += bl) {
+            if ((err = cipher_descriptor[pmac->cipher_idx].ecb_encrypt(Z + x, Z + x, &pmac->key)) != CRYPT_OK) {
+               goto LBL_ERR;
+            }
+         }
+      }
+
+      /* checksum ^= E(Z_i) */
+      for (x = 0; x < n * bl; x += bl) {
+#ifdef LTC_FAST
+         for (y = 0; y < bl; y += sizeof(LTC_FAST_TYPE)) {
+            *(LTC_FAST_TYPE_PTR_CAST(&pmac->checksum[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&Z[x + y]));
+         }
+#else
+         for (y = 0; y < bl; y++) {
+            pmac->checksum[y] ^= Z[x + y];
+         }
+#endif
+      }
+
+      in     += n * bl;
+      blocks -= n;
+   }
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(Z, sizeof(Z));
+#endif
+   return err;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -16,6 +16,74 @@
 
 #ifdef LTC_POLY1305
 
+#ifdef LTC_HAVE_INT128
+
+__extension__ typedef unsigned __int128 _ulong128;
+
+/* internal only, radix 2^44 with 64x64->128 bit products, the state is kept in radix 2^26 */
+static void _poly1305_block(poly1305_state *st, const unsigned char *in, unsigned long inlen)
+{
+   const ulong64 hibit = (st->final) ? 0 : ((ulong64)1 << 40); /* 1 << 128 */
+   const ulong64 mask44 = 0xfffffffffffULL, mask42 = 0x3ffffffffffULL;
+   ulong64 r0,r1,r2;
+   ulong64 s1,s2;
+   ulong64 h0,h1,h2;
+   ulong64 t0,t1;
+   _ulong128 d0,d1,d2;
+   ulong64 c;
+
+   r0 = ((ulong64)st->r[0]      ) | ((ulong64)st->r[1] << 26);
+   r1 = ((ulong64)st->r[1] >> 18) | ((ulong64)st->r[2] <<  8) | ((ulong64)st->r[3] << 34);
+   r2 = ((ulong64)st->r[3] >> 10) | ((ulong64)st->r[4] << 16);
+   r0 &= mask44;
+   r1 &= mask44;
+
+   s1 = r1 * (5 << 2);
+   s2 = r2 * (5 << 2);
+
+   /* the limbs of h may be a bit larger than 26 bits, carry them over */
+   t0 = (ulong64)st->h[0] + ((ulong64)st->h[1] << 26);
+   h0 = t0 & mask44;
+   t0 = (t0 >> 44) + ((ulong64)st->h[2] << 8) + ((ulong64)st->h[3] << 34);
+   h1 = t0 & mask44;
+   h2 = (t0 >> 44) + ((ulong64)st->h[4] << 16);
+
+   while (inlen >= 16) {
+      /* h += in[i] */
+      LOAD64L(t0, in+0);
+      LOAD64L(t1, in+8);
+      h0 += (( t0                    ) & mask44);
+      h1 += (((t0 >> 44) | (t1 << 20)) & mask44);
+      h2 += (((t1 >> 24)             ) & mask42) | hibit;
+
+      /* h *= r */
+      d0 = ((_ulong128)h0 * r0) + ((_ulong128)h1 * s2) + ((_ulong128)h2 * s1);
+      d1 = ((_ulong128)h0 * r1) + ((_ulong128)h1 * r0) + ((_ulong128)h2 * s2);
+      d2 = ((_ulong128)h0 * r2) + ((_ulong128)h1 * r1) + ((_ulong128)h2 * r0);
+
+      /* (partial) h %= p */
+                    c = (ulong64)(d0 >> 44); h0 = (ulong64)d0 & mask44;
+      d1 += c;      c = (ulong64)(d1 >> 44); h1 = (ulong64)d1 & mask44;
+      d2 += c;      c = (ulong64)(d2 >> 42); h2 = (ulong64)d2 & mask42;
+      h0 += c * 5;  c =          (h0 >> 44); h0 =          h0 & mask44;
+      h1 += c;
+
+      in += 16;
+      inlen -= 16;
+   }
+
+   c = h1 >> 44; h1 &= mask44;
+   h2 += c;
+
+   st->h[0] = (ulong32)(h0) & 0x3ffffff;
+   st->h[1] = (ulong32)((h0 >> 26) | (h1 << 18)) & 0x3ffffff;
+   st->h[2] = (ulong32)(h1 >> 8) & 0x3ffffff;
+   st->h[3] = (ulong32)((h1 >> 34) | (h2 << 10)) & 0x3ffffff;
+   st->h[4] = (ulong32)(h2 >> 16);
+}
+
+#else
+
 /* internal only */
 static void _poly1305_block(poly1305_state *st, const unsigned char *in, unsigned long inlen)
 {
@@ -79,6 +147,8 @@ static void _poly1305_block(poly1305_state *st, const unsigned char *in, unsigne
    st->h[4] = h4;
 }
 
+#endif
+
 /**
    Initialize an POLY1305 context.
    @param st       The POLY1305 state
@@ -148,6 +218,12 @@ int poly1305_process(poly1305_state *st, const unsigned char *in, unsigned long
    /* process full blocks */
    if (inlen >= 16) {
       unsigned long want = (inlen & ~(16 - 1));
+#ifdef LTC_POLY1305_AVX2
+      i = 16 * poly1305_avx2_blocks(st, in, want / 16);
+      in += i;
+      inlen -= i;
+      want -= i;
+#endif
       _poly1305_block(st, in, want);
       in += want;
       inlen -= want;
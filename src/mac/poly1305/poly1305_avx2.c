@@ -0,0 +1,195 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file poly1305_avx2.c
+  Poly1305 with AVX2, four blocks at once
+
+  Each 64-bit lane holds the radix 2^26 accumulator of every fourth block, which is multiplied
+  by r^4 per step.  At the end the lanes are multiplied by r^4, r^3, r^2 and r and summed up,
+  so h = (h + m[0]) * r^n + m[1] * r^(n-1) + ... + m[n-1] * r, the same as block by block.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_POLY1305_AVX2
+
+/* see chacha_simd.c */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+/* below this number of blocks the final multiplication costs more than it saves */
+#define POLY1305_AVX2_MIN 16
+
+/* c = a * b mod p, partially reduced, with 26-bit limbs */
+static void _poly1305_mul(ulong32 *c, const ulong32 *a, const ulong32 *b)
+{
+   ulong64 d0,d1,d2,d3,d4;
+   ulong32 s1,s2,s3,s4,t;
+
+   s1 = b[1] * 5;
+   s2 = b[2] * 5;
+   s3 = b[3] * 5;
+   s4 = b[4] * 5;
+
+   d0 = ((ulong64)a[0] * b[0]) + ((ulong64)a[1] * s4) + ((ulong64)a[2] * s3) + ((ulong64)a[3] * s2) + ((ulong64)a[4] * s1);
+   d1 = ((ulong64)a[0] * b[1]) + ((ulong64)a[1] * b[0]) + ((ulong64)a[2] * s4) + ((ulong64)a[3] * s3) + ((ulong64)a[4] * s2);
+   d2 = ((ulong64)a[0] * b[2]) + ((ulong64)a[1] * b[1]) + ((ulong64)a[2] * b[0]) + ((ulong64)a[3] * s4) + ((ulong64)a[4] * s3);
+   d3 = ((ulong64)a[0] * b[3]) + ((ulong64)a[1] * b[2]) + ((ulong64)a[2] * b[1]) + ((ulong64)a[3] * b[0]) + ((ulong64)a[4] * s4);
+   d4 = ((ulong64)a[0] * b[4]) + ((ulong64)a[1] * b[3]) + ((ulong64)a[2] * b[2]) + ((ulong64)a[3] * b[1]) + ((ulong64)a[4] * b[0]);
+
+   d1 += d0 >> 26; c[0] = (ulong32)d0 & 0x3ffffff;
+   d2 += d1 >> 26; c[1] = (ulong32)d1 & 0x3ffffff;
+   d3 += d2 >> 26; c[2] = (ulong32)d2 & 0x3ffffff;
+   d4 += d3 >> 26; c[3] = (ulong32)d3 & 0x3ffffff;
+   t = (ulong32)(d4 >> 26); c[4] = (ulong32)d4 & 0x3ffffff;
+   c[0] += t * 5; t = c[0] >> 26; c[0] &= 0x3ffffff;
+   c[1] += t;
+}
+
+/* d = h * r with the s = 5 * r limbs, each lane on its own */
+LTC_TARGET("avx2")
+static LTC_INLINE void _poly1305_mul4(__m256i *d, const __m256i *h, const __m256i *r, const __m256i *s)
+{
+   d[0] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[0]), _mm256_mul_epu32(h[1], s[4])),
+                           _mm256_add_epi64(_mm256_mul_epu32(h[2], s[3]), _mm256_mul_epu32(h[3], s[2]))), _mm256_mul_epu32(h[4], s[1]));
+   d[1] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[1]), _mm256_mul_epu32(h[1], r[0])),
+                           _mm256_add_epi64(_mm256_mul_epu32(h[2], s[4]), _mm256_mul_epu32(h[3], s[3]))), _mm256_mul_epu32(h[4], s[2]));
+   d[2] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[2]), _mm256_mul_epu32(h[1], r[1])),
+                           _mm256_add_epi64(_mm256_mul_epu32(h[2], r[0]), _mm256_mul_epu32(h[3], s[4]))), _mm256_mul_epu32(h[4], s[3]));
+   d[3] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[3]), _mm256_mul_epu32(h[1], r[2])),
+                           _mm256_add_epi64(_mm256_mul_epu32(h[2], r[1]), _mm256_mul_epu32(h[3], r[0]))), _mm256_mul_epu32(h[4], s[4]));
+   d[4] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h[0], r[4]), _mm256_mul_epu32(h[1], r[3])),
+                           _mm256_add_epi64(_mm256_mul_epu32(h[2], r[2]), _mm256_mul_epu32(h[3], r[1]))), _mm256_mul_epu32(h[4], r[0]));
+}
+
+/* h = d mod p, partially reduced */
+LTC_TARGET("avx2")
+static LTC_INLINE void _poly1305_reduce4(__m256i *h, __m256i *d)
+{
+   const __m256i mask = _mm256_set1_epi64x(0x3ffffff);
+   __m256i c;
+
+   c = _mm256_srli_epi64(d[0], 26); h[0] = _mm256_and_si256(d[0], mask);
+   d[1] = _mm256_add_epi64(d[1], c); c = _mm256_srli_epi64(d[1], 26); h[1] = _mm256_and_si256(d[1], mask);
+   d[2] = _mm256_add_epi64(d[2], c); c = _mm256_srli_epi64(d[2], 26); h[2] = _mm256_and_si256(d[2], mask);
+   d[3] = _mm256_add_epi64(d[3], c); c = _mm256_srli_epi64(d[3], 26); h[3] = _mm256_and_si256(d[3], mask);
+   d[4] = _mm256_add_epi64(d[4], c); c = _mm256_srli_epi64(d[4], 26); h[4] = _mm256_and_si256(d[4], mask);
+   h[0] = _mm256_add_epi64(h[0], _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));
+   c = _mm256_srli_epi64(h[0], 26); h[0] = _mm256_and_si256(h[0], mask);
+   h[1] = _mm256_add_epi64(h[1], c);
+}
+
+/* h += four blocks, one per lane */
+LTC_TARGET("avx2")
+static LTC_INLINE void _poly1305_load4(__m256i *h, const unsigned char *in)
+{
+   const __m256i mask = _mm256_set1_epi64x(0x3ffffff);
+   const __m256i hibit = _mm256_set1_epi64x(1 << 24);
+   __m256i a, b, lo, hi;
+
+   a  = _mm256_loadu_si256((const __m256i*)(const void*)in);
+   b  = _mm256_loadu_si256((const __m256i*)(const void*)(in + 32));
+   lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8);
+   hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xd8);
+
+   h[0] = _mm256_add_epi64(h[0], _mm256_and_si256(lo, mask));
+   h[1] = _mm256_add_epi64(h[1], _mm256_and_si256(_mm256_srli_epi64(lo, 26), mask));
+   h[2] = _mm256_add_epi64(h[2], _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), mask));
+   h[3] = _mm256_add_epi64(h[3], _mm256_and_si256(_mm256_srli_epi64(hi, 14), mask));
+   h[4] = _mm256_add_epi64(h[4], _mm256_or_si256(_mm256_srli_epi64(hi, 40), hibit));
+}
+
+LTC_TARGET("avx2")
+static LTC_INLINE ulong64 _poly1305_hsum(__m256i x)
+{
+   __m128i t;
+
+   t = _mm_add_epi64(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+   t = _mm_add_epi64(t, _mm_unpackhi_epi64(t, t));
+   return (ulong64)_mm_cvtsi128_si64(t);
+}
+
+LTC_TARGET("avx2")
+static void _poly1305_avx2(poly1305_state *st, const unsigned char *in, unsigned long blocks)
+{
+   __m256i h[5], d[5], r[5], s[5];
+   ulong32 rp[3][5];
+   ulong64 e0,e1,e2,e3,e4;
+   ulong32 c;
+   int i;
+
+   /* r^2, r^3 and r^4 */
+   _poly1305_mul(rp[0], st->r, st->r);
+   _poly1305_mul(rp[1], rp[0], st->r);
+   _poly1305_mul(rp[2], rp[1], st->r);
+
+   for (i = 0; i < 5; i++) {
+      h[i] = _mm256_set_epi64x(0, 0, 0, st->h[i]);
+      r[i] = _mm256_set1_epi64x(rp[2][i]);
+      s[i] = _mm256_add_epi64(r[i], _mm256_slli_epi64(r[i], 2));
+   }
+
+   _poly1305_load4(h, in);
+   for (in += 64, blocks -= 4; blocks >= 4; in += 64, blocks -= 4) {
+      _poly1305_mul4(d, h, r, s);
+      _poly1305_reduce4(h, d);
+      _poly1305_load4(h, in);
+   }
+
+   /* lane 0 is multiplied by r^4, lane 3 by r */
+   for (i = 0; i < 5; i++) {
+      r[i] = _mm256_set_epi64x(st->r[i], rp[0][i], rp[1][i], rp[2][i]);
+      s[i] = _mm256_add_epi64(r[i], _mm256_slli_epi64(r[i], 2));
+   }
+   _poly1305_mul4(d, h, r, s);
+
+   e0 = _poly1305_hsum(d[0]);
+   e1 = _poly1305_hsum(d[1]);
+   e2 = _poly1305_hsum(d[2]);
+   e3 = _poly1305_hsum(d[3]);
+   e4 = _poly1305_hsum(d[4]);
+
+   e1 += e0 >> 26; st->h[0] = (ulong32)e0 & 0x3ffffff;
+   e2 += e1 >> 26; st->h[1] = (ulong32)e1 & 0x3ffffff;
+   e3 += e2 >> 26; st->h[2] = (ulong32)e2 & 0x3ffffff;
+   e4 += e3 >> 26; st->h[3] = (ulong32)e3 & 0x3ffffff;
+   e0 = (e4 >> 26) * 5; st->h[4] = (ulong32)e4 & 0x3ffffff;
+   e0 += st->h[0]; c = (ulong32)(e0 >> 26); st->h[0] = (ulong32)e0 & 0x3ffffff;
+   st->h[1] += c;
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(rp, sizeof(rp));
+#endif
+}
+
+/**
+  Process whole blocks four at a time if the CPU supports AVX2
+  @param st      The POLY1305 state
+  @param in      The data
+  @param blocks  The number of 16 byte blocks available
+  @return The number of blocks processed, the rest is left to the scalar code
+*/
+unsigned long poly1305_avx2_blocks(poly1305_state *st, const unsigned char *in, unsigned long blocks)
+{
+   if (blocks < POLY1305_AVX2_MIN || (crypt_cpu_features() & LTC_CPU_AVX2) == 0) {
+      return 0;
+   }
+   blocks &= ~3UL;
+   _poly1305_avx2(st, in, blocks);
+   return blocks;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -27,7 +27,12 @@ int poly1305_test(void)
    char m[] = "Cryptographic Forum Research Group";
    unsigned long len = 16, mlen = strlen(m);
    unsigned char out[1000];
+   /* 1000 bytes of (7 * i + 3) mod 256, and with key and message all 0xff */
+   unsigned char tag2[] = { 0x1A, 0x04, 0x26, 0xCE, 0x6E, 0xC6, 0xE1, 0x32, 0x3F, 0xFC, 0xCA, 0x66, 0x04, 0x4D, 0x68, 0x15 };
+   unsigned char tag3[] = { 0xDE, 0x94, 0x06, 0xB1, 0x0E, 0x70, 0x23, 0xBC, 0xD6, 0x92, 0xFF, 0x68, 0x7F, 0x4C, 0xBC, 0x7F };
+   unsigned char k3[32], m2[1000], m3[1000];
    poly1305_state st;
+   unsigned long i;
    int err;
 
    /* process piece by piece */
@@ -45,6 +50,24 @@ int poly1305_test(void)
    if ((err = poly1305_process(&st, (unsigned char*)m, mlen)) != CRYPT_OK)           return err;
    if ((err = poly1305_done(&st, out, &len)) != CRYPT_OK)                            return err;
    if (compare_testvector(out, len, tag, sizeof(tag), "POLY1305-TV2", 1) != 0)       return CRYPT_FAIL_TESTVECTOR;
+   /* long messages, in one go and split so that the leftover and the bulk code take turns */
+   for (i = 0; i < sizeof(m2); i++) m2[i] = (unsigned char)(7 * i + 3);
+   XMEMSET(m3, 0xff, sizeof(m3));
+   XMEMSET(k3, 0xff, sizeof(k3));
+   if ((err = poly1305_init(&st, k, 32)) != CRYPT_OK)                                return err;
+   if ((err = poly1305_process(&st, m2, sizeof(m2))) != CRYPT_OK)                    return err;
+   if ((err = poly1305_done(&st, out, &len)) != CRYPT_OK)                            return err;
+   if (compare_testvector(out, len, tag2, sizeof(tag2), "POLY1305-TV3", 1) != 0)     return CRYPT_FAIL_TESTVECTOR;
+   if ((err = poly1305_init(&st, k, 32)) != CRYPT_OK)                                return err;
+   if ((err = poly1305_process(&st, m2, 7)) != CRYPT_OK)                             return err;
+   if ((err = poly1305_process(&st, m2 + 7, 500)) != CRYPT_OK)                       return err;
+   if ((err = poly1305_process(&st, m2 + 507, sizeof(m2) - 507)) != CRYPT_OK)        return err;
+   if ((err = poly1305_done(&st, out, &len)) != CRYPT_OK)                            return err;
+   if (compare_testvector(out, len, tag2, sizeof(tag2), "POLY1305-TV4", 1) != 0)     return CRYPT_FAIL_TESTVECTOR;
+   if ((err = poly1305_init(&st, k3, 32)) != CRYPT_OK)                               return err;
+   if ((err = poly1305_process(&st, m3, sizeof(m3))) != CRYPT_OK)                    return err;
+   if ((err = poly1305_done(&st, out, &len)) != CRYPT_OK)                            return err;
+   if (compare_testvector(out, len, tag3, sizeof(tag3), "POLY1305-TV5", 1) != 0)     return CRYPT_FAIL_TESTVECTOR;
    return CRYPT_OK;
 #endif
 }
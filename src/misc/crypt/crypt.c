@@ -65,6 +65,9 @@ const char *crypt_build_settings =
 #if defined(LTC_RIJNDAEL)
    "   Rijndael\n"
 #endif
+#if defined(LTC_AES_BS)
+   "   AES (bitsliced)\n"
+#endif
 #if defined(LTC_XTEA)
    "   XTEA\n"
 #endif
@@ -191,6 +194,12 @@ const char *crypt_build_settings =
 #if defined(LTC_BLAKE2B)
    "   BLAKE2B\n"
 #endif
+#if defined(LTC_BLAKE2SP)
+   "   BLAKE2SP\n"
+#endif
+#if defined(LTC_BLAKE2BP)
+   "   BLAKE2BP\n"
+#endif
 #if defined(LTC_CHC_HASH)
    "   CHC_HASH\n"
 #endif
@@ -272,6 +281,12 @@ const char *crypt_build_settings =
 #if defined(LTC_GCM_TABLES)
     " (tables) "
 #endif
+#if defined(LTC_GCM_TABLES_4BIT)
+    " (4-bit tables) "
+#endif
+#if defined(LTC_GCM_PCLMUL)
+    " (PCLMULQDQ) "
+#endif
 #if defined(LTC_GCM_TABLES_SSE2)
     " (SSE2) "
 #endif
@@ -438,6 +453,9 @@ const char *crypt_build_settings =
 #if defined(LTC_NO_FILE)
     " LTC_NO_FILE "
 #endif
+#if defined(LTC_FILE_MMAP)
+    " LTC_FILE_MMAP "
+#endif
 #if defined(LTC_FILE_READ_BUFSIZE)
     " " NAME_VALUE(LTC_FILE_READ_BUFSIZE) " "
 #endif
@@ -453,6 +471,39 @@ const char *crypt_build_settings =
 #if defined(LTC_NO_ASM)
     " LTC_NO_ASM "
 #endif
+#if defined(LTC_X86_SIMD)
+    " LTC_X86_SIMD "
+#endif
+#if defined(LTC_AES_NI)
+    " LTC_AES_NI "
+#endif
+#if defined(LTC_GCM_PCLMUL)
+    " LTC_GCM_PCLMUL "
+#endif
+#if defined(LTC_CHACHA_SIMD)
+    " LTC_CHACHA_SIMD "
+#endif
+#if defined(LTC_POLY1305_AVX2)
+    " LTC_POLY1305_AVX2 "
+#endif
+#if defined(LTC_SHA_NI)
+    " LTC_SHA_NI "
+#endif
+#if defined(LTC_SHA512_AVX2)
+    " LTC_SHA512_AVX2 "
+#endif
+#if defined(LTC_BLAKE2_SIMD)
+    " LTC_BLAKE2_SIMD "
+#endif
+#if defined(LTC_SHA3_AVX2)
+    " LTC_SHA3_AVX2 "
+#endif
+#if defined(LTC_SHA256_MULTIBUF_SIMD)
+    " LTC_SHA256_MULTIBUF_SIMD "
+#endif
+#if defined(LTC_HAVE_INT128)
+    " LTC_HAVE_INT128 "
+#endif
 #if defined(LTC_ROx_ASM)
     " LTC_ROx_ASM "
 #if defined(LTC_NO_ROLC)
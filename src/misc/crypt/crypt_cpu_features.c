@@ -0,0 +1,97 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file crypt_cpu_features.c
+  Runtime detection of the instruction set extensions of the CPU
+*/
+
+#ifdef LTC_X86_SIMD
+#include <cpuid.h>
+
+/* set in the cached value once the CPU has been queried, above all LTC_CPU_* bits */
+#define _CPU_DETECTED      0x80000000UL
+
+static ulong64 _xgetbv(void)
+{
+   ulong32 lo, hi;
+   /* xgetbv with ECX=0, spelled out for assemblers that don't know it */
+   __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a"(lo), "=d"(hi) : "c"(0));
+   return ((ulong64)hi << 32) | lo;
+}
+
+static unsigned long _cpu_features(void)
+{
+   unsigned int a, b, c, d, max;
+   unsigned long f = 0;
+   ulong64 xcr0 = 0;
+
+   max = __get_cpuid_max(0, NULL);
+   if (max < 1) {
+      return 0;
+   }
+
+   __cpuid(1, a, b, c, d);
+   if (d & (1UL << 26)) f |= LTC_CPU_SSE2;
+   if (c & (1UL <<  9)) f |= LTC_CPU_SSSE3;
+   if (c & (1UL << 19)) f |= LTC_CPU_SSE41;
+   if (c & (1UL << 25)) f |= LTC_CPU_AESNI;
+   if (c & (1UL <<  1)) f |= LTC_CPU_PCLMUL;
+
+   /* the YMM/ZMM registers are only usable if the OS saves them on a context switch */
+   if (c & (1UL << 27)) {
+      xcr0 = _xgetbv();
+   }
+   if ((c & (1UL << 28)) && (xcr0 & 0x06) == 0x06) {
+      f |= LTC_CPU_AVX;
+   }
+
+   if (max >= 7) {
+      __cpuid_count(7, 0, a, b, c, d);
+      if ((f & LTC_CPU_AVX) && (b & (1UL << 5))) f |= LTC_CPU_AVX2;
+      if (b & (1UL << 8)) f |= LTC_CPU_BMI2;
+      if (b & (1UL << 29)) f |= LTC_CPU_SHA;
+      if ((f & LTC_CPU_AVX) && (xcr0 & 0xe0) == 0xe0) {
+         if (b & (1UL << 16)) f |= LTC_CPU_AVX512F;
+         if (b & (1UL << 31)) f |= LTC_CPU_AVX512VL;
+      }
+   }
+
+   return f;
+}
+#endif
+
+/**
+  Get the instruction set extensions of the CPU the library runs on
+  @return A bitmask of LTC_CPU_* values, 0 on platforms without runtime detection
+*/
+unsigned long crypt_cpu_features(void)
+{
+#ifdef LTC_X86_SIMD
+   /* the result and the bit that says it has been computed share one word, which the workers of
+    * crypt_mt_run() read and write as a whole; threads racing on the first call store the same value
+    */
+   static volatile unsigned long features = 0;
+   unsigned long f;
+
+   f = features;
+   if ((f & _CPU_DETECTED) == 0) {
+      f = _cpu_features() | _CPU_DETECTED;
+      features = f;
+   }
+   return f & ~_CPU_DETECTED;
+#else
+   return 0;
+#endif
+}
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
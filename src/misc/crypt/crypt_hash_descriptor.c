@@ -14,7 +14,7 @@
 */
 
 struct ltc_hash_descriptor hash_descriptor[TAB_SIZE] = {
-{ NULL, 0, 0, 0, { 0 }, 0, NULL, NULL, NULL, NULL, NULL }
+{ NULL, 0, 0, 0, { 0 }, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL }
 };
 
 LTC_MUTEX_GLOBAL(ltc_hash_mutex)
@@ -0,0 +1,140 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file crypt_iov.c
+  Walk scatter/gather lists, used by the *_memory_iov() functions
+*/
+
+typedef struct {
+   const ltc_iovec *iov;
+   unsigned long    cnt, i, off;
+} _iov_cursor;
+
+/* skip the exhausted and empty segments, return the number of octets contiguous at the cursor */
+static unsigned long _iov_avail(_iov_cursor *c)
+{
+   while (c->i < c->cnt && c->off == c->iov[c->i].len) {
+      c->i++;
+      c->off = 0;
+   }
+   return (c->i < c->cnt) ? c->iov[c->i].len - c->off : 0;
+}
+
+/* copy len octets from the cursor to buf (or from buf to the cursor) and advance it */
+static void _iov_copy(_iov_cursor *c, unsigned char *buf, unsigned long len, int gather)
+{
+   unsigned long n;
+
+   while (len > 0) {
+      n = MIN(_iov_avail(c), len);
+      if (gather) {
+         XMEMCPY(buf, c->iov[c->i].data + c->off, n);
+      } else {
+         XMEMCPY(c->iov[c->i].data + c->off, buf, n);
+      }
+      c->off += n;
+      buf    += n;
+      len    -= n;
+   }
+}
+
+/**
+  Total length of a scatter/gather list
+  @param iov   The segments
+  @param cnt   The number of segments
+  @return The sum of the segment lengths (octets)
+*/
+unsigned long crypt_iov_len(const ltc_iovec *iov, unsigned long cnt)
+{
+   unsigned long x, len;
+
+   for (len = x = 0; x < cnt; x++) {
+      len += iov[x].len;
+   }
+   return len;
+}
+
+/**
+  Pass the segments of an input and an output list to a process function
+
+  The lists may be split at different places.  process gets the longest runs that are contiguous
+  in both lists, shortened to a multiple of granule; only a granule straddling a segment boundary
+  and the final partial granule go through a bounce buffer.  Every call but the last one has a
+  multiple of granule octets, the last one may be shorter.
+  @param in       The input segments
+  @param incnt    The number of input segments
+  @param out      The output segments, the same total length as the input
+  @param outcnt   The number of output segments
+  @param granule  The unit of work of process (1 up to MAXBLOCKSIZE octets)
+  @param process  The function called with the data
+  @param state    The state passed to process
+  @return CRYPT_OK if successful
+*/
+int crypt_iov_process(const ltc_iovec *in,  unsigned long incnt,
+                      const ltc_iovec *out, unsigned long outcnt,
+                      unsigned long granule, ltc_iov_cb process, void *state)
+{
+   unsigned char bin[MAXBLOCKSIZE], bout[MAXBLOCKSIZE];
+   _iov_cursor ci, co;
+   unsigned long left, n;
+   int err;
+
+   LTC_ARGCHK(in      != NULL || incnt  == 0);
+   LTC_ARGCHK(out     != NULL || outcnt == 0);
+   LTC_ARGCHK(process != NULL);
+
+   if (granule == 0 || granule > MAXBLOCKSIZE) {
+      return CRYPT_INVALID_ARG;
+   }
+   left = crypt_iov_len(in, incnt);
+   if (left != crypt_iov_len(out, outcnt)) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   ci.iov = in;
+   ci.cnt = incnt;
+   co.iov = out;
+   co.cnt = outcnt;
+   ci.i = ci.off = co.i = co.off = 0;
+
+   err = CRYPT_OK;
+   while (left > 0) {
+      n = MIN(_iov_avail(&ci), _iov_avail(&co));
+      if (n >= granule) {
+         n -= n % granule;
+         if ((err = process(state, ci.iov[ci.i].data + ci.off, co.iov[co.i].data + co.off, n)) != CRYPT_OK) {
+            break;
+         }
+         ci.off += n;
+         co.off += n;
+      } else {
+         /* the next granule straddles a segment boundary, or it's the last partial one */
+         n = MIN(granule, left);
+         _iov_copy(&ci, bin, n, 1);
+         if ((err = process(state, bin, bout, n)) != CRYPT_OK) {
+            break;
+         }
+         _iov_copy(&co, bout, n, 0);
+      }
+      left -= n;
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(bin,  sizeof(bin));
+   zeromem(bout, sizeof(bout));
+#endif
+   return err;
+}
+
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -0,0 +1,100 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file crypt_mt_run.c
+  Run the jobs of the multi-threaded modes and of hash_file_tree()
+*/
+
+#ifdef LTC_PTHREAD
+typedef struct {
+   pthread_t   thread;
+   ltc_mt_job  job;
+   void        *arg;
+   unsigned long idx;
+   int         err, started;
+} _mt_thread;
+
+static void *_mt_thread_main(void *p)
+{
+   _mt_thread *t = p;
+   t->err = t->job(t->arg, t->idx);
+   return NULL;
+}
+
+/* run job 0 on the calling thread and the others on one thread each */
+static int _mt_pthread(ltc_mt_job job, void *arg, unsigned long jobs)
+{
+   _mt_thread *t;
+   unsigned long x;
+   int err;
+
+   t = XCALLOC(jobs, sizeof(*t));
+   if (t == NULL) {
+      return CRYPT_MEM;
+   }
+   for (x = 1; x < jobs; x++) {
+      t[x].job = job;
+      t[x].arg = arg;
+      t[x].idx = x;
+      t[x].started = (pthread_create(&t[x].thread, NULL, _mt_thread_main, &t[x]) == 0);
+   }
+   err = job(arg, 0);
+   for (x = 1; x < jobs; x++) {
+      if (t[x].started) {
+         pthread_join(t[x].thread, NULL);
+      } else {
+         /* out of threads, do it here */
+         t[x].err = job(arg, x);
+      }
+      if (err == CRYPT_OK) {
+         err = t[x].err;
+      }
+   }
+   XFREE(t);
+   return err;
+}
+#endif
+
+/**
+  Run the jobs of a multi-threaded mode
+  @param exec      The executor, NULL to use one thread per job with LTC_PTHREAD (or to run them one after another without)
+  @param exec_ctx  The context passed to the executor
+  @param job       The job
+  @param arg       The argument of the job
+  @param jobs      The number of jobs
+  @return CRYPT_OK if all jobs returned CRYPT_OK
+*/
+int crypt_mt_run(ltc_mt_executor exec, void *exec_ctx, ltc_mt_job job, void *arg, unsigned long jobs)
+{
+   unsigned long x;
+   int err;
+
+   LTC_ARGCHK(job != NULL);
+
+   if (exec != NULL) {
+      return exec(exec_ctx, job, arg, jobs);
+   }
+#ifdef LTC_PTHREAD
+   if (jobs > 1) {
+      return _mt_pthread(job, arg, jobs);
+   }
+#endif
+   for (x = 0; x < jobs; x++) {
+      if ((err = job(arg, x)) != CRYPT_OK) {
+         return err;
+      }
+   }
+   return CRYPT_OK;
+}
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
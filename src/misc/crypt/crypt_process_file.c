@@ -0,0 +1,116 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file crypt_process_file.c
+  Feed a file to a process function, used by the *_file() functions
+*/
+
+#ifndef LTC_NO_FILE
+
+#ifdef LTC_FILE_MMAP
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* pass the whole file to process at once, CRYPT_NOP if it can't be mapped */
+static int _process_mmap(const char *fname, ltc_process_file_cb process, void *state)
+{
+   struct stat st;
+   void *p;
+   size_t len;
+   int fd, err;
+
+   if ((fd = open(fname, O_RDONLY)) < 0) {
+      return CRYPT_NOP;
+   }
+   /* pipes, devices and empty files can't be mapped */
+   if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 ||
+       (off_t)(unsigned long)st.st_size != st.st_size || (off_t)(size_t)st.st_size != st.st_size) {
+      close(fd);
+      return CRYPT_NOP;
+   }
+   len = (size_t)st.st_size;
+   p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (p == MAP_FAILED) {
+      return CRYPT_NOP;
+   }
+#ifdef MADV_SEQUENTIAL
+   (void)madvise(p, len, MADV_SEQUENTIAL);
+#endif
+
+   err = process(state, (const unsigned char *)p, (unsigned long)len);
+
+   munmap(p, len);
+   return err;
+}
+#endif
+
+/**
+  Pass the content of a file to a process function
+  @param fname    The name of the file
+  @param process  The function called with the data, in one or more pieces
+  @param state    The state passed to process
+  @return CRYPT_OK if successful, CRYPT_FILE_NOTFOUND if the file can't be opened
+*/
+int crypt_process_file(const char *fname, ltc_process_file_cb process, void *state)
+{
+   FILE *in;
+   unsigned char *buf;
+   size_t x;
+   int err;
+
+   LTC_ARGCHK(fname   != NULL);
+   LTC_ARGCHK(process != NULL);
+
+#ifdef LTC_FILE_MMAP
+   /* no copy and no buffer, the kernel reads ahead */
+   if ((err = _process_mmap(fname, process, state)) != CRYPT_NOP) {
+      return err;
+   }
+#endif
+
+   if ((buf = XMALLOC(LTC_FILE_READ_BUFSIZE)) == NULL) {
+      return CRYPT_MEM;
+   }
+
+   in = fopen(fname, "rb");
+   if (in == NULL) {
+      err = CRYPT_FILE_NOTFOUND;
+      goto LBL_ERR;
+   }
+
+   do {
+      x = fread(buf, 1, LTC_FILE_READ_BUFSIZE, in);
+      if ((err = process(state, buf, (unsigned long)x)) != CRYPT_OK) {
+         fclose(in); /* we don't trap this error since we're already returning an error! */
+         goto LBL_CLEANBUF;
+      }
+   } while (x == LTC_FILE_READ_BUFSIZE);
+
+   if (fclose(in) != 0) {
+      err = CRYPT_ERROR;
+   }
+
+LBL_CLEANBUF:
+   zeromem(buf, LTC_FILE_READ_BUFSIZE);
+LBL_ERR:
+   XFREE(buf);
+   return err;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -93,6 +93,9 @@ int register_all_ciphers(void)
 #endif
 #ifdef LTC_CAMELLIA
    REGISTER_CIPHER(&camellia_desc);
+#endif
+#ifdef LTC_AES_BS
+   REGISTER_CIPHER(&aes_bs_desc);
 #endif
    return err;
 }
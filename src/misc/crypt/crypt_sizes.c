@@ -75,6 +75,12 @@ static const crypt_size _crypt_sizes[] = {
 #ifdef LTC_BLAKE2B
     _SZ_STRINGIFY_S(blake2b_state),
 #endif
+#ifdef LTC_BLAKE2SP
+    _SZ_STRINGIFY_S(blake2sp_state),
+#endif
+#ifdef LTC_BLAKE2BP
+    _SZ_STRINGIFY_S(blake2bp_state),
+#endif
 #ifdef LTC_CHC_HASH
     _SZ_STRINGIFY_S(chc_state),
 #endif
@@ -131,6 +137,9 @@ static const crypt_size _crypt_sizes[] = {
 #ifdef LTC_RIJNDAEL
     _SZ_STRINGIFY_S(rijndael_key),
 #endif
+#ifdef LTC_AES_BS
+    _SZ_STRINGIFY_S(aes_bs_key),
+#endif
 #ifdef LTC_SAFER
     _SZ_STRINGIFY_S(safer_key),
 #endif
@@ -16,6 +16,9 @@
 
 #ifdef LTC_CBC_MODE
 
+/* the size of the buffer for the blocks that are decrypted in one go */
+#define CBC_BATCH 256
+
 /**
   CBC decrypt
   @param ct     Ciphertext
@@ -27,12 +30,8 @@
 int cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, symmetric_CBC *cbc)
 {
    int x, err;
-   unsigned char tmp[16];
-#ifdef LTC_FAST
-   LTC_FAST_TYPE tmpy;
-#else
-   unsigned char tmpy;
-#endif
+   unsigned long n, y, bl;
+   unsigned char tmp[CBC_BATCH], last[16];
 
    LTC_ARGCHK(pt  != NULL);
    LTC_ARGCHK(ct  != NULL);
@@ -43,7 +42,7 @@ int cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, s
    }
 
    /* is blocklen valid? */
-   if (cbc->blocklen < 1 || cbc->blocklen > (int)sizeof(cbc->IV) || cbc->blocklen > (int)sizeof(tmp)) {
+   if (cbc->blocklen < 1 || cbc->blocklen > (int)sizeof(cbc->IV) || cbc->blocklen > (int)sizeof(last)) {
       return CRYPT_INVALID_ARG;
    }
 
@@ -58,34 +57,59 @@ int cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, s
 
    if (cipher_descriptor[cbc->cipher].accel_cbc_decrypt != NULL) {
       return cipher_descriptor[cbc->cipher].accel_cbc_decrypt(ct, pt, len / cbc->blocklen, cbc->IV, &cbc->key);
-   } else {
-      while (len) {
-         /* decrypt */
-         if ((err = cipher_descriptor[cbc->cipher].ecb_decrypt(ct, tmp, &cbc->key)) != CRYPT_OK) {
-            return err;
+   }
+
+   bl = (unsigned long)cbc->blocklen;
+   while (len) {
+      /* the blocks don't depend on each other, decrypt a batch of them, through the ECB accelerator if there is one */
+      n = MIN(len, CBC_BATCH - CBC_BATCH % bl);
+      if (cipher_descriptor[cbc->cipher].accel_ecb_decrypt != NULL) {
+         if ((err = cipher_descriptor[cbc->cipher].accel_ecb_decrypt(ct, tmp, n / bl, &cbc->key)) != CRYPT_OK) {
+            goto done;
+         }
+      } else {
+         for (y = 0; y < n; y += bl) {
+            if ((err = cipher_descriptor[cbc->cipher].ecb_decrypt(ct + y, tmp + y, &cbc->key)) != CRYPT_OK) {
+               goto done;
+            }
          }
+      }
 
-         /* xor IV against plaintext */
-         #if defined(LTC_FAST)
+      /* xor the previous ciphertext blocks against plaintext, backwards so pt may be ct */
+      XMEMCPY(last, ct + n - bl, bl);
+      for (y = n - bl; y > 0; y -= bl) {
+#if defined(LTC_FAST)
          for (x = 0; x < cbc->blocklen; x += sizeof(LTC_FAST_TYPE)) {
-            tmpy = *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)cbc->IV + x)) ^ *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)tmp + x));
-            *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)cbc->IV + x)) = *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)ct + x));
-            *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)pt + x)) = tmpy;
+            *(LTC_FAST_TYPE_PTR_CAST(pt + y + x)) = *(LTC_FAST_TYPE_PTR_CAST(tmp + y + x)) ^ *(LTC_FAST_TYPE_PTR_CAST(ct + y - bl + x));
          }
-    #else
+#else
          for (x = 0; x < cbc->blocklen; x++) {
-            tmpy       = tmp[x] ^ cbc->IV[x];
-            cbc->IV[x] = ct[x];
-            pt[x]      = tmpy;
+            pt[y + x] = tmp[y + x] ^ ct[y - bl + x];
          }
-    #endif
-
-         ct  += cbc->blocklen;
-         pt  += cbc->blocklen;
-         len -= cbc->blocklen;
+#endif
+      }
+#if defined(LTC_FAST)
+      for (x = 0; x < cbc->blocklen; x += sizeof(LTC_FAST_TYPE)) {
+         *(LTC_FAST_TYPE_PTR_CAST(pt + x)) = *(LTC_FAST_TYPE_PTR_CAST(tmp + x)) ^ *(LTC_FAST_TYPE_PTR_CAST(cbc->IV + x));
+      }
+#else
+      for (x = 0; x < cbc->blocklen; x++) {
+         pt[x] = tmp[x] ^ cbc->IV[x];
       }
+#endif
+      XMEMCPY(cbc->IV, last, bl);
+
+      ct  += n;
+      pt  += n;
+      len -= n;
    }
-   return CRYPT_OK;
+   err = CRYPT_OK;
+
+done:
+#ifdef LTC_CLEAN_STACK
+   zeromem(tmp, sizeof(tmp));
+#endif
+   return err;
 }
 
 #endif
@@ -16,6 +16,154 @@
 
 #ifdef LTC_CTR_MODE
 
+/* the size of the buffer for the counter blocks that are encrypted in one go */
+#define CTR_BATCH 256
+
+/*
+  Increment the counter of ctrlen octets
+ */
+static void _ctr_increment(symmetric_CTR *ctr)
+{
+   int x;
+
+   if (ctr->mode == CTR_COUNTER_LITTLE_ENDIAN) {
+      /* little-endian */
+      for (x = 0; x < ctr->ctrlen; x++) {
+         ctr->ctr[x] = (ctr->ctr[x] + (unsigned char)1) & (unsigned char)255;
+         if (ctr->ctr[x] != (unsigned char)0) {
+            break;
+         }
+      }
+   } else {
+      /* big-endian */
+      for (x = ctr->blocklen-1; x >= ctr->ctrlen; x--) {
+         ctr->ctr[x] = (ctr->ctr[x] + (unsigned char)1) & (unsigned char)255;
+         if (ctr->ctr[x] != (unsigned char)0) {
+            break;
+         }
+      }
+   }
+}
+
+/*
+  CTR encrypt software implementation
+ */
+static int _ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long len, symmetric_CTR *ctr)
+{
+   int err;
+#ifdef LTC_FAST
+   int x;
+#endif
+
+   while (len) {
+      /* is the pad empty? */
+      if (ctr->padlen == ctr->blocklen) {
+         /* increment counter */
+         _ctr_increment(ctr);
+
+         /* encrypt it */
+         if ((err = cipher_descriptor[ctr->cipher].ecb_encrypt(ctr->ctr, ctr->pad, &ctr->key)) != CRYPT_OK) {
+            return err;
+         }
+         ctr->padlen = 0;
+      }
+#ifdef LTC_FAST
+      if (ctr->padlen == 0 && len >= (unsigned long)ctr->blocklen) {
+         for (x = 0; x < ctr->blocklen; x += sizeof(LTC_FAST_TYPE)) {
+            *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)ct + x)) = *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)pt + x)) ^
+                                                           *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)ctr->pad + x));
+         }
+       pt         += ctr->blocklen;
+       ct         += ctr->blocklen;
+       len        -= ctr->blocklen;
+       ctr->padlen = ctr->blocklen;
+       continue;
+      }
+#endif
+      *ct++ = *pt++ ^ ctr->pad[ctr->padlen++];
+      --len;
+   }
+   return CRYPT_OK;
+}
+
+/*
+  CTR encrypt whole blocks with an empty pad, the counter blocks are written to a buffer
+  and encrypted in one go, through the ECB accelerator of the cipher if it has one
+ */
+static int _ctr_encrypt_blocks(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_CTR *ctr)
+{
+   unsigned char buf[CTR_BATCH], ks[CTR_BATCH];
+   unsigned long n, x, bl;
+   int err = CRYPT_OK;
+
+   bl = (unsigned long)ctr->blocklen;
+   while (blocks > 0) {
+      n = MIN(blocks, CTR_BATCH / bl);
+      for (x = 0; x < n; x++) {
+         _ctr_increment(ctr);
+         XMEMCPY(buf + x * bl, ctr->ctr, bl);
+      }
+      if (cipher_descriptor[ctr->cipher].accel_ecb_encrypt != NULL) {
+         if ((err = cipher_descriptor[ctr->cipher].accel_ecb_encrypt(buf, ks, n, &ctr->key)) != CRYPT_OK) {
+            goto done;
+         }
+      } else {
+         for (x = 0; x < n * bl; x += bl) {
+            if ((err = cipher_descriptor[ctr->cipher].ecb_encrypt(buf + x, ks + x, &ctr->key)) != CRYPT_OK) {
+               goto done;
+            }
+         }
+      }
+#ifdef LTC_FAST
+      for (x = 0; x < n * bl; x += sizeof(LTC_FAST_TYPE)) {
+         *(LTC_FAST_TYPE_PTR_CAST(ct + x)) = *(LTC_FAST_TYPE_PTR_CAST(pt + x)) ^ *(LTC_FAST_TYPE_PTR_CAST(ks + x));
+      }
+#else
+      for (x = 0; x < n * bl; x++) {
+         ct[x] = pt[x] ^ ks[x];
+      }
+#endif
+      /* the pad is the last block of the keystream, all of it used */
+      XMEMCPY(ctr->pad, ks + (n - 1) * bl, bl);
+      pt     += n * bl;
+      ct     += n * bl;
+      blocks -= n;
+   }
+
+done:
+#ifdef LTC_CLEAN_STACK
+   zeromem(ks, sizeof(ks));
+#endif
+   return err;
+}
+
+/*
+  The accelerators increment the whole block, limit them to the number of
+  blocks that can be processed before the counter of ctrlen octets wraps
+ */
+static unsigned long _ctr_accel_blocks(const symmetric_CTR *ctr, unsigned long blocks)
+{
+   unsigned long room = 0;
+   int x;
+
+   if (ctr->mode == CTR_COUNTER_LITTLE_ENDIAN) {
+      for (x = ctr->ctrlen - 1; x >= 0; x--) {
+         if (room > (blocks >> 8)) {
+            return blocks;
+         }
+         room = (room << 8) | (255 - ctr->ctr[x]);
+      }
+   } else {
+      for (x = ctr->ctrlen; x < ctr->blocklen; x++) {
+         if (room > (blocks >> 8)) {
+            return blocks;
+         }
+         room = (room << 8) | (255 - ctr->ctr[x]);
+      }
+   }
+   return room < blocks ? room : blocks;
+}
+
 /**
   CTR encrypt
   @param pt     Plaintext
@@ -26,7 +174,8 @@
 */
 int ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long len, symmetric_CTR *ctr)
 {
-   int x, err;
+   unsigned long fr, blocks;
+   int err;
 
    LTC_ARGCHK(pt != NULL);
    LTC_ARGCHK(ct != NULL);
@@ -48,59 +197,44 @@ int ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long len, s
    }
 #endif
 
-   /* handle acceleration only if pad is empty, accelerator is present and length is >= a block size */
-   if ((ctr->padlen == ctr->blocklen) && cipher_descriptor[ctr->cipher].accel_ctr_encrypt != NULL && (len >= (unsigned long)ctr->blocklen)) {
-      if ((err = cipher_descriptor[ctr->cipher].accel_ctr_encrypt(pt, ct, len/ctr->blocklen, ctr->ctr, ctr->mode, &ctr->key)) != CRYPT_OK) {
-         return err;
+   /* handle whole blocks at once if the length is >= a block size */
+   if (len >= (unsigned long)ctr->blocklen) {
+      /* use up the pad first */
+      if (ctr->padlen < ctr->blocklen) {
+         fr = ctr->blocklen - ctr->padlen;
+         if ((err = _ctr_encrypt(pt, ct, fr, ctr)) != CRYPT_OK) {
+            return err;
+         }
+         pt  += fr;
+         ct  += fr;
+         len -= fr;
       }
-      len %= ctr->blocklen;
-   }
 
-   while (len) {
-      /* is the pad empty? */
-      if (ctr->padlen == ctr->blocklen) {
-         /* increment counter */
-         if (ctr->mode == CTR_COUNTER_LITTLE_ENDIAN) {
-            /* little-endian */
-            for (x = 0; x < ctr->ctrlen; x++) {
-               ctr->ctr[x] = (ctr->ctr[x] + (unsigned char)1) & (unsigned char)255;
-               if (ctr->ctr[x] != (unsigned char)0) {
-                  break;
-               }
-            }
-         } else {
-            /* big-endian */
-            for (x = ctr->blocklen-1; x >= ctr->ctrlen; x--) {
-               ctr->ctr[x] = (ctr->ctr[x] + (unsigned char)1) & (unsigned char)255;
-               if (ctr->ctr[x] != (unsigned char)0) {
-                  break;
-               }
+      if (cipher_descriptor[ctr->cipher].accel_ctr_encrypt != NULL) {
+         blocks = _ctr_accel_blocks(ctr, len / ctr->blocklen);
+         if (blocks > 0) {
+            if ((err = cipher_descriptor[ctr->cipher].accel_ctr_encrypt(pt, ct, blocks, ctr->ctr, ctr->mode, &ctr->key)) != CRYPT_OK) {
+               return err;
             }
+            pt  += blocks * ctr->blocklen;
+            ct  += blocks * ctr->blocklen;
+            len -= blocks * ctr->blocklen;
          }
+      }
 
-         /* encrypt it */
-         if ((err = cipher_descriptor[ctr->cipher].ecb_encrypt(ctr->ctr, ctr->pad, &ctr->key)) != CRYPT_OK) {
+      /* the rest, either without accelerator or after the counter wrapped */
+      blocks = len / ctr->blocklen;
+      if (blocks > 0) {
+         if ((err = _ctr_encrypt_blocks(pt, ct, blocks, ctr)) != CRYPT_OK) {
             return err;
          }
-         ctr->padlen = 0;
+         pt  += blocks * ctr->blocklen;
+         ct  += blocks * ctr->blocklen;
+         len -= blocks * ctr->blocklen;
       }
-#ifdef LTC_FAST
-      if (ctr->padlen == 0 && len >= (unsigned long)ctr->blocklen) {
-         for (x = 0; x < ctr->blocklen; x += sizeof(LTC_FAST_TYPE)) {
-            *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)ct + x)) = *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)pt + x)) ^
-                                                           *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)ctr->pad + x));
-         }
-       pt         += ctr->blocklen;
-       ct         += ctr->blocklen;
-       len        -= ctr->blocklen;
-       ctr->padlen = ctr->blocklen;
-       continue;
-      }
-#endif
-      *ct++ = *pt++ ^ ctr->pad[ctr->padlen++];
-      --len;
    }
-   return CRYPT_OK;
+
+   return _ctr_encrypt(pt, ct, len, ctr);
 }
 
 #endif
@@ -0,0 +1,127 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file ctr_encrypt_mt.c
+  CTR implementation, encrypt data on several threads
+*/
+
+#ifdef LTC_CTR_MODE
+
+typedef struct {
+   const unsigned char *pt;
+   unsigned char       *ct;
+   unsigned long       len;
+   symmetric_CTR       ctr;
+} _ctr_mt_chunk;
+
+static int _ctr_mt_job(void *arg, unsigned long idx)
+{
+   _ctr_mt_chunk *c = (_ctr_mt_chunk *)arg + idx;
+   return ctr_encrypt(c->pt, c->ct, c->len, &c->ctr);
+}
+
+/* add n to the counter of ctrlen octets */
+static void _ctr_add(symmetric_CTR *ctr, ulong64 n)
+{
+   int x;
+
+   if (ctr->mode == CTR_COUNTER_LITTLE_ENDIAN) {
+      for (x = 0; x < ctr->ctrlen && n != 0; x++) {
+         n += ctr->ctr[x];
+         ctr->ctr[x] = (unsigned char)(n & 255);
+         n >>= 8;
+      }
+   } else {
+      for (x = ctr->blocklen-1; x >= ctr->ctrlen && n != 0; x--) {
+         n += ctr->ctr[x];
+         ctr->ctr[x] = (unsigned char)(n & 255);
+         n >>= 8;
+      }
+   }
+}
+
+/**
+  CTR encrypt on several threads, the result and the state afterwards are the same as with ctr_encrypt()
+  @param pt        Plaintext
+  @param ct        [out] Ciphertext
+  @param len       Length of plaintext (octets)
+  @param ctr       CTR state
+  @param threads   The maximum number of chunks to process in parallel
+  @param exec      The executor that runs the chunks (NULL for the default, see crypt_mt_run())
+  @param exec_ctx  The context passed to the executor
+  @return CRYPT_OK if successful
+*/
+int ctr_encrypt_mt(const unsigned char *pt, unsigned char *ct, unsigned long len, symmetric_CTR *ctr,
+                   unsigned long threads, ltc_mt_executor exec, void *exec_ctx)
+{
+   _ctr_mt_chunk *c;
+   unsigned long fr, blocks, per, n, x;
+   int err;
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(ctr != NULL);
+
+   if ((err = cipher_is_valid(ctr->cipher)) != CRYPT_OK) {
+       return err;
+   }
+   if (ctr->blocklen < 1 || ctr->blocklen > (int)sizeof(ctr->ctr) ||
+       ctr->padlen   < 0 || ctr->padlen   > (int)sizeof(ctr->pad)) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   /* use up the pad first, so every chunk starts with a new counter */
+   if (ctr->padlen < ctr->blocklen && len > 0) {
+      fr = MIN(len, (unsigned long)(ctr->blocklen - ctr->padlen));
+      if ((err = ctr_encrypt(pt, ct, fr, ctr)) != CRYPT_OK) {
+         return err;
+      }
+      pt  += fr;
+      ct  += fr;
+      len -= fr;
+   }
+
+   blocks = len / ctr->blocklen;
+   n = MIN(threads, len / LTC_MT_MIN_CHUNK);
+   if (n <= 1) {
+      return ctr_encrypt(pt, ct, len, ctr);
+   }
+
+   c = XCALLOC(n, sizeof(*c));
+   if (c == NULL) {
+      return CRYPT_MEM;
+   }
+
+   /* each chunk starts with the counter advanced by the blocks before it, the last one gets the rest */
+   per = blocks / n;
+   for (x = 0; x < n; x++) {
+      c[x].pt  = pt + x * per * ctr->blocklen;
+      c[x].ct  = ct + x * per * ctr->blocklen;
+      c[x].len = (x == n - 1) ? len - x * per * ctr->blocklen : per * ctr->blocklen;
+      XMEMCPY(&c[x].ctr, ctr, sizeof(*ctr));
+      _ctr_add(&c[x].ctr, (ulong64)x * per);
+   }
+
+   if ((err = crypt_mt_run(exec, exec_ctx, _ctr_mt_job, c, n)) == CRYPT_OK) {
+      /* continue where the last chunk stopped */
+      XMEMCPY(ctr, &c[n - 1].ctr, sizeof(*ctr));
+   }
+
+   zeromem(c, n * sizeof(*c));
+   XFREE(c);
+   return err;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
@@ -0,0 +1,170 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+#include "tomcrypt.h"
+
+/**
+  @file xts_mt.c
+  XTS implementation, encrypt and decrypt data on several threads
+*/
+
+#ifdef LTC_XTS_MODE
+
+typedef struct {
+   const unsigned char *in;
+   unsigned char       *out;
+   unsigned long       len;
+   unsigned char       tweak[16];
+   symmetric_xts       *xts;
+   int                 enc;
+} _xts_mt_chunk;
+
+static int _xts_mt_job(void *arg, unsigned long idx)
+{
+   _xts_mt_chunk *c = (_xts_mt_chunk *)arg + idx;
+   if (c->enc) {
+      return xts_encrypt(c->in, c->len, c->out, c->tweak, c->xts);
+   }
+   return xts_decrypt(c->in, c->len, c->out, c->tweak, c->xts);
+}
+
+/* c = a * b in GF(2^128) with the bit order of xts_mult_x() */
+static void _xts_mult(const unsigned char *a, const unsigned char *b, unsigned char *c)
+{
+   unsigned char A[16], B[16], Z[16];
+   int x, y;
+
+   XMEMCPY(A, a, 16);
+   XMEMCPY(B, b, 16);
+   zeromem(Z, 16);
+   for (x = 0; x < 128; x++) {
+      if ((B[x >> 3] >> (x & 7)) & 1) {
+         for (y = 0; y < 16; y++) {
+            Z[y] ^= A[y];
+         }
+      }
+      xts_mult_x(A);
+   }
+   XMEMCPY(c, Z, 16);
+}
+
+/* T = T * x^n, by square and multiply */
+static void _xts_mult_xn(unsigned char *T, ulong64 n)
+{
+   unsigned char P[16] = { 2 };
+
+   for (; n != 0; n >>= 1) {
+      if (n & 1) {
+         _xts_mult(T, P, T);
+      }
+      _xts_mult(P, P, P);
+   }
+}
+
+static int _xts_crypt_mt(const unsigned char *in, unsigned long len, unsigned char *out, unsigned char *tweak,
+                         symmetric_xts *xts, unsigned long threads, ltc_mt_executor exec, void *exec_ctx, int enc)
+{
+   _xts_mt_chunk *c;
+   unsigned char T[16];
+   unsigned long blocks, per, n, x;
+   int err;
+
+   LTC_ARGCHK(in != NULL);
+   LTC_ARGCHK(out != NULL);
+   LTC_ARGCHK(tweak != NULL);
+   LTC_ARGCHK(xts != NULL);
+
+   if ((err = cipher_is_valid(xts->cipher)) != CRYPT_OK) {
+      return err;
+   }
+
+   /* whole blocks only, so the ciphertext stealing stays in the last chunk */
+   blocks = len >> 4;
+   n = MIN(threads, len / LTC_MT_MIN_CHUNK);
+   if (n <= 1) {
+      return enc ? xts_encrypt(in, len, out, tweak, xts) : xts_decrypt(in, len, out, tweak, xts);
+   }
+
+   c = XCALLOC(n, sizeof(*c));
+   if (c == NULL) {
+      return CRYPT_MEM;
+   }
+
+   /* chunk x starts with the encrypted tweak multiplied by x^(blocks before it),
+    * the XTS functions take it decrypted */
+   if ((err = cipher_descriptor[xts->cipher].ecb_encrypt(tweak, T, &xts->key2)) != CRYPT_OK) {
+      goto done;
+   }
+   per = blocks / n;
+   for (x = 0; x < n; x++) {
+      c[x].in  = in + x * per * 16;
+      c[x].out = out + x * per * 16;
+      c[x].len = (x == n - 1) ? len - x * per * 16 : per * 16;
+      c[x].xts = xts;
+      c[x].enc = enc;
+      if (x > 0) {
+         _xts_mult_xn(T, per);
+      }
+      if ((err = cipher_descriptor[xts->cipher].ecb_decrypt(T, c[x].tweak, &xts->key2)) != CRYPT_OK) {
+         goto done;
+      }
+   }
+
+   if ((err = crypt_mt_run(exec, exec_ctx, _xts_mt_job, c, n)) == CRYPT_OK) {
+      /* continue where the last chunk stopped */
+      XMEMCPY(tweak, c[n - 1].tweak, 16);
+   }
+
+done:
+#ifdef LTC_CLEAN_STACK
+   zeromem(T, sizeof(T));
+#endif
+   zeromem(c, n * sizeof(*c));
+   XFREE(c);
+   return err;
+}
+
+/** XTS Encryption on several threads, the result is the same as with xts_encrypt()
+ @param pt        [in]  Plaintext
+ @param ptlen     Length of plaintext (and ciphertext)
+ @param ct        [out] Ciphertext
+ @param tweak     [in] The 128--bit encryption tweak (e.g. sector number)
+ @param xts       The XTS structure
+ @param threads   The maximum number of chunks to process in parallel
+ @param exec      The executor that runs the chunks (NULL for the default, see crypt_mt_run())
+ @param exec_ctx  The context passed to the executor
+ Returns CRYPT_OK upon success
+ */
+int xts_encrypt_mt(const unsigned char *pt, unsigned long ptlen, unsigned char *ct, unsigned char *tweak,
+                   symmetric_xts *xts, unsigned long threads, ltc_mt_executor exec, void *exec_ctx)
+{
+   return _xts_crypt_mt(pt, ptlen, ct, tweak, xts, threads, exec, exec_ctx, 1);
+}
+
+/** XTS Decryption on several threads, the result is the same as with xts_decrypt()
+ @param ct        [in] Ciphertext
+ @param ptlen     Length of plaintext (and ciphertext)
+ @param pt        [out]  Plaintext
+ @param tweak     [in] The 128--bit encryption tweak (e.g. sector number)
+ @param xts       The XTS structure
+ @param threads   The maximum number of chunks to process in parallel
+ @param exec      The executor that runs the chunks (NULL for the default, see crypt_mt_run())
+ @param exec_ctx  The context passed to the executor
+ Returns CRYPT_OK upon success
+ */
+int xts_decrypt_mt(const unsigned char *ct, unsigned long ptlen, unsigned char *pt, unsigned char *tweak,
+                   symmetric_xts *xts, unsigned long threads, ltc_mt_executor exec, void *exec_ctx)
+{
+   return _xts_crypt_mt(ct, ptlen, pt, tweak, xts, threads, exec, exec_ctx, 0);
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
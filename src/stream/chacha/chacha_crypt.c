@@ -70,6 +70,15 @@ int chacha_crypt(chacha_state *st, const unsigned char *in, unsigned long inlen,
       in  += j;
    }
    for (;;) {
+#ifdef LTC_CHACHA_SIMD
+     if (inlen > 64) {
+       /* all but the last block, which may have to be kept in the state */
+       j = 64 * chacha_simd_crypt(st, in, (inlen - 1) / 64, out);
+       inlen -= j;
+       out += j;
+       in  += j;
+     }
+#endif
      _chacha_block(buf, st->input, st->rounds);
      if (st->ivlen == 8) {
        /* IV-64bit, increment 64bit counter */
@@ -0,0 +1,271 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis
+ *
+ * LibTomCrypt is a library that provides various cryptographic
+ * algorithms in a highly modular and flexible manner.
+ *
+ * The library is free for all purposes without any express
+ * guarantee it works.
+ */
+
+/**
+  @file chacha_simd.c
+  ChaCha block functions for SSE2, AVX2 and AVX-512
+
+  Each vector register holds the same word of 4, 8 or 16 consecutive blocks, so the quarter
+  rounds run on all blocks at once.  The words are transposed back into block order before
+  they are XORed with the input.
+*/
+
+#include "tomcrypt.h"
+
+#ifdef LTC_CHACHA_SIMD
+
+/* the AVX-512 reduce macros of GCC's headers trip -Wdeclaration-after-statement */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeclaration-after-statement"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+
+#define CHACHA_DOUBLEROUND(QR, x)          \
+   QR(x[0], x[4], x[ 8], x[12])            \
+   QR(x[1], x[5], x[ 9], x[13])            \
+   QR(x[2], x[6], x[10], x[14])            \
+   QR(x[3], x[7], x[11], x[15])            \
+   QR(x[0], x[5], x[10], x[15])            \
+   QR(x[1], x[6], x[11], x[12])            \
+   QR(x[2], x[7], x[ 8], x[13])            \
+   QR(x[3], x[4], x[ 9], x[14])
+
+/* ---- SSE2, 4 blocks ---- */
+
+#define SSE2_ROL(x, n) _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - (n)))
+#define SSE2_QR(a, b, c, d)                                                \
+   a = _mm_add_epi32(a, b); d = SSE2_ROL(_mm_xor_si128(d, a), 16);         \
+   c = _mm_add_epi32(c, d); b = SSE2_ROL(_mm_xor_si128(b, c), 12);         \
+   a = _mm_add_epi32(a, b); d = SSE2_ROL(_mm_xor_si128(d, a),  8);         \
+   c = _mm_add_epi32(c, d); b = SSE2_ROL(_mm_xor_si128(b, c),  7);
+
+/* transpose the words w..w+3 of four blocks, which are 16 bytes of each block */
+LTC_TARGET("sse2")
+static LTC_INLINE void _sse2_transpose(__m128i *x)
+{
+   __m128i t0, t1, t2, t3;
+
+   t0 = _mm_unpacklo_epi32(x[0], x[1]);
+   t1 = _mm_unpacklo_epi32(x[2], x[3]);
+   t2 = _mm_unpackhi_epi32(x[0], x[1]);
+   t3 = _mm_unpackhi_epi32(x[2], x[3]);
+   x[0] = _mm_unpacklo_epi64(t0, t1);
+   x[1] = _mm_unpackhi_epi64(t0, t1);
+   x[2] = _mm_unpacklo_epi64(t2, t3);
+   x[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+LTC_TARGET("sse2")
+static void _chacha_sse2(const ulong32 *input, int rounds, const unsigned char *in, unsigned char *out)
+{
+   __m128i x[16], v;
+   int i, j;
+
+   for (i = 0; i < 16; i++) {
+      x[i] = _mm_set1_epi32((int)input[i]);
+   }
+   x[12] = _mm_add_epi32(x[12], _mm_set_epi32(3, 2, 1, 0));
+   for (i = rounds; i > 0; i -= 2) {
+      CHACHA_DOUBLEROUND(SSE2_QR, x)
+   }
+   for (i = 0; i < 16; i++) {
+      v = _mm_set1_epi32((int)input[i]);
+      if (i == 12) {
+         v = _mm_add_epi32(v, _mm_set_epi32(3, 2, 1, 0));
+      }
+      x[i] = _mm_add_epi32(x[i], v);
+   }
+
+   for (i = 0; i < 16; i += 4) {
+      _sse2_transpose(x + i);
+      for (j = 0; j < 4; j++) {
+         v = _mm_loadu_si128((const __m128i*)(const void*)(in + 64 * j + 4 * i));
+         _mm_storeu_si128((__m128i*)(void*)(out + 64 * j + 4 * i), _mm_xor_si128(v, x[i + j]));
+      }
+   }
+}
+
+/* ---- AVX2, 8 blocks ---- */
+
+#define AVX2_ROL(x, n) _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - (n)))
+#define AVX2_QR(a, b, c, d)                                                            \
+   a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16); \
+   c = _mm256_add_epi32(c, d); b = AVX2_ROL(_mm256_xor_si256(b, c), 12);               \
+   a = _mm256_add_epi32(a, b); d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);  \
+   c = _mm256_add_epi32(c, d); b = AVX2_ROL(_mm256_xor_si256(b, c),  7);
+
+LTC_TARGET("avx2")
+static LTC_INLINE void _avx2_transpose(__m256i *x)
+{
+   __m256i t0, t1, t2, t3;
+
+   t0 = _mm256_unpacklo_epi32(x[0], x[1]);
+   t1 = _mm256_unpacklo_epi32(x[2], x[3]);
+   t2 = _mm256_unpackhi_epi32(x[0], x[1]);
+   t3 = _mm256_unpackhi_epi32(x[2], x[3]);
+   x[0] = _mm256_unpacklo_epi64(t0, t1);
+   x[1] = _mm256_unpackhi_epi64(t0, t1);
+   x[2] = _mm256_unpacklo_epi64(t2, t3);
+   x[3] = _mm256_unpackhi_epi64(t2, t3);
+}
+
+LTC_TARGET("avx2")
+static void _chacha_avx2(const ulong32 *input, int rounds, const unsigned char *in, unsigned char *out)
+{
+   const __m256i rot16 = _mm256_set_epi8(13, 12, 15, 14,  9,  8, 11, 10,  5,  4,  7,  6,  1,  0,  3,  2,
+                                         13, 12, 15, 14,  9,  8, 11, 10,  5,  4,  7,  6,  1,  0,  3,  2);
+   const __m256i rot8  = _mm256_set_epi8(14, 13, 12, 15, 10,  9,  8, 11,  6,  5,  4,  7,  2,  1,  0,  3,
+                                         14, 13, 12, 15, 10,  9,  8, 11,  6,  5,  4,  7,  2,  1,  0,  3);
+   __m256i x[16], v;
+   int i, j;
+
+   for (i = 0; i < 16; i++) {
+      x[i] = _mm256_set1_epi32((int)input[i]);
+   }
+   x[12] = _mm256_add_epi32(x[12], _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+   for (i = rounds; i > 0; i -= 2) {
+      CHACHA_DOUBLEROUND(AVX2_QR, x)
+   }
+   for (i = 0; i < 16; i++) {
+      v = _mm256_set1_epi32((int)input[i]);
+      if (i == 12) {
+         v = _mm256_add_epi32(v, _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+      }
+      x[i] = _mm256_add_epi32(x[i], v);
+   }
+
+   /* the low lanes now hold 16 bytes of blocks 0..3, the high lanes of blocks 4..7 */
+   for (i = 0; i < 16; i += 4) {
+      _avx2_transpose(x + i);
+   }
+   for (j = 0; j < 4; j++) {
+      for (i = 0; i < 16; i += 8) {
+         v = _mm256_permute2x128_si256(x[i + j], x[i + 4 + j], 0x20);
+         v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i*)(const void*)(in + 64 * j + 4 * i)));
+         _mm256_storeu_si256((__m256i*)(void*)(out + 64 * j + 4 * i), v);
+         v = _mm256_permute2x128_si256(x[i + j], x[i + 4 + j], 0x31);
+         v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i*)(const void*)(in + 64 * (j + 4) + 4 * i)));
+         _mm256_storeu_si256((__m256i*)(void*)(out + 64 * (j + 4) + 4 * i), v);
+      }
+   }
+}
+
+/* ---- AVX-512, 16 blocks ---- */
+
+#define AVX512_QR(a, b, c, d)                                                      \
+   a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a), 16);   \
+   c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c), 12);   \
+   a = _mm512_add_epi32(a, b); d = _mm512_rol_epi32(_mm512_xor_si512(d, a),  8);   \
+   c = _mm512_add_epi32(c, d); b = _mm512_rol_epi32(_mm512_xor_si512(b, c),  7);
+
+LTC_TARGET("avx512f")
+static LTC_INLINE void _avx512_transpose(__m512i *x)
+{
+   __m512i t0, t1, t2, t3;
+
+   t0 = _mm512_unpacklo_epi32(x[0], x[1]);
+   t1 = _mm512_unpacklo_epi32(x[2], x[3]);
+   t2 = _mm512_unpackhi_epi32(x[0], x[1]);
+   t3 = _mm512_unpackhi_epi32(x[2], x[3]);
+   x[0] = _mm512_unpacklo_epi64(t0, t1);
+   x[1] = _mm512_unpackhi_epi64(t0, t1);
+   x[2] = _mm512_unpacklo_epi64(t2, t3);
+   x[3] = _mm512_unpackhi_epi64(t2, t3);
+}
+
+LTC_TARGET("avx512f")
+static void _chacha_avx512(const ulong32 *input, int rounds, const unsigned char *in, unsigned char *out)
+{
+   const __m512i ctr = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+   __m512i x[16], v, a, b, c, d;
+   int i, j;
+
+   for (i = 0; i < 16; i++) {
+      x[i] = _mm512_set1_epi32((int)input[i]);
+   }
+   x[12] = _mm512_add_epi32(x[12], ctr);
+   for (i = rounds; i > 0; i -= 2) {
+      CHACHA_DOUBLEROUND(AVX512_QR, x)
+   }
+   for (i = 0; i < 16; i++) {
+      v = _mm512_set1_epi32((int)input[i]);
+      if (i == 12) {
+         v = _mm512_add_epi32(v, ctr);
+      }
+      x[i] = _mm512_add_epi32(x[i], v);
+   }
+
+   /* lane l of x[4*g + j] now holds 16 bytes (number g) of block 4*l + j,
+    * a 4x4 transpose of the lanes puts each block into one register */
+   for (i = 0; i < 16; i += 4) {
+      _avx512_transpose(x + i);
+   }
+   for (j = 0; j < 4; j++) {
+      a = _mm512_shuffle_i32x4(x[j], x[4 + j], 0x44);
+      b = _mm512_shuffle_i32x4(x[8 + j], x[12 + j], 0x44);
+      c = _mm512_shuffle_i32x4(x[j], x[4 + j], 0xee);
+      d = _mm512_shuffle_i32x4(x[8 + j], x[12 + j], 0xee);
+      v = _mm512_shuffle_i32x4(a, b, 0x88);
+      v = _mm512_xor_si512(v, _mm512_loadu_si512((const void*)(in + 64 * j)));
+      _mm512_storeu_si512((void*)(out + 64 * j), v);
+      v = _mm512_shuffle_i32x4(a, b, 0xdd);
+      v = _mm512_xor_si512(v, _mm512_loadu_si512((const void*)(in + 64 * (4 + j))));
+      _mm512_storeu_si512((void*)(out + 64 * (4 + j)), v);
+      v = _mm512_shuffle_i32x4(c, d, 0x88);
+      v = _mm512_xor_si512(v, _mm512_loadu_si512((const void*)(in + 64 * (8 + j))));
+      _mm512_storeu_si512((void*)(out + 64 * (8 + j)), v);
+      v = _mm512_shuffle_i32x4(c, d, 0xdd);
+      v = _mm512_xor_si512(v, _mm512_loadu_si512((const void*)(in + 64 * (12 + j))));
+      _mm512_storeu_si512((void*)(out + 64 * (12 + j)), v);
+   }
+}
+
+/**
+  Encrypt (or decrypt) whole blocks with the widest ChaCha block function the CPU supports
+  @param st      The ChaCha state, the counter is advanced by the number of blocks processed
+  @param in      The plaintext (or ciphertext)
+  @param blocks  The maximum number of 64 byte blocks to process
+  @param out     [out] The ciphertext (or plaintext)
+  @return The number of blocks processed, the rest is left to the scalar code
+*/
+unsigned long chacha_simd_crypt(chacha_state *st, const unsigned char *in, unsigned long blocks, unsigned char *out)
+{
+   unsigned long f, n = 0;
+
+   f = crypt_cpu_features();
+
+   /* the low counter word must not wrap within the lanes, the scalar code deals with the carry or overflow */
+   blocks = MIN(blocks, 0xFFFFFFFFUL - st->input[12]);
+
+   if (f & LTC_CPU_AVX512F) {
+      for (; blocks - n >= 16; n += 16) {
+         _chacha_avx512(st->input, st->rounds, in + 64 * n, out + 64 * n);
+         st->input[12] += 16;
+      }
+   }
+   if (f & LTC_CPU_AVX2) {
+      for (; blocks - n >= 8; n += 8) {
+         _chacha_avx2(st->input, st->rounds, in + 64 * n, out + 64 * n);
+         st->input[12] += 8;
+      }
+   }
+   if (f & LTC_CPU_SSE2) {
+      for (; blocks - n >= 4; n += 4) {
+         _chacha_sse2(st->input, st->rounds, in + 64 * n, out + 64 * n);
+         st->input[12] += 4;
+      }
+   }
+   return n;
+}
+
+#endif
+
+/* ref:         $Format:%D$ */
+/* git commit:  $Format:%H$ */
+/* commit time: $Format:%ai$ */
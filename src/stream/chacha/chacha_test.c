@@ -37,6 +37,8 @@ int chacha_test(void)
                           0x87, 0x4D };
    char pt[] = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
    chacha_state st;
+   unsigned char ks[67 * 64 + 17], ks2[sizeof(ks)];
+   unsigned long i;
    int err;
 
    len = strlen(pt);
@@ -59,6 +61,31 @@ int chacha_test(void)
    if ((err = chacha_ivctr64(&st, n + 4, sizeof(n) - 4, 1)) != CRYPT_OK)                   return err;
    if ((err = chacha_crypt(&st, (unsigned char*)pt, len, out)) != CRYPT_OK)                return err;
    if (compare_testvector(out, len, ct, sizeof(ct), "CHACHA-TV3", 1))                      return CRYPT_FAIL_TESTVECTOR;
+   /* a long keystream in one go (using several blocks at once) and byte by byte */
+   if ((err = chacha_setup(&st, k, sizeof(k), 20)) != CRYPT_OK)                            return err;
+   if ((err = chacha_ivctr32(&st, n, sizeof(n), 1)) != CRYPT_OK)                           return err;
+   if ((err = chacha_keystream(&st, ks, sizeof(ks))) != CRYPT_OK)                          return err;
+   if ((err = chacha_ivctr32(&st, n, sizeof(n), 1)) != CRYPT_OK)                           return err;
+   for (i = 0; i < sizeof(ks2); i++) {
+      if ((err = chacha_keystream(&st, ks2 + i, 1)) != CRYPT_OK)                           return err;
+   }
+   if (compare_testvector(ks, sizeof(ks), ks2, sizeof(ks2), "CHACHA-TV4", 1))              return CRYPT_FAIL_TESTVECTOR;
+   /* the same across the carry into the upper half of the 64-bit counter */
+   if ((err = chacha_ivctr64(&st, n + 4, sizeof(n) - 4, 0xFFFFFFF0UL)) != CRYPT_OK)         return err;
+   if ((err = chacha_keystream(&st, ks, sizeof(ks))) != CRYPT_OK)                          return err;
+   if ((err = chacha_ivctr64(&st, n + 4, sizeof(n) - 4, 0xFFFFFFF0UL)) != CRYPT_OK)         return err;
+   for (i = 0; i < sizeof(ks2); i++) {
+      if ((err = chacha_keystream(&st, ks2 + i, 1)) != CRYPT_OK)                           return err;
+   }
+   if (compare_testvector(ks, sizeof(ks), ks2, sizeof(ks2), "CHACHA-TV5", 1))              return CRYPT_FAIL_TESTVECTOR;
+   /* and up to the end of the 32-bit counter */
+   if ((err = chacha_ivctr32(&st, n, sizeof(n), 0xFFFFFFF0UL)) != CRYPT_OK)                return err;
+   if (chacha_keystream(&st, ks, sizeof(ks)) != CRYPT_OVERFLOW)                            return CRYPT_FAIL_TESTVECTOR;
+   if ((err = chacha_ivctr32(&st, n, sizeof(n), 0xFFFFFFF0UL)) != CRYPT_OK)                return err;
+   for (i = 0; i < 15 * 64; i++) {
+      if ((err = chacha_keystream(&st, ks2 + i, 1)) != CRYPT_OK)                           return err;
+   }
+   if (compare_testvector(ks, 15 * 64, ks2, 15 * 64, "CHACHA-TV6", 1))                     return CRYPT_FAIL_TESTVECTOR;
 
    return CRYPT_OK;
 #endif
@@ -10,6 +10,62 @@
 
 #include <tomcrypt_test.h>
 
+/* hash a prefix, continue from a clone and from an exported state, compare to the hash of the whole message */
+static int _hash_state_test(int hash)
+{
+   unsigned char msg[300], state[2048], ref[MAXBLOCKSIZE], out[MAXBLOCKSIZE];
+   unsigned long statelen, len, x;
+   static const unsigned long prefix[] = { 0, 1, 7, 64, 131, 299 };
+   hash_state md, md2;
+   int err;
+
+   if (hash_descriptor[hash].init(&md) != CRYPT_OK) {
+      /* chc_hash without a cipher */
+      return CRYPT_NOP;
+   }
+   for (x = 0; x < sizeof(msg); x++) {
+      msg[x] = (unsigned char)(x * 7 + 3);
+   }
+   len = sizeof(ref);
+   if ((err = hash_memory(hash, msg, sizeof(msg), ref, &len)) != CRYPT_OK) {
+      return err;
+   }
+
+   for (x = 0; x < sizeof(prefix) / sizeof(prefix[0]); x++) {
+      if ((err = hash_descriptor[hash].init(&md)) != CRYPT_OK) return err;
+      if ((err = hash_descriptor[hash].process(&md, msg, prefix[x])) != CRYPT_OK) return err;
+
+      XMEMSET(&md2, 0xa5, sizeof(md2));
+      if ((err = hash_descriptor[hash].clone(&md, &md2)) != CRYPT_OK) return err;
+      if ((err = hash_descriptor[hash].process(&md2, msg + prefix[x], sizeof(msg) - prefix[x])) != CRYPT_OK) return err;
+      if ((err = hash_descriptor[hash].done(&md2, out)) != CRYPT_OK) return err;
+      if (compare_testvector(out, len, ref, len, "hash clone", (int)x) != 0) return CRYPT_FAIL_TESTVECTOR;
+
+      statelen = 0;
+      if (hash_descriptor[hash].export_state(&md, state, &statelen) != CRYPT_BUFFER_OVERFLOW) return CRYPT_FAIL_TESTVECTOR;
+      if (statelen > sizeof(state)) return CRYPT_BUFFER_OVERFLOW;
+      if ((err = hash_descriptor[hash].export_state(&md, state, &statelen)) != CRYPT_OK) return err;
+
+      /* truncated and foreign states are rejected */
+      if (hash_descriptor[hash].import_state(&md2, state, statelen - 1) == CRYPT_OK) return CRYPT_FAIL_TESTVECTOR;
+      state[0] ^= 0xff;
+      if (hash_descriptor[hash].import_state(&md2, state, statelen) == CRYPT_OK) return CRYPT_FAIL_TESTVECTOR;
+      state[0] ^= 0xff;
+
+      XMEMSET(&md2, 0xa5, sizeof(md2));
+      if ((err = hash_descriptor[hash].import_state(&md2, state, statelen)) != CRYPT_OK) return err;
+      if ((err = hash_descriptor[hash].process(&md2, msg + prefix[x], sizeof(msg) - prefix[x])) != CRYPT_OK) return err;
+      if ((err = hash_descriptor[hash].done(&md2, out)) != CRYPT_OK) return err;
+      if (compare_testvector(out, len, ref, len, "hash import_state", (int)x) != 0) return CRYPT_FAIL_TESTVECTOR;
+
+      /* the original state is left alone */
+      if ((err = hash_descriptor[hash].process(&md, msg + prefix[x], sizeof(msg) - prefix[x])) != CRYPT_OK) return err;
+      if ((err = hash_descriptor[hash].done(&md, out)) != CRYPT_OK) return err;
+      if (compare_testvector(out, len, ref, len, "hash export_state", (int)x) != 0) return CRYPT_FAIL_TESTVECTOR;
+   }
+   return CRYPT_OK;
+}
+
 int cipher_hash_test(void)
 {
    int           x;
@@ -33,11 +89,28 @@ int cipher_hash_test(void)
    /* test hashes */
    for (x = 0; hash_descriptor[x].name != NULL; x++) {
       DOX(hash_descriptor[x].test(), hash_descriptor[x].name);
+      DOX(_hash_state_test(x), hash_descriptor[x].name);
    }
 
    /* SHAKE128 + SHAKE256 tests are a bit special */
    DOX(sha3_shake_test(), "sha3_shake");
 
+#ifdef LTC_SHA3
+   {
+      /* the SHA3 variants share the state, which can only be exported by its own variant */
+      hash_state md;
+      unsigned char state[256];
+      unsigned long statelen = sizeof(state);
+      DO(sha3_256_init(&md));
+      if (sha3_512_export_state(&md, state, &statelen) != CRYPT_INVALID_ARG) return CRYPT_FAIL_TESTVECTOR;
+      DO(sha3_256_export_state(&md, state, &statelen));
+      /* a squeezing SHAKE256 state has the capacity of SHA3-256, but not its padding */
+      DO(sha3_shake_init(&md, 256));
+      DO(sha3_shake_done(&md, state, 32));
+      if (sha3_256_export_state(&md, state, &statelen) != CRYPT_INVALID_ARG) return CRYPT_FAIL_TESTVECTOR;
+   }
+#endif
+
    return 0;
 }
 
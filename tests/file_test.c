@@ -40,6 +40,15 @@ int file_test(void)
    if ((err = hash_file(isha256, fname, buf, &len)) != CRYPT_OK)                return err;
    if (compare_testvector(buf, len, exp_sha256, 32, "hash_file", 1))            return 1;
 
+   {
+      /* 100 byte leaves, fanout 3, on up to 4 threads */
+      unsigned char exp_tree[32]     = { 0xD5, 0xCE, 0x36, 0x55, 0x0A, 0xC0, 0xE9, 0x8E, 0x9B, 0xEB, 0xFB, 0x83, 0x12, 0x21, 0xE5, 0xE9,
+                                         0x37, 0xD6, 0x6B, 0xCC, 0x72, 0x51, 0x6A, 0x3B, 0x5E, 0xB9, 0xF6, 0xD8, 0x97, 0xC9, 0x40, 0x74 };
+      len = sizeof(buf);
+      if ((err = hash_file_tree(isha256, fname, 100, 3, 4, NULL, NULL, buf, &len)) != CRYPT_OK) return err;
+      if (compare_testvector(buf, len, exp_tree, 32, "hash_file_tree", 1))     return 1;
+   }
+
 #ifdef LTC_HMAC
    {
       unsigned char exp_hmacsha256[32] = { 0xE4, 0x07, 0x74, 0x95, 0xF1, 0xF8, 0x5B, 0xB5, 0xF1, 0x4F, 0x7D, 0x4F, 0x59, 0x8E, 0x4B, 0xBC,
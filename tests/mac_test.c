@@ -9,6 +9,224 @@
 /* test pmac/omac/hmac */
 #include <tomcrypt_test.h>
 
+#if defined(LTC_PMAC) && defined(LTC_RIJNDAEL)
+/* runs the jobs in reverse order on the calling thread and counts them */
+static int _mac_mt_backwards(void *ctx, ltc_mt_job job, void *arg, unsigned long jobs)
+{
+   int err;
+   while (jobs-- > 0) {
+      if ((err = job(arg, jobs)) != CRYPT_OK) {
+         return err;
+      }
+      ++*(unsigned long *)ctx;
+   }
+   return CRYPT_OK;
+}
+
+/* compare the multi-threaded PMAC with pmac_memory(), also when the message is a multiple of the block size */
+static int _pmac_mt_test(void)
+{
+   const unsigned long len = 3 * LTC_MT_MIN_CHUNK + 4 * 16 + 9;
+   unsigned char *msg, key[16], tag[16], tag2[16];
+   unsigned long taglen, calls, l;
+   int idx, i, err;
+
+   if ((idx = find_cipher("aes")) == -1) {
+      return CRYPT_NOP;
+   }
+   if ((msg = XMALLOC(len)) == NULL) {
+      return CRYPT_MEM;
+   }
+   yarrow_read(msg, len, &yarrow_prng);
+   yarrow_read(key, sizeof(key), &yarrow_prng);
+
+   for (i = 0; i < 4; i++) {
+      l = (i & 2) ? len - 9 : len;
+      calls = 0;
+      taglen = sizeof(tag);
+      if ((err = pmac_memory(idx, key, sizeof(key), msg, l, tag, &taglen)) != CRYPT_OK) {
+         goto done;
+      }
+      taglen = sizeof(tag2);
+      err = pmac_memory_mt(idx, key, sizeof(key), msg, l, 3, (i & 1) ? NULL : _mac_mt_backwards, &calls, tag2, &taglen);
+      if (err != CRYPT_OK) {
+         goto done;
+      }
+      if (compare_testvector(tag2, taglen, tag, sizeof(tag), "PMAC mt", i) ||
+          ((i & 1) == 0 && calls != 3)) {
+         err = CRYPT_FAIL_TESTVECTOR;
+         goto done;
+      }
+   }
+   err = CRYPT_OK;
+
+done:
+   XFREE(msg);
+   return err;
+}
+#endif
+
+#if defined(LTC_GCM_MODE) || defined(LTC_CCM_MODE) || defined(LTC_OCB3_MODE) || defined(LTC_CHACHA20POLY1305_MODE)
+/* cut a buffer into segments at the given offsets, repeated offsets give empty segments */
+static unsigned long _iov_split(ltc_iovec *iov, unsigned char *buf, unsigned long len,
+                                const unsigned long *cuts, unsigned long ncuts)
+{
+   unsigned long x, n, prev;
+
+   for (prev = n = x = 0; x < ncuts && cuts[x] <= len; x++, n++) {
+      iov[n].data = buf + prev;
+      iov[n].len  = cuts[x] - prev;
+      prev = cuts[x];
+   }
+   iov[n].data = buf + prev;
+   iov[n].len  = len - prev;
+   return n + 1;
+}
+
+/* cut a buffer into segments of seg octets, the last one may be shorter */
+static unsigned long _iov_even(ltc_iovec *iov, unsigned char *buf, unsigned long len, unsigned long seg)
+{
+   unsigned long n;
+
+   for (n = 0; len > 0; n++) {
+      iov[n].data = buf;
+      iov[n].len  = MIN(len, seg);
+      buf += iov[n].len;
+      len -= iov[n].len;
+   }
+   return n;
+}
+
+/* split the input and the output of a *_memory_iov() call at different places, long messages
+ * in segments whose lengths aren't a multiple of the block size, so most of the blocks start
+ * off a segment boundary
+ */
+static void _iov_io(ltc_iovec *in, unsigned long *incnt, ltc_iovec *out, unsigned long *outcnt,
+                    unsigned char *src, unsigned char *dst, unsigned long len)
+{
+   static const unsigned long incuts[]  = { 7, 7, 37, 53, 69 };
+   static const unsigned long outcuts[] = { 16, 50, 51, 51, 90 };
+
+   if (len > 100) {
+      *incnt  = _iov_even(in,  src, len, 100);
+      *outcnt = _iov_even(out, dst, len, 52);
+      return;
+   }
+   *incnt  = _iov_split(in,  src, len, incuts,  sizeof(incuts)  / sizeof(incuts[0]));
+   *outcnt = _iov_split(out, dst, len, outcuts, sizeof(outcuts) / sizeof(outcuts[0]));
+}
+
+/* compare the *_memory_iov() functions with the contiguous ones, for a message with a partial
+ * last block, one of whole blocks and a long one
+ */
+static int _aead_iov_test(void)
+{
+   static const unsigned long aadcuts[] = { 0, 20, 21 };
+   unsigned char key[32], nonce[12], aad[37], pt[1000], ct[1000], pt2[1000], ct2[1000], tag[16], tag2[16];
+   ltc_iovec a[4], i[20], o[20];
+   unsigned long na, ni, no, len, taglen, taglen2;
+   int idx, n, stat;
+
+   yarrow_read(key, sizeof(key), &yarrow_prng);
+   yarrow_read(nonce, sizeof(nonce), &yarrow_prng);
+   yarrow_read(aad, sizeof(aad), &yarrow_prng);
+   yarrow_read(pt, sizeof(pt), &yarrow_prng);
+   idx = find_cipher("aes");
+   na = _iov_split(a, aad, sizeof(aad), aadcuts, sizeof(aadcuts) / sizeof(aadcuts[0]));
+   (void)idx;
+   (void)stat;
+
+   for (n = 0; n < 3; n++) {
+      len = (n == 0) ? 100 : (n == 1) ? 96 : sizeof(pt);
+#ifdef LTC_GCM_MODE
+      if (idx != -1) {
+         taglen = taglen2 = sizeof(tag);
+         DO(gcm_memory(idx, key, 16, nonce, 12, aad, sizeof(aad), pt, len, ct, tag, &taglen, GCM_ENCRYPT));
+         _iov_io(i, &ni, o, &no, pt, ct2, len);
+         DO(gcm_memory_iov(idx, key, 16, nonce, 12, a, na, i, ni, o, no, tag2, &taglen2, GCM_ENCRYPT));
+         if (compare_testvector(ct2, len, ct, len, "GCM iov ct", n) ||
+             compare_testvector(tag2, taglen2, tag, taglen, "GCM iov tag", n)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+         taglen2 = sizeof(tag2);
+         _iov_io(i, &ni, o, &no, ct, pt2, len);
+         DO(gcm_memory_iov(idx, key, 16, nonce, 12, a, na, i, ni, o, no, tag2, &taglen2, GCM_DECRYPT));
+         if (compare_testvector(pt2, len, pt, len, "GCM iov pt", n) ||
+             compare_testvector(tag2, taglen2, tag, taglen, "GCM iov tag", n)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+#endif
+#ifdef LTC_CCM_MODE
+      if (idx != -1) {
+         taglen = taglen2 = sizeof(tag);
+         DO(ccm_memory(idx, key, 16, NULL, nonce, 12, aad, sizeof(aad), pt, len, ct, tag, &taglen, CCM_ENCRYPT));
+         _iov_io(i, &ni, o, &no, pt, ct2, len);
+         DO(ccm_memory_iov(idx, key, 16, nonce, 12, a, na, i, ni, o, no, tag2, &taglen2, CCM_ENCRYPT));
+         if (compare_testvector(ct2, len, ct, len, "CCM iov ct", n) ||
+             compare_testvector(tag2, taglen2, tag, taglen, "CCM iov tag", n)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+         _iov_io(i, &ni, o, &no, ct, pt2, len);
+         DO(ccm_memory_iov(idx, key, 16, nonce, 12, a, na, i, ni, o, no, tag, &taglen, CCM_DECRYPT));
+         if (compare_testvector(pt2, len, pt, len, "CCM iov pt", n)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+         /* a wrong tag is rejected and the plaintext wiped */
+         tag[0] ^= 1;
+         if (ccm_memory_iov(idx, key, 16, nonce, 12, a, na, i, ni, o, no, tag, &taglen, CCM_DECRYPT) != CRYPT_ERROR) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+         XMEMSET(ct2, 0, len);
+         if (compare_testvector(pt2, len, ct2, len, "CCM iov wipe", n)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+#endif
+#ifdef LTC_OCB3_MODE
+      if (idx != -1) {
+         taglen = taglen2 = sizeof(tag);
+         DO(ocb3_encrypt_authenticate_memory(idx, key, 16, nonce, 12, aad, sizeof(aad), pt, len, ct, tag, &taglen));
+         _iov_io(i, &ni, o, &no, pt, ct2, len);
+         DO(ocb3_encrypt_authenticate_memory_iov(idx, key, 16, nonce, 12, a, na, i, ni, o, no, tag2, &taglen2));
+         if (compare_testvector(ct2, len, ct, len, "OCB3 iov ct", n) ||
+             compare_testvector(tag2, taglen2, tag, taglen, "OCB3 iov tag", n)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+         _iov_io(i, &ni, o, &no, ct, pt2, len);
+         DO(ocb3_decrypt_verify_memory_iov(idx, key, 16, nonce, 12, a, na, i, ni, o, no, tag, taglen, &stat));
+         if (stat != 1 || compare_testvector(pt2, len, pt, len, "OCB3 iov pt", n)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+         tag[0] ^= 1;
+         DO(ocb3_decrypt_verify_memory_iov(idx, key, 16, nonce, 12, a, na, i, ni, o, no, tag, taglen, &stat));
+         if (stat != 0) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+#endif
+#ifdef LTC_CHACHA20POLY1305_MODE
+      taglen = taglen2 = sizeof(tag);
+      DO(chacha20poly1305_memory(key, 32, nonce, 12, aad, sizeof(aad), pt, len, ct, tag, &taglen, CHCHA20POLY1305_ENCRYPT));
+      _iov_io(i, &ni, o, &no, pt, ct2, len);
+      DO(chacha20poly1305_memory_iov(key, 32, nonce, 12, a, na, i, ni, o, no, tag2, &taglen2, CHCHA20POLY1305_ENCRYPT));
+      if (compare_testvector(ct2, len, ct, len, "ChaCha20Poly1305 iov ct", n) ||
+          compare_testvector(tag2, taglen2, tag, taglen, "ChaCha20Poly1305 iov tag", n)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+      taglen2 = sizeof(tag2);
+      _iov_io(i, &ni, o, &no, ct, pt2, len);
+      DO(chacha20poly1305_memory_iov(key, 32, nonce, 12, a, na, i, ni, o, no, tag2, &taglen2, CHCHA20POLY1305_DECRYPT));
+      if (compare_testvector(pt2, len, pt, len, "ChaCha20Poly1305 iov pt", n) ||
+          compare_testvector(tag2, taglen2, tag, taglen, "ChaCha20Poly1305 iov tag", n)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+#endif
+   }
+   return CRYPT_OK;
+}
+#endif
+
 int mac_test(void)
 {
 #ifdef LTC_HMAC
@@ -16,6 +234,9 @@ int mac_test(void)
 #endif
 #ifdef LTC_PMAC
    DO(pmac_test());
+#ifdef LTC_RIJNDAEL
+   DO(_pmac_mt_test());
+#endif
 #endif
 #ifdef LTC_OMAC
    DO(omac_test());
@@ -50,6 +271,9 @@ int mac_test(void)
 #ifdef LTC_CHACHA20POLY1305_MODE
    DO(chacha20poly1305_test());
 #endif
+#if defined(LTC_GCM_MODE) || defined(LTC_CCM_MODE) || defined(LTC_OCB3_MODE) || defined(LTC_CHACHA20POLY1305_MODE)
+   DO(_aead_iov_test());
+#endif
 #ifdef LTC_BLAKE2SMAC
    DO(blake2smac_test());
 #endif
@@ -9,6 +9,319 @@
 /* test CFB/OFB/CBC modes */
 #include <tomcrypt_test.h>
 
+#ifdef LTC_RIJNDAEL
+/* compare the modes of an accelerated AES descriptor with the generic implementation */
+static int _modes_accel_test(const char *name)
+{
+   struct ltc_cipher_descriptor generic;
+   unsigned char key[32], key2[32], iv[16], iv2[16], pt[37*16+5], ct[sizeof(pt)], ct2[sizeof(pt)];
+   unsigned long n, len;
+   int idx, gidx, keylen, err;
+#ifdef LTC_ECB_MODE
+   symmetric_ECB ecb, ecb2;
+#endif
+#ifdef LTC_CBC_MODE
+   symmetric_CBC cbc, cbc2;
+#endif
+#ifdef LTC_CTR_MODE
+   symmetric_CTR ctr, ctr2;
+   const int ctr_modes[] = { CTR_COUNTER_LITTLE_ENDIAN, CTR_COUNTER_BIG_ENDIAN,
+                             CTR_COUNTER_LITTLE_ENDIAN | 4, CTR_COUNTER_BIG_ENDIAN | LTC_CTR_RFC3686 | 4 };
+   unsigned long first;
+   int m;
+#endif
+#ifdef LTC_XTS_MODE
+   symmetric_xts xts, xts2;
+#endif
+
+   generic = aes_desc;
+   generic.name = "aes-generic";
+   generic.ID = 255;
+   generic.accel_ecb_encrypt = NULL;
+   generic.accel_ecb_decrypt = NULL;
+   generic.accel_cbc_encrypt = NULL;
+   generic.accel_cbc_decrypt = NULL;
+   generic.accel_ctr_encrypt = NULL;
+   generic.accel_xts_encrypt = NULL;
+   generic.accel_xts_decrypt = NULL;
+
+   if ((idx = find_cipher(name)) == -1) {
+      return CRYPT_INVALID_CIPHER;
+   }
+   if ((gidx = register_cipher(&generic)) == -1) {
+      return CRYPT_ERROR;
+   }
+
+   yarrow_read(pt, sizeof(pt), &yarrow_prng);
+   yarrow_read(key, sizeof(key), &yarrow_prng);
+   yarrow_read(key2, sizeof(key2), &yarrow_prng);
+
+   err = CRYPT_OK;
+   for (keylen = 16; keylen <= 32; keylen += 8) {
+      for (n = 1; n <= sizeof(pt) / 16; n++) {
+         len = n * 16;
+         yarrow_read(iv, sizeof(iv), &yarrow_prng);
+         if (n & 1) {
+            /* start close to a carry into the upper bytes of the counter */
+            XMEMSET(iv, 0xff, sizeof(iv));
+            iv[0] = iv[15] = 0xff - (unsigned char)(n % 11);
+         }
+#ifdef LTC_ECB_MODE
+         if ((err = ecb_start(idx, key, keylen, 0, &ecb)) != CRYPT_OK) goto done;
+         if ((err = ecb_start(gidx, key, keylen, 0, &ecb2)) != CRYPT_OK) goto done;
+         if ((err = ecb_encrypt(pt, ct, len, &ecb)) != CRYPT_OK) goto done;
+         if ((err = ecb_encrypt(pt, ct2, len, &ecb2)) != CRYPT_OK) goto done;
+         if (compare_testvector(ct, len, ct2, len, "ECB accel encrypt", (int)n)) goto fail;
+         if ((err = ecb_decrypt(ct, ct, len, &ecb)) != CRYPT_OK) goto done;
+         if (compare_testvector(ct, len, pt, len, "ECB accel decrypt", (int)n)) goto fail;
+         ecb_done(&ecb);
+         ecb_done(&ecb2);
+#endif
+#ifdef LTC_CBC_MODE
+         if ((err = cbc_start(idx, iv, key, keylen, 0, &cbc)) != CRYPT_OK) goto done;
+         if ((err = cbc_start(gidx, iv, key, keylen, 0, &cbc2)) != CRYPT_OK) goto done;
+         if ((err = cbc_encrypt(pt, ct, len, &cbc)) != CRYPT_OK) goto done;
+         if ((err = cbc_encrypt(pt, ct2, len, &cbc2)) != CRYPT_OK) goto done;
+         if (compare_testvector(ct, len, ct2, len, "CBC accel encrypt", (int)n)) goto fail;
+         if (compare_testvector(cbc.IV, 16, cbc2.IV, 16, "CBC accel encrypt IV", (int)n)) goto fail;
+         if ((err = cbc_setiv(iv, 16, &cbc)) != CRYPT_OK) goto done;
+         if ((err = cbc_decrypt(ct, ct, len, &cbc)) != CRYPT_OK) goto done;
+         if (compare_testvector(ct, len, pt, len, "CBC accel decrypt", (int)n)) goto fail;
+         if (compare_testvector(cbc.IV, 16, cbc2.IV, 16, "CBC accel decrypt IV", (int)n)) goto fail;
+         if ((err = cbc_setiv(iv, 16, &cbc2)) != CRYPT_OK) goto done;
+         if ((err = cbc_decrypt(ct2, ct2, len, &cbc2)) != CRYPT_OK) goto done;
+         if (compare_testvector(ct2, len, pt, len, "CBC generic decrypt", (int)n)) goto fail;
+         if (compare_testvector(cbc.IV, 16, cbc2.IV, 16, "CBC generic decrypt IV", (int)n)) goto fail;
+         cbc_done(&cbc);
+         cbc_done(&cbc2);
+#endif
+#ifdef LTC_CTR_MODE
+         for (m = 0; m < (int)(sizeof(ctr_modes)/sizeof(ctr_modes[0])); m++) {
+            /* odd lengths and a split call exercise the pad handling around the accelerator */
+            len = n * 16 + (n % 16);
+            first = n % 23;
+            if ((err = ctr_start(idx, iv, key, keylen, 0, ctr_modes[m], &ctr)) != CRYPT_OK) goto done;
+            if ((err = ctr_start(gidx, iv, key, keylen, 0, ctr_modes[m], &ctr2)) != CRYPT_OK) goto done;
+            if ((err = ctr_encrypt(pt, ct, first, &ctr)) != CRYPT_OK) goto done;
+            if ((err = ctr_encrypt(pt + first, ct + first, len - first, &ctr)) != CRYPT_OK) goto done;
+            if ((err = ctr_encrypt(pt, ct2, len, &ctr2)) != CRYPT_OK) goto done;
+            if (compare_testvector(ct, len, ct2, len, "CTR accel", (int)n * 4 + m)) goto fail;
+            if (compare_testvector(ctr.ctr, 16, ctr2.ctr, 16, "CTR accel counter", (int)n * 4 + m)) goto fail;
+            ctr_done(&ctr);
+            ctr_done(&ctr2);
+         }
+#endif
+#ifdef LTC_XTS_MODE
+         len = n * 16 + ((n % 3) ? (n % 16) : 0);
+         if (len > sizeof(pt)) len = n * 16;
+         if ((err = xts_start(idx, key, key2, keylen, 0, &xts)) != CRYPT_OK) goto done;
+         if ((err = xts_start(gidx, key, key2, keylen, 0, &xts2)) != CRYPT_OK) goto done;
+         XMEMCPY(iv2, iv, 16);
+         if ((err = xts_encrypt(pt, len, ct, iv2, &xts)) != CRYPT_OK) goto done;
+         XMEMCPY(iv2, iv, 16);
+         if ((err = xts_encrypt(pt, len, ct2, iv2, &xts2)) != CRYPT_OK) goto done;
+         if (compare_testvector(ct, len, ct2, len, "XTS accel encrypt", (int)n)) goto fail;
+         XMEMCPY(iv2, iv, 16);
+         if ((err = xts_decrypt(ct, len, ct, iv2, &xts)) != CRYPT_OK) goto done;
+         if (compare_testvector(ct, len, pt, len, "XTS accel decrypt", (int)n)) goto fail;
+         xts_done(&xts);
+         xts_done(&xts2);
+#endif
+      }
+   }
+   goto done;
+
+fail:
+   err = CRYPT_FAIL_TESTVECTOR;
+done:
+   unregister_cipher(&generic);
+   return err;
+}
+#endif
+
+#ifdef LTC_CBC_MODE
+/* compare the batched CBC decryption, in place, with the block wise one */
+static int _modes_cbc_batch_test(void)
+{
+   const char *names[] = { "blowfish", "3des", "twofish", "camellia" };
+   unsigned char key[32], iv[16], pt[37*16], ct[sizeof(pt)], ct2[sizeof(pt)];
+   symmetric_CBC cbc, cbc2;
+   unsigned long x;
+   int i, idx, bl;
+
+   yarrow_read(pt, sizeof(pt), &yarrow_prng);
+   yarrow_read(key, sizeof(key), &yarrow_prng);
+   yarrow_read(iv, sizeof(iv), &yarrow_prng);
+
+   for (i = 0; i < (int)(sizeof(names)/sizeof(names[0])); i++) {
+      if ((idx = find_cipher(names[i])) == -1) {
+         continue;
+      }
+      bl = cipher_descriptor[idx].block_length;
+      DOX(cbc_start(idx, iv, key, cipher_descriptor[idx].min_key_length, 0, &cbc), names[i]);
+      DOX(cbc_start(idx, iv, key, cipher_descriptor[idx].min_key_length, 0, &cbc2), names[i]);
+      DOX(cbc_encrypt(pt, ct, sizeof(pt), &cbc), names[i]);
+      XMEMCPY(ct2, ct, sizeof(ct));
+      DOX(cbc_setiv(iv, bl, &cbc), names[i]);
+      DOX(cbc_decrypt(ct, ct, sizeof(ct), &cbc), names[i]);
+      for (x = 0; x < sizeof(ct2); x += bl) {
+         DOX(cbc_decrypt(ct2 + x, ct2 + x, bl, &cbc2), names[i]);
+      }
+      if (compare_testvector(ct, sizeof(pt), pt, sizeof(pt), "CBC batch", i) ||
+          compare_testvector(ct2, sizeof(pt), pt, sizeof(pt), "CBC block", i) ||
+          compare_testvector(cbc.IV, bl, cbc2.IV, bl, "CBC batch IV", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+      cbc_done(&cbc);
+      cbc_done(&cbc2);
+   }
+   return CRYPT_OK;
+}
+#endif
+
+#ifdef LTC_CTR_MODE
+/* compare the batched CTR encryption of whole blocks with the byte wise one */
+static int _modes_ctr_batch_test(void)
+{
+   const char *names[] = { "aes-noctr", "blowfish", "3des", "twofish", "camellia" };
+   const int ctr_modes[] = { CTR_COUNTER_LITTLE_ENDIAN, CTR_COUNTER_BIG_ENDIAN,
+                             CTR_COUNTER_LITTLE_ENDIAN | 4, CTR_COUNTER_BIG_ENDIAN | LTC_CTR_RFC3686 | 4 };
+   unsigned char key[32], iv[16], pt[37*16+5], ct[sizeof(pt)], ct2[sizeof(pt)];
+   symmetric_CTR ctr, ctr2;
+   unsigned long x;
+   int i, m, idx, bl, err;
+#ifdef LTC_RIJNDAEL
+   /* AES with the ECB accelerator only */
+   struct ltc_cipher_descriptor noctr;
+
+   noctr = aes_desc;
+   noctr.name = "aes-noctr";
+   noctr.ID = 255;
+   noctr.accel_ctr_encrypt = NULL;
+   if (register_cipher(&noctr) == -1) {
+      return CRYPT_ERROR;
+   }
+#endif
+
+   yarrow_read(pt, sizeof(pt), &yarrow_prng);
+   yarrow_read(key, sizeof(key), &yarrow_prng);
+
+   err = CRYPT_OK;
+   for (i = 0; i < (int)(sizeof(names)/sizeof(names[0])); i++) {
+      if ((idx = find_cipher(names[i])) == -1) {
+         continue;
+      }
+      bl = cipher_descriptor[idx].block_length;
+      for (m = 0; m < (int)(sizeof(ctr_modes)/sizeof(ctr_modes[0])); m++) {
+         /* start close to a carry, and to a wrap of the narrow counters */
+         XMEMSET(iv, 0xff, sizeof(iv));
+         iv[0] = iv[bl - 1] = 0xf3;
+         DOX(ctr_start(idx, iv, key, cipher_descriptor[idx].min_key_length, 0, ctr_modes[m], &ctr), names[i]);
+         DOX(ctr_start(idx, iv, key, cipher_descriptor[idx].min_key_length, 0, ctr_modes[m], &ctr2), names[i]);
+         DOX(ctr_encrypt(pt, ct, sizeof(pt), &ctr), names[i]);
+         for (x = 0; x < sizeof(pt); x++) {
+            DOX(ctr_encrypt(pt + x, ct2 + x, 1, &ctr2), names[i]);
+         }
+         if (compare_testvector(ct, sizeof(pt), ct2, sizeof(pt), "CTR batch", i * 4 + m) ||
+             compare_testvector(ctr.ctr, bl, ctr2.ctr, bl, "CTR batch counter", i * 4 + m)) {
+            err = CRYPT_FAIL_TESTVECTOR;
+            goto done;
+         }
+         ctr_done(&ctr);
+         ctr_done(&ctr2);
+      }
+   }
+
+done:
+#ifdef LTC_RIJNDAEL
+   unregister_cipher(&noctr);
+#endif
+   return err;
+}
+#endif
+
+#if defined(LTC_RIJNDAEL) && defined(LTC_CTR_MODE) && defined(LTC_XTS_MODE)
+/* runs the jobs backwards, they must not depend on each other */
+static int _modes_mt_backwards(void *ctx, ltc_mt_job job, void *arg, unsigned long jobs)
+{
+   int err;
+   while (jobs-- > 0) {
+      if ((err = job(arg, jobs)) != CRYPT_OK) {
+         return err;
+      }
+      ++*(unsigned long *)ctx;
+   }
+   return CRYPT_OK;
+}
+
+/* compare the multi-threaded CTR and XTS with the single-threaded functions */
+static int _modes_mt_test(void)
+{
+   const unsigned long len = 3 * LTC_MT_MIN_CHUNK + 4 * 16 + 9;
+   unsigned char *pt, *ct, *ct2, key[16], key2[16], iv[16], tweak[16], tweak2[16];
+   symmetric_CTR ctr, ctr2;
+   symmetric_xts xts;
+   unsigned long calls;
+   int idx, i, err;
+
+   if ((idx = find_cipher("aes")) == -1) {
+      return CRYPT_NOP;
+   }
+   pt  = XMALLOC(len);
+   ct  = XMALLOC(len);
+   ct2 = XMALLOC(len);
+   if (pt == NULL || ct == NULL || ct2 == NULL) {
+      err = CRYPT_MEM;
+      goto done;
+   }
+   yarrow_read(pt, len, &yarrow_prng);
+   yarrow_read(key, sizeof(key), &yarrow_prng);
+   yarrow_read(key2, sizeof(key2), &yarrow_prng);
+   XMEMSET(iv, 0xff, sizeof(iv));
+   iv[15] = 0x80;
+
+   /* with the test executor and with the default one */
+   for (i = 0; i < 2; i++) {
+      calls = 0;
+      if ((err = ctr_start(idx, iv, key, 16, 0, CTR_COUNTER_BIG_ENDIAN | 12, &ctr)) != CRYPT_OK) goto done;
+      if ((err = ctr_start(idx, iv, key, 16, 0, CTR_COUNTER_BIG_ENDIAN | 12, &ctr2)) != CRYPT_OK) goto done;
+      if ((err = ctr_encrypt(pt, ct, 7, &ctr)) != CRYPT_OK) goto done;
+      if ((err = ctr_encrypt(pt + 7, ct + 7, len - 7, &ctr)) != CRYPT_OK) goto done;
+      if ((err = ctr_encrypt(pt, ct2, 7, &ctr2)) != CRYPT_OK) goto done;
+      if ((err = ctr_encrypt_mt(pt + 7, ct2 + 7, len - 7, &ctr2, 3, i ? NULL : _modes_mt_backwards, &calls)) != CRYPT_OK) goto done;
+      if (compare_testvector(ct2, len, ct, len, "CTR mt", i)) { err = CRYPT_FAIL_TESTVECTOR; goto done; }
+      if (i == 0 && calls != 3) { err = CRYPT_FAIL_TESTVECTOR; goto done; }
+      /* the states must match too */
+      if ((err = ctr_encrypt(pt, ct, 100, &ctr)) != CRYPT_OK) goto done;
+      if ((err = ctr_encrypt(pt, ct2, 100, &ctr2)) != CRYPT_OK) goto done;
+      if (compare_testvector(ct2, 100, ct, 100, "CTR mt state", i)) { err = CRYPT_FAIL_TESTVECTOR; goto done; }
+      ctr_done(&ctr);
+      ctr_done(&ctr2);
+
+      calls = 0;
+      if ((err = xts_start(idx, key, key2, 16, 0, &xts)) != CRYPT_OK) goto done;
+      XMEMCPY(tweak, iv, 16);
+      XMEMCPY(tweak2, iv, 16);
+      if ((err = xts_encrypt(pt, len, ct, tweak, &xts)) != CRYPT_OK) goto done;
+      if ((err = xts_encrypt_mt(pt, len, ct2, tweak2, &xts, 3, i ? NULL : _modes_mt_backwards, &calls)) != CRYPT_OK) goto done;
+      if (compare_testvector(ct2, len, ct, len, "XTS mt", i)) { err = CRYPT_FAIL_TESTVECTOR; goto done; }
+      if (compare_testvector(tweak2, 16, tweak, 16, "XTS mt tweak", i)) { err = CRYPT_FAIL_TESTVECTOR; goto done; }
+      if (i == 0 && calls != 3) { err = CRYPT_FAIL_TESTVECTOR; goto done; }
+      XMEMCPY(tweak2, iv, 16);
+      if ((err = xts_decrypt_mt(ct2, len, ct2, tweak2, &xts, 3, i ? NULL : _modes_mt_backwards, &calls)) != CRYPT_OK) goto done;
+      if (compare_testvector(ct2, len, pt, len, "XTS mt decrypt", i)) { err = CRYPT_FAIL_TESTVECTOR; goto done; }
+      xts_done(&xts);
+   }
+   err = CRYPT_OK;
+
+done:
+   if (pt != NULL) XFREE(pt);
+   if (ct != NULL) XFREE(ct);
+   if (ct2 != NULL) XFREE(ct2);
+   return err;
+}
+#endif
+
 int modes_test(void)
 {
    int ret = CRYPT_NOP;
@@ -118,10 +431,29 @@ int modes_test(void)
    DO(ret = ctr_test());
 #endif
 
+#ifdef LTC_CBC_MODE
+   DO(ret = _modes_cbc_batch_test());
+#endif
+
+#ifdef LTC_CTR_MODE
+   DO(ret = _modes_ctr_batch_test());
+#endif
+
 #ifdef LTC_XTS_MODE
    DO(ret = xts_test());
 #endif
 
+#if defined(LTC_RIJNDAEL) && defined(LTC_CTR_MODE) && defined(LTC_XTS_MODE)
+   DO(ret = _modes_mt_test());
+#endif
+
+#ifdef LTC_RIJNDAEL
+   DO(ret = _modes_accel_test("aes"));
+#ifdef LTC_AES_BS
+   DO(ret = _modes_accel_test("aes-bs"));
+#endif
+#endif
+
    return 0;
 }
 
@@ -9,6 +9,80 @@
 /* test the multi helpers... */
 #include <tomcrypt_test.h>
 
+/* messages of ragged lengths, with more of them than the SIMD code has lanes and a long straggler */
+static int _sha256_multibuf_test(void)
+{
+   static const int count[] = { 0, 1, 2, 3, 5, 8, 13, 40 };
+   unsigned char data[1100], digest[40][32], ref[32];
+   const unsigned char *in[40];
+   unsigned char *out[40];
+   unsigned long inlen[40], len;
+   int n, x, y;
+
+   for (x = 0; x < (int)sizeof(data); x++) {
+      data[x] = (unsigned char)(x * 7 + 3);
+   }
+   for (y = 0; y < (int)(sizeof(count)/sizeof(count[0])); y++) {
+      n = count[y];
+      for (x = 0; x < n; x++) {
+         in[x] = data + x;
+         inlen[x] = (x == 17) ? 1000 : (unsigned long)((x * 37 + n) % 300);
+         out[x] = digest[x];
+      }
+      DO(sha256_memory_multibuf(in, inlen, out, n));
+      for (x = 0; x < n; x++) {
+         len = sizeof(ref);
+         DO(hash_memory(find_hash("sha256"), in[x], inlen[x], ref, &len));
+         if (compare_testvector(digest[x], 32, ref, 32, "SHA256 multibuf", n * 100 + x) != 0) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+   }
+   return CRYPT_OK;
+}
+
+#ifdef LTC_SHA3
+/* the same for SHA3-256 and SHAKE128, the SHAKE output spans several blocks */
+static int _sha3_multibuf_test(void)
+{
+   static const int count[] = { 0, 1, 2, 3, 4, 5, 11 };
+   unsigned char data[1700], digest[11][400], ref[400];
+   const unsigned char *in[11];
+   unsigned char *out[11];
+   unsigned long inlen[11], len;
+   int n, x, y;
+
+   for (x = 0; x < (int)sizeof(data); x++) {
+      data[x] = (unsigned char)(x * 7 + 3);
+   }
+   for (y = 0; y < (int)(sizeof(count)/sizeof(count[0])); y++) {
+      n = count[y];
+      for (x = 0; x < n; x++) {
+         in[x] = data + x;
+         inlen[x] = (x == 5) ? 1600 : (unsigned long)((x * 61 + n) % 400);
+         out[x] = digest[x];
+      }
+      DO(sha3_memory_multibuf(256, in, inlen, out, n));
+      for (x = 0; x < n; x++) {
+         len = sizeof(ref);
+         DO(hash_memory(find_hash("sha3-256"), in[x], inlen[x], ref, &len));
+         if (compare_testvector(digest[x], 32, ref, 32, "SHA3-256 multibuf", n * 100 + x) != 0) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+      DO(sha3_shake_memory_multibuf(128, in, inlen, out, 400, n));
+      for (x = 0; x < n; x++) {
+         len = 400;
+         DO(sha3_shake_memory(128, in[x], inlen[x], ref, &len));
+         if (compare_testvector(digest[x], 400, ref, 400, "SHAKE128 multibuf", n * 100 + x) != 0) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+   }
+   return CRYPT_OK;
+}
+#endif
+
 int multi_test(void)
 {
    unsigned char key[32] = { 0 };
@@ -40,6 +114,11 @@ int multi_test(void)
       printf("Failed: %d %lu %lu\n", __LINE__, len, len2);
       return CRYPT_FAIL_TESTVECTOR;
    }
+   DO(_sha256_multibuf_test());
+#ifdef LTC_SHA3
+   register_hash(&sha3_256_desc);
+   DO(_sha3_multibuf_test());
+#endif
 
 #ifdef LTC_HMAC
    len = sizeof(buf[0]);
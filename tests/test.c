@@ -178,6 +178,9 @@ static void _unregister_all(void)
 #ifdef LTC_CAMELLIA
   unregister_cipher(&camellia_desc);
 #endif
+#ifdef LTC_AES_BS
+  unregister_cipher(&aes_bs_desc);
+#endif
 
 #ifdef LTC_TIGER
   unregister_hash(&tiger_desc);